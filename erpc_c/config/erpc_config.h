@@ -46,6 +46,9 @@
 #define ERPC_MESSAGE_LOGGING_DISABLED (0U) //!< Trace functions disabled.
 #define ERPC_MESSAGE_LOGGING_ENABLED (1U)  //!< Trace functions enabled.
 
+#define ERPC_MESSAGE_LOGGING_ASYNC_DISABLED (0U) //!< Messages are logged within the call.
+#define ERPC_MESSAGE_LOGGING_ASYNC_ENABLED (1U)  //!< Messages are queued and logged by a thread.
+
 #define ERPC_TRANSPORT_MU_USE_MCMGR_DISABLED (0U) //!< Do not use MCMGR for MU ISR management.
 #define ERPC_TRANSPORT_MU_USE_MCMGR_ENABLED (1U)  //!< Use MCMGR for MU ISR management.
 
@@ -54,6 +57,27 @@
 
 #define ERPC_PRE_POST_ACTION_DEFAULT_DISABLED (0U) //!< Pre post shim default callbacks functions disabled.
 #define ERPC_PRE_POST_ACTION_DEFAULT_ENABLED (1U)  //!< Pre post shim default callback functions enabled.
+
+#define ERPC_CODEC_BASIC (0U)   //!< BasicCodec, integers at full width.
+#define ERPC_CODEC_COMPACT (1U) //!< CompactCodec, integers as varints.
+
+#define ERPC_COBS_FRAMING_DISABLED (0U) //!< FramedTransport supports length header framing only.
+#define ERPC_COBS_FRAMING_ENABLED (1U)  //!< FramedTransport can switch to COBS framing.
+
+#define ERPC_SERVER_ARENA_DISABLED (0U) //!< Server shims allocate decoded data by erpc_malloc().
+#define ERPC_SERVER_ARENA_ENABLED (1U)  //!< Server shims allocate decoded data from a per-request arena.
+
+#define ERPC_LATENCY_STATS_DISABLED (0U) //!< No latency histograms, recording is compiled out.
+#define ERPC_LATENCY_STATS_ENABLED (1U)  //!< Client and server record per-method latency histograms.
+
+#define ERPC_TRACE_DISABLED (0U) //!< No event tracing, trace points are compiled out.
+#define ERPC_TRACE_ENABLED (1U)  //!< Client, server and transport calls record trace events.
+
+#define ERPC_TRANSPORT_STATS_DISABLED (0U) //!< No transport counters, counting is compiled out.
+#define ERPC_TRANSPORT_STATS_ENABLED (1U)  //!< Transports count bytes, frames, errors and blocked time.
+
+#define ERPC_ALLOCATION_STATS_DISABLED (0U) //!< erpc_malloc() and erpc_free() count nothing.
+#define ERPC_ALLOCATION_STATS_ENABLED (1U)  //!< erpc_malloc() and erpc_free() count per thread and per method.
 //@}
 
 //! @name Configuration options
@@ -130,7 +154,171 @@
 //! Default value is set to 2.
 #define ERPC_DEFAULT_BUFFERS_COUNT (2U)
 
-//! @def ERPC_NOEXCEPT
+//! @def ERPC_PENDING_CHANNELS_COUNT
+//!
+//! Uncomment to change how many pending channels the server compares by priority before
+//! processing the next message (see Transport::pendingChannels()). Default value is set to 8.
+//#define ERPC_PENDING_CHANNELS_COUNT (8U)
+
+//! @def ERPC_WAITING_SENDERS_COUNT
+//!
+//! Uncomment to change how many channels a framed transport records as waiting to send. A
+//! priority level is held open until its last recorded channel sends or abandons its message,
+//! further channels wait without holding lower priorities back. Default value is set to 8.
+//#define ERPC_WAITING_SENDERS_COUNT (8U)
+
+//! @def ERPC_QUEUED_TRANSPORT_SLOTS_COUNT
+//!
+//! Uncomment to change the count of frames QueuedTransport can hold. Each slot takes
+//! ERPC_DEFAULT_BUFFER_SIZE bytes. Must be a power of two. Default value is set to 8.
+//#define ERPC_QUEUED_TRANSPORT_SLOTS_COUNT (8U)
+
+//! @def ERPC_BATCH_MAX_CALLS
+//!
+//! Uncomment to change how many calls one client batch (erpc_batch_begin()) can hold.
+//! All calls of a batch must also fit into one message buffer. Default value is set to 16.
+//#define ERPC_BATCH_MAX_CALLS (16U)
+
+//! @def ERPC_CODEC
+//!
+//! @brief Select the codec the client and server setup code creates.
+//!
+//! Uncomment to use CompactCodec. Generate the shims with erpcgen -c compact then, both
+//! sides of a connection have to use the same codec. Default is set to ERPC_CODEC_BASIC.
+//#define ERPC_CODEC (ERPC_CODEC_COMPACT)
+
+//! @def ERPC_CODEC_BYTE_SWAP
+//!
+//! @brief Swap multi-byte values written and read by BasicCodec.
+//!
+//! BasicCodec writes values in host byte order by default. Define it to 1 on big-endian hosts
+//! to write a little-endian payload instead, every integer and floating point value is then
+//! swapped, arrays in one pass. This changes the wire format of big-endian builds, so peers
+//! built without it do not understand them anymore. Default is set to 0.
+//#define ERPC_CODEC_BYTE_SWAP (1U)
+
+//! @def ERPC_HEADER_VERSION
+//!
+//! @brief Select the message and frame header layout written on the wire.
+//!
+//! 1 writes the legacy struct headers which every peer understands, erpc_python included.
+//! 2 writes the packed, little-endian headers, which carry the sequence number, deadline and
+//! skip-CRC flag. Servers answer codec headers in the version the client used, but the frame
+//! header of FramedTransport is not negotiated, so only select 2 when both sides are built
+//! with it. The skipCrcCheck attribute needs 2: with 1 there is no room for the flag, so such
+//! messages are still sent and checked with their CRC. Default is set to 1.
+//#define ERPC_HEADER_VERSION (2U)
+
+//! @def ERPC_COBS_FRAMING
+//!
+//! @brief Disable/enable the COBS framing mode of FramedTransport.
+//!
+//! Uncomment to make FramedTransport::setFraming() available. Costs 256 bytes of send state
+//! per framed transport. Default set to ERPC_COBS_FRAMING_DISABLED.
+//#define ERPC_COBS_FRAMING (ERPC_COBS_FRAMING_ENABLED)
+
+//! @def ERPC_SERVER_ARENA
+//!
+//! @brief Disable/enable the per-request arena of the server.
+//!
+//! Server shims then allocate decoded lists, binaries and structs from one block which is reset
+//! after the reply is sent, instead of an erpc_malloc()/erpc_free() pair per field. Handlers have
+//! to copy data they keep after the call, or mark the parameter @retain. The block is allocated by
+//! erpc_malloc() and grows to the largest request served. Default set to ERPC_SERVER_ARENA_ENABLED.
+//#define ERPC_SERVER_ARENA (ERPC_SERVER_ARENA_DISABLED)
+
+//! @def ERPC_SERVER_ARENA_SCALE
+//!
+//! Uncomment to change the arena size of the server, as multiple of the received message length.
+//! Data which does not fit is allocated by erpc_malloc(). Default value is set to 2.
+//#define ERPC_SERVER_ARENA_SCALE (2U)
+
+//! @def ERPC_LATENCY_STATS
+//!
+//! @brief Disable/enable per-method latency histograms.
+//!
+//! ClientManager records create, encode, send, wait and decode time of every call, SimpleServer
+//! records queue, handler and reply time. Read them by erpc_latency_stats_snapshot(). Each method
+//! takes about 8 KB, see ERPC_LATENCY_STATS_METHODS. Default set to ERPC_LATENCY_STATS_DISABLED.
+//#define ERPC_LATENCY_STATS (ERPC_LATENCY_STATS_ENABLED)
+
+//! @def ERPC_LATENCY_STATS_METHODS
+//!
+//! Uncomment to change how many methods get latency histograms. Default value is set to 16.
+//#define ERPC_LATENCY_STATS_METHODS (16U)
+
+//! @def ERPC_LATENCY_STATS_CLOCK
+//!
+//! Uncomment to time latencies by own clock, e.g. a hardware timer scaled to nanoseconds.
+//! It must return uint32_t. Default is std::chrono::steady_clock.
+//#define ERPC_LATENCY_STATS_CLOCK() (board_time_ns())
+
+//! @def ERPC_TRACE
+//!
+//! @brief Disable/enable lifecycle event tracing.
+//!
+//! Request and server state changes and transport sends and receives are recorded with timestamp,
+//! channel and sequence into a ring buffer per thread. erpc_trace_dump() writes them as Chrome
+//! trace JSON. Needs thread_local support. Default set to ERPC_TRACE_DISABLED.
+//#define ERPC_TRACE (ERPC_TRACE_ENABLED)
+
+//! @def ERPC_TRACE_EVENTS
+//!
+//! Uncomment to change how many events each thread keeps, older ones are overwritten.
+//! Must be a power of two, an event takes 24 bytes. Default value is set to 4096.
+//#define ERPC_TRACE_EVENTS (4096U)
+
+//! @def ERPC_TRACE_THREADS
+//!
+//! Uncomment to change how many threads are traced, events of further threads are dropped.
+//! Default value is set to 8.
+//#define ERPC_TRACE_THREADS (8U)
+
+//! @def ERPC_TRACE_CLOCK
+//!
+//! Uncomment to timestamp trace events by own clock, it must return uint64_t nanoseconds.
+//! Default is std::chrono::steady_clock.
+//#define ERPC_TRACE_CLOCK() (board_time_ns())
+
+//! @def ERPC_TRANSPORT_STATS
+//!
+//! @brief Disable/enable transport statistics.
+//!
+//! Framed transports (TCP, serial, ...) and FastTransport count sent and received bytes and
+//! frames, errors, CRC failures, kErpcStatus_Pending returns and the time sends were blocked,
+//! in total and per channel. Read them by erpc_transport_get_stats(). Default set to
+//! ERPC_TRANSPORT_STATS_DISABLED.
+//#define ERPC_TRANSPORT_STATS (ERPC_TRANSPORT_STATS_ENABLED)
+
+//! @def ERPC_TRANSPORT_STATS_CHANNELS
+//!
+//! Uncomment to change how many channels each transport counts separately, further channels
+//! are only counted in the totals. Default value is set to 8.
+//#define ERPC_TRANSPORT_STATS_CHANNELS (8U)
+
+//! @def ERPC_TRANSPORT_STATS_CLOCK
+//!
+//! Uncomment to time blocked sends by own clock, it must return uint32_t microseconds.
+//! Default is std::chrono::steady_clock.
+//#define ERPC_TRANSPORT_STATS_CLOCK() (board_time_us())
+
+//! @def ERPC_ALLOCATION_STATS
+//!
+//! @brief Disable/enable allocation accounting.
+//!
+//! erpc_malloc() and erpc_free() of the ports count allocations, bytes and live blocks of each
+//! thread and of each method a client or server is busy with. Each block gets a header of
+//! alignof(max_align_t) bytes or more. Read the counters by erpc_allocation_stats_thread() and
+//! erpc_allocation_stats_method(), tests check a region by ERPC_ASSERT_NO_ALLOCATIONS(). Needs
+//! thread_local support. Default set to ERPC_ALLOCATION_STATS_DISABLED.
+//#define ERPC_ALLOCATION_STATS (ERPC_ALLOCATION_STATS_ENABLED)
+
+//! @def ERPC_ALLOCATION_STATS_METHODS
+//!
+//! Uncomment to change how many methods get own allocation counters, allocations of further
+//! methods are only counted per thread. Default value is set to 16.
+//#define ERPC_ALLOCATION_STATS_METHODS (16U)
+
 //!
 //! @brief Disable/enable noexcept support.
 //!
@@ -161,6 +349,32 @@
 //! Uncomment for using logging feature.
 //#define ERPC_MESSAGE_LOGGING (ERPC_MESSAGE_LOGGING_ENABLED)
 
+//! @def ERPC_MESSAGE_LOGGING_ASYNC
+//!
+//! @brief Disable/enable logging messages from a separate thread.
+//!
+//! Messages are copied into a lock-free queue and written to the logger transports by a thread,
+//! so a slow logger doesn't stall the calls. Messages which don't fit are dropped, see
+//! MessageLoggers::getDroppedLogMessages(). Needs a threading model. Default set to
+//! ERPC_MESSAGE_LOGGING_ASYNC_DISABLED.
+//#define ERPC_MESSAGE_LOGGING_ASYNC (ERPC_MESSAGE_LOGGING_ASYNC_ENABLED)
+
+//! @def ERPC_MESSAGE_LOGGING_SLOTS
+//!
+//! Uncomment to change how many messages wait for the logging thread. Each slot takes
+//! ERPC_DEFAULT_BUFFER_SIZE bytes. Must be a power of two. Default value is set to 16.
+//#define ERPC_MESSAGE_LOGGING_SLOTS (16U)
+
+//! @def ERPC_MESSAGE_LOGGING_THREAD_PRIORITY
+//!
+//! Uncomment to change priority of the logging thread. Default value is set to 0.
+//#define ERPC_MESSAGE_LOGGING_THREAD_PRIORITY (0U)
+
+//! @def ERPC_MESSAGE_LOGGING_THREAD_STACK_SIZE
+//!
+//! Uncomment to change stack size of the logging thread. Default value is set to 1024.
+//#define ERPC_MESSAGE_LOGGING_THREAD_STACK_SIZE (1024U)
+
 //! @def ERPC_TRANSPORT_MU_USE_MCMGR
 //!
 //! @brief MU transport layer configuration.
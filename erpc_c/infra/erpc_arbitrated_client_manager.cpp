@@ -68,7 +68,7 @@ void ArbitratedClientManager::performClientRequest(RequestContext &request)
 #if ERPC_MESSAGE_LOGGING
     if (request.getCodec()->isStatusOk() == true)
     {
-        err = logMessage(request.getCodec()->getBuffer());
+        err = logMessage(request.getChannel(), request.getCodec()->getBuffer());
         request.getCodec()->updateStatus(err);
     }
 #endif
@@ -92,7 +92,7 @@ void ArbitratedClientManager::performClientRequest(RequestContext &request)
 #if ERPC_MESSAGE_LOGGING
         if (request.getCodec()->isStatusOk() == true)
         {
-            err = logMessage(request.getCodec()->getBuffer());
+            err = logMessage(request.getChannel(), request.getCodec()->getBuffer());
             request.getCodec()->updateStatus(err);
         }
 #endif
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_arena.h"
+
+#include "erpc_port.h"
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+Arena::~Arena(void)
+{
+    if (m_owned)
+    {
+        erpc_free(m_block);
+    }
+}
+
+void Arena::setBuffer(void *buffer, uint32_t size)
+{
+    if (m_owned)
+    {
+        erpc_free(m_block);
+    }
+
+    m_block = static_cast<uint8_t *>(buffer);
+    m_size = (buffer != NULL) ? size : 0U;
+    m_used = 0;
+    m_owned = (buffer == NULL);
+}
+
+bool Arena::reserve(uint32_t size)
+{
+    m_used = 0;
+
+    if (m_owned && (size > m_size))
+    {
+        erpc_free(m_block);
+        m_block = static_cast<uint8_t *>(erpc_malloc(size));
+        m_size = (m_block != NULL) ? size : 0U;
+    }
+
+    return (m_size >= size);
+}
+
+void *Arena::allocate(uint32_t size)
+{
+    void *ptr = NULL;
+    uint32_t offset = (m_used + kArenaAlignment - 1U) & ~(kArenaAlignment - 1U);
+
+    if ((offset >= m_used) && (offset <= m_size) && (size <= (m_size - offset)))
+    {
+        ptr = &m_block[offset];
+        m_used = offset + size;
+    }
+
+    return ptr;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__ARENA_H_
+#define _EMBEDDED_RPC__ARENA_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_utility
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Bump allocator for the data decoded from one request.
+ *
+ * Allocations are carved from one block and are never freed one by one, the whole arena is
+ * reset when the request is done. The block is allocated by erpc_malloc() and only
+ * reallocated when a request needs a larger one, so serving requests does not fragment the heap.
+ *
+ * The block may also be provided by the caller, see setBuffer(). Such arena never grows.
+ *
+ * @ingroup infra_utility
+ */
+class Arena
+{
+public:
+    /*!
+     * @brief Constructor.
+     */
+    Arena(void)
+    : m_block(NULL)
+    , m_size(0)
+    , m_used(0)
+    , m_owned(true)
+    {
+    }
+
+    /*!
+     * @brief Arena destructor, frees the block when it is owned.
+     */
+    ~Arena(void);
+
+    /*!
+     * @brief Use caller-provided memory as the block.
+     *
+     * The memory is not freed by the arena and must outlive it. Passing NULL makes the arena
+     * allocate its own block again.
+     *
+     * @param[in] buffer Memory the allocations are carved from.
+     * @param[in] size Size of the memory in bytes.
+     */
+    void setBuffer(void *buffer, uint32_t size);
+
+    /*!
+     * @brief Reset the arena and make sure its block has at least given size.
+     *
+     * @param[in] size Requested block size in bytes.
+     *
+     * @retval true The block has requested size.
+     * @retval false The block couldn't be allocated or the caller-provided one is too small.
+     */
+    bool reserve(uint32_t size);
+
+    /*!
+     * @brief Allocate memory from the arena.
+     *
+     * Returned memory is aligned to #kArenaAlignment bytes.
+     *
+     * @param[in] size Size of the memory in bytes.
+     *
+     * @return Pointer to the memory, NULL when the arena is exhausted.
+     */
+    void *allocate(uint32_t size);
+
+    /*!
+     * @brief Release all allocations at once.
+     */
+    void reset(void) { m_used = 0; }
+
+    /*!
+     * @brief Return true when the pointer was allocated from the arena.
+     *
+     * @param[in] ptr Pointer to check.
+     *
+     * @return True when @a ptr points into the arena block.
+     */
+    bool contains(const void *ptr) const
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(ptr);
+        return ((m_block != NULL) && (p >= m_block) && (p < &m_block[m_size]));
+    }
+
+    /*!
+     * @brief Return size of the block.
+     *
+     * @return Size in bytes.
+     */
+    uint32_t getSize(void) const { return m_size; }
+
+    /*!
+     * @brief Return size of the memory allocated since the last reset.
+     *
+     * @return Size in bytes, including alignment.
+     */
+    uint32_t getUsed(void) const { return m_used; }
+
+    /*!
+     * @brief Return true when the block was provided by the caller.
+     *
+     * @return True when the arena doesn't own the block and never grows.
+     */
+    bool isFixed(void) const { return !m_owned; }
+
+    //! @brief Alignment of the memory returned by allocate().
+    static const uint32_t kArenaAlignment = 8U;
+
+private:
+    uint8_t *m_block; /*!< Memory the allocations are carved from. */
+    uint32_t m_size;  /*!< Size of the block. */
+    uint32_t m_used;  /*!< Bytes allocated since the last reset. */
+    bool m_owned;     /*!< Block was allocated by the arena. */
+
+    // Not copyable, the block is owned.
+    Arena(const Arena &other);
+    Arena &operator=(const Arena &other);
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__ARENA_H_
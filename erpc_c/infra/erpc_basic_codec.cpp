@@ -20,21 +20,95 @@
 #endif
 #include <cassert>
 #include <bitset>
+#include <cstring>
 
 using namespace erpc;
 
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//! Longest LEB128 encoding of a 64-bit value.
+static const uint8_t kMaxVarintLength = 10;
+
+//! Request ids below this take at most 3 bytes as varint, shorter than the fixed u32.
+static const Hash kVarintIdLimit = (1UL << 21);
+
+#if ERPC_CODEC_BYTE_SWAP
+//! Elements swapped at once when writing an array.
+static const uint32_t kSwapChunkLength = 32;
+
+static inline uint16_t byteSwap(uint16_t value)
+{
+    return static_cast<uint16_t>((value << 8) | (value >> 8));
+}
+
+static inline uint32_t byteSwap(uint32_t value)
+{
+    return ((value & 0x000000FFUL) << 24) | ((value & 0x0000FF00UL) << 8) | ((value & 0x00FF0000UL) >> 8) |
+           ((value & 0xFF000000UL) >> 24);
+}
+
+static inline uint64_t byteSwap(uint64_t value)
+{
+    return (static_cast<uint64_t>(byteSwap(static_cast<uint32_t>(value))) << 32) |
+           byteSwap(static_cast<uint32_t>(value >> 32));
+}
+
+//! Swap the bytes of each element, a simple loop the compiler vectorises.
+template <typename U>
+static void swapElements(void *data, uint32_t count)
+{
+    uint8_t *bytes = static_cast<uint8_t *>(data);
+    U element;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        memcpy(&element, &bytes[i * sizeof(U)], sizeof(U));
+        element = byteSwap(element);
+        memcpy(&bytes[i * sizeof(U)], &element, sizeof(U));
+    }
+}
+#endif
+
+//! Convert values between host and wire byte order in place, with ERPC_CODEC_BYTE_SWAP the wire is little-endian.
+template <typename T>
+static inline void swapToWire(T *values, uint32_t count)
+{
+#if ERPC_CODEC_BYTE_SWAP
+    switch (sizeof(T))
+    {
+        case 2:
+            swapElements<uint16_t>(values, count);
+            break;
+        case 4:
+            swapElements<uint32_t>(values, count);
+            break;
+        case 8:
+            swapElements<uint64_t>(values, count);
+            break;
+        default:
+            break;
+    }
+#else
+    (void)values;
+    (void)count;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Code
 ////////////////////////////////////////////////////////////////////////////////
 
-const uint8_t BasicCodec::kBasicCodecVersion = 1;
+const uint8_t BasicCodec::kBasicCodecVersion = 2;
+const uint8_t BasicCodec::kBasicCodecLegacyVersion = 1;
 
-void BasicCodec::startWriteMessage(message_type_t type, uint32_t service, const Hash request, uint32_t /*sequence*/)
+void BasicCodec::startWriteMessage(message_type_t type, uint32_t service, const Hash request, uint32_t sequence)
 {
     /// do this only if we dont have a fast mssage coded
-    if(!getFast())
+    if(!getFast() && (m_headerVersion == kBasicCodecLegacyVersion))
     {
-        PayloadHeader header(kBasicCodecVersion, 
+        PayloadHeader header(kBasicCodecLegacyVersion, 
             static_cast<uint8_t>((service & 0xff)),
             request,
             type 
@@ -43,6 +117,10 @@ void BasicCodec::startWriteMessage(message_type_t type, uint32_t service, const
         writeData(&header, sizeof(PayloadHeader));
         // write(sequence);
     }
+    else if(!getFast())
+    {
+        writeHeader(kBasicCodecVersion, type, service, request, sequence);
+    }
     else{
         /// if this is a fast message codec, we dont expect an 
         /// extra header inside the payload
@@ -60,6 +138,72 @@ void BasicCodec::startWriteMessage(message_type_t type, uint32_t service, const
     }
 }
 
+void BasicCodec::writeHeader(uint8_t version, message_type_t type, uint32_t service, const Hash request, uint32_t sequence)
+{
+    uint8_t header[3];
+    uint8_t flags = 0;
+
+    if (request < kVarintIdLimit)
+    {
+        flags |= kHeaderFlagVarintId;
+    }
+    if (m_headerSequence)
+    {
+        flags |= kHeaderFlagSequence;
+    }
+    if (m_hasDeadline)
+    {
+        flags |= kHeaderFlagDeadline;
+    }
+    if (getSkipCrc())
+    {
+        flags |= kHeaderFlagSkipCrc;
+    }
+
+    header[0] = version;
+    header[1] = static_cast<uint8_t>((static_cast<uint8_t>(type) & kHeaderTypeMask) | flags);
+    header[2] = static_cast<uint8_t>(service & 0xffU);
+    writeData(header, sizeof(header));
+
+    if ((flags & kHeaderFlagVarintId) != 0U)
+    {
+        writeVarint(request);
+    }
+    else
+    {
+        uint8_t id[sizeof(Hash)] = { static_cast<uint8_t>(request), static_cast<uint8_t>(request >> 8),
+                                     static_cast<uint8_t>(request >> 16), static_cast<uint8_t>(request >> 24) };
+        writeData(id, sizeof(id));
+    }
+
+    if (m_headerSequence)
+    {
+        writeVarint(sequence);
+    }
+
+    if (m_hasDeadline)
+    {
+        writeVarint(m_deadline);
+        // Deadline belongs to a single request.
+        m_hasDeadline = false;
+    }
+}
+
+void BasicCodec::writeVarint(uint64_t value)
+{
+    uint8_t data[kMaxVarintLength];
+    uint32_t length = 0;
+
+    while (value >= 0x80U)
+    {
+        data[length++] = static_cast<uint8_t>(value | 0x80U);
+        value >>= 7;
+    }
+    data[length++] = static_cast<uint8_t>(value);
+
+    writeData(data, length);
+}
+
 void BasicCodec::writeData(const void *value, uint32_t length)
 {
     if (!m_status)
@@ -90,16 +234,19 @@ void BasicCodec::write(int8_t value)
 
 void BasicCodec::write(int16_t value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
 void BasicCodec::write(int32_t value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
 void BasicCodec::write(int64_t value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
@@ -110,29 +257,118 @@ void BasicCodec::write(uint8_t value)
 
 void BasicCodec::write(uint16_t value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
 void BasicCodec::write(uint32_t value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
 void BasicCodec::write(uint64_t value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
 void BasicCodec::write(float value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
 void BasicCodec::write(double value)
 {
+    swapToWire(&value, 1U);
     writeData(&value, sizeof(value));
 }
 
+template <typename T>
+void BasicCodec::writeScalars(const T *values, uint32_t count)
+{
+    if ((count > (m_cursor.getRemaining() / sizeof(T))) && !m_status)
+    {
+        m_status = kErpcStatus_BufferOverrun;
+    }
+    else if (count == 0U)
+    {
+        // Empty list, its data pointer may be NULL.
+    }
+#if ERPC_CODEC_BYTE_SWAP
+    else if (sizeof(T) > 1U)
+    {
+        T chunk[kSwapChunkLength];
+
+        while ((count > 0U) && !m_status)
+        {
+            uint32_t length = (count < kSwapChunkLength) ? count : kSwapChunkLength;
+
+            memcpy(chunk, values, length * sizeof(T));
+            swapToWire(chunk, length);
+            writeData(chunk, length * sizeof(T));
+            values += length;
+            count -= length;
+        }
+    }
+#endif
+    else
+    {
+        writeData(values, count * sizeof(T));
+    }
+}
+
+void BasicCodec::writeArray(const int8_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const int16_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const int32_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const int64_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const uint8_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const uint16_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const uint32_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const uint64_t *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const float *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
+void BasicCodec::writeArray(const double *values, uint32_t count)
+{
+    writeScalars(values, count);
+}
+
 void BasicCodec::writePtr(uintptr_t value)
 {
     uint8_t ptrSize = sizeof(value);
@@ -204,26 +440,45 @@ void BasicCodec::writeCallback(funPtr callback1, funPtr callback2)
     }
 }
 
-void BasicCodec::startReadMessage(message_type_t *type, uint32_t *service, Hash* request, uint32_t* /*sequence*/)
+void BasicCodec::startReadMessage(message_type_t *type, uint32_t *service, Hash* request, uint32_t* sequence)
 {
     /// only do this when we do not expect a fast message
     if(!getFast()){
-        PayloadHeader header;
-        readData(&header, sizeof(PayloadHeader));
+        uint8_t version = 0;
+        readData(&version, sizeof(version));
 
-        if (header.codecVersion != kBasicCodecVersion)
+        if (!m_status && (version == kBasicCodecVersion))
+        {
+            readHeader(type, service, request, sequence);
+        }
+        else if (!m_status && (version == kBasicCodecLegacyVersion))
+        {
+            PayloadHeader header;
+            // Version byte was consumed already, read the rest of the struct behind it.
+            readData(reinterpret_cast<uint8_t *>(&header) + sizeof(version), sizeof(PayloadHeader) - sizeof(version));
+
+            if (!m_status)
+            {
+                *service = header.service;
+                // std::memcpy(request, header.id, sizeof(Hash));
+                *request = header.id;
+                *type = static_cast<message_type_t>(header.type);
+                m_hasDeadline = false;
+                if (sequence != NULL)
+                {
+                    *sequence = 0;
+                }
+            }
+        }
+        else
         {
             updateStatus(kErpcStatus_InvalidMessageVersion);
         }
 
         if (!m_status)
         {
-            *service = header.service;
-            // std::memcpy(request, header.id, sizeof(Hash));
-            *request = header.id;
-            *type = static_cast<message_type_t>(header.type);
-
-            // read(sequence);
+            // Answer in the version the peer understands.
+            m_headerVersion = version;
         }
     }
     else{
@@ -248,6 +503,93 @@ void BasicCodec::startReadMessage(message_type_t *type, uint32_t *service, Hash*
     }
 }
 
+void BasicCodec::readHeader(message_type_t *type, uint32_t *service, Hash *request, uint32_t *sequence)
+{
+    uint8_t header[2];
+    uint64_t value = 0;
+
+    readData(header, sizeof(header));
+    if (m_status)
+    {
+        return;
+    }
+
+    uint8_t flags = header[0] & static_cast<uint8_t>(~kHeaderTypeMask);
+    *type = static_cast<message_type_t>(header[0] & kHeaderTypeMask);
+    *service = header[1];
+
+    if ((flags & kHeaderFlagVarintId) != 0U)
+    {
+        readVarint(&value, UINT32_MAX);
+        *request = static_cast<Hash>(value);
+    }
+    else
+    {
+        uint8_t id[sizeof(Hash)] = { 0 };
+        readData(id, sizeof(id));
+        *request = static_cast<Hash>(id[0]) | (static_cast<Hash>(id[1]) << 8) | (static_cast<Hash>(id[2]) << 16) |
+                   (static_cast<Hash>(id[3]) << 24);
+    }
+
+    value = 0;
+    if ((flags & kHeaderFlagSequence) != 0U)
+    {
+        readVarint(&value, UINT32_MAX);
+    }
+    if (sequence != NULL)
+    {
+        *sequence = static_cast<uint32_t>(value);
+    }
+
+    m_hasDeadline = ((flags & kHeaderFlagDeadline) != 0U);
+    if (m_hasDeadline)
+    {
+        value = 0;
+        readVarint(&value, UINT32_MAX);
+        m_deadline = static_cast<uint32_t>(value);
+    }
+
+    setSkipCrc((flags & kHeaderFlagSkipCrc) != 0U);
+}
+
+void BasicCodec::readVarint(uint64_t *value, uint64_t maxValue)
+{
+    uint64_t result = 0;
+    uint8_t byte = 0x80U;
+    uint8_t shift = 0;
+
+    while (!m_status && ((byte & 0x80U) != 0U))
+    {
+        if (shift >= (kMaxVarintLength * 7U))
+        {
+            updateStatus(kErpcStatus_InvalidArgument);
+            break;
+        }
+
+        readData(&byte, sizeof(byte));
+        if ((shift == ((kMaxVarintLength - 1U) * 7U)) && ((byte & 0x7fU) > 1U))
+        {
+            // Last byte of a 64-bit value holds its top bit only.
+            updateStatus(kErpcStatus_InvalidArgument);
+            break;
+        }
+        result |= static_cast<uint64_t>(byte & 0x7fU) << shift;
+        shift += 7U;
+    }
+
+    if (!m_status)
+    {
+        if (result > maxValue)
+        {
+            updateStatus(kErpcStatus_InvalidArgument);
+        }
+        else
+        {
+            *value = result;
+        }
+    }
+}
+
 void BasicCodec::readData(void *value, uint32_t length)
 {
     if (!m_status)
@@ -281,17 +623,17 @@ void BasicCodec::read(int8_t *value)
 
 void BasicCodec::read(int16_t *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(int32_t *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(int64_t *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(uint8_t *value)
@@ -301,27 +643,94 @@ void BasicCodec::read(uint8_t *value)
 
 void BasicCodec::read(uint16_t *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(uint32_t *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(uint64_t *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(float *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
 }
 
 void BasicCodec::read(double *value)
 {
-    readData(value, sizeof(*value));
+    readScalars(value, 1U);
+}
+
+template <typename T>
+void BasicCodec::readScalars(T *values, uint32_t count)
+{
+    if ((count > (m_cursor.getRemaining() / sizeof(T))) && !m_status)
+    {
+        m_status = kErpcStatus_BufferOverrun;
+    }
+    else if (count > 0U)
+    {
+        readData(values, count * sizeof(T));
+        if (!m_status)
+        {
+            swapToWire(values, count);
+        }
+    }
+}
+
+void BasicCodec::readArray(int8_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(int16_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(int32_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(int64_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(uint8_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(uint16_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(uint32_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(uint64_t *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(float *values, uint32_t count)
+{
+    readScalars(values, count);
+}
+
+void BasicCodec::readArray(double *values, uint32_t count)
+{
+    readScalars(values, count);
 }
 
 void BasicCodec::readPtr(uintptr_t *value)
@@ -12,6 +12,7 @@
 #define _EMBEDDED_RPC__BASIC_SERIALIZATION_H_
 
 #include "erpc_codec.h"
+#include "erpc_config_internal.h"
 
 /*!
  * @addtogroup infra_codec
@@ -33,21 +34,101 @@ enum _null_flag
     kIsNull
 };
 
+/*!
+ * @brief Flags in the upper nibble of the type byte of the packed message header.
+ */
+enum _header_flags
+{
+    kHeaderFlagVarintId = 0x10U,  /*!< Request id is a varint instead of a little-endian u32. */
+    kHeaderFlagSequence = 0x20U,  /*!< Varint sequence number follows the request id. */
+    kHeaderFlagDeadline = 0x40U,  /*!< Varint deadline in milliseconds follows. */
+    kHeaderFlagSkipCrc = 0x80U,   /*!< Message was sent without CRC. */
+};
+
+static const uint8_t kHeaderTypeMask = 0x0FU; /*!< Message type bits of the type byte. */
+
 /*!
  * @brief Simple binary serialization format.
  *
+ * Messages start with the packed header (#kBasicCodecVersion), all fields byte-wise:
+ *  - version,
+ *  - message type in the low nibble, #_header_flags in the high nibble,
+ *  - service id,
+ *  - request id, varint when it is shorter, otherwise little-endian u32,
+ *  - optional varint sequence number and deadline.
+ *
+ * Headers of #kBasicCodecLegacyVersion (raw PayloadHeader struct) are still read, and a
+ * codec answers in the version of the last message it read, so a server talks to old
+ * clients without configuration. ERPC_HEADER_VERSION selects what new codecs write.
+ *
  * @ingroup infra_codec
  */
 class BasicCodec : public Codec
 {
 public:
-    static const uint8_t kBasicCodecVersion; /*!< Codec version. */
+    static const uint8_t kBasicCodecVersion;       /*!< Codec version, packed header. */
+    static const uint8_t kBasicCodecLegacyVersion; /*!< Codec version, raw PayloadHeader struct. */
 
     BasicCodec(void)
     : Codec()
+    , m_headerVersion(ERPC_HEADER_VERSION)
+    , m_headerSequence(false)
+    , m_hasDeadline(false)
+    , m_deadline(0)
     {
     }
 
+    /*!
+     * @brief Set header version written by startWriteMessage().
+     *
+     * @param[in] version #kBasicCodecVersion or #kBasicCodecLegacyVersion.
+     */
+    void setHeaderVersion(uint8_t version) { m_headerVersion = version; }
+
+    /*!
+     * @brief Return header version written by startWriteMessage().
+     *
+     * Updated to the version of every message header read.
+     *
+     * @return Header version.
+     */
+    uint8_t getHeaderVersion(void) { return m_headerVersion; }
+
+    /*!
+     * @brief Carry the sequence number in packed headers.
+     *
+     * @param[in] enable True to write the sequence number.
+     */
+    void setHeaderSequence(bool enable) { m_headerSequence = enable; }
+
+    /*!
+     * @brief Set deadline carried by the next packed header written.
+     *
+     * @param[in] deadline Deadline in milliseconds.
+     */
+    void setDeadline(uint32_t deadline)
+    {
+        m_deadline = deadline;
+        m_hasDeadline = true;
+    }
+
+    /*!
+     * @brief Return deadline of the last message header read.
+     *
+     * @param[out] deadline Deadline in milliseconds.
+     *
+     * @retval true The header carried a deadline.
+     * @retval false No deadline, @a deadline is unchanged.
+     */
+    bool getDeadline(uint32_t *deadline)
+    {
+        if (m_hasDeadline)
+        {
+            *deadline = m_deadline;
+        }
+        return m_hasDeadline;
+    }
+
     //! @name Encoding
     //@{
     /*!
@@ -146,6 +227,88 @@ public:
      */
     virtual void write(double value) override;
 
+    /*!
+     * @brief Prototype for write array of int8_t values.
+     *
+     * One bounds check and one copy, with ERPC_CODEC_BYTE_SWAP the copy is byte swapped.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int8_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of int16_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of int32_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of int64_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int64_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint8_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint8_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint16_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint32_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint64_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint64_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of float values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const float *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of double values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const double *values, uint32_t count) override;
+
     /*!
      * @brief Prototype for write uintptr value.
      *
@@ -307,6 +470,88 @@ public:
      */
     virtual void read(double *value) override;
 
+    /*!
+     * @brief Prototype for read array of int8_t values.
+     *
+     * One bounds check and one copy, with ERPC_CODEC_BYTE_SWAP the copy is byte swapped.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int8_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of int16_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of int32_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of int64_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int64_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint8_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint8_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint16_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint32_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint64_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint64_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of float values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(float *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of double values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(double *values, uint32_t count) override;
+
     /*!
      * @brief Prototype for read uintptr value.
      *
@@ -368,6 +613,68 @@ public:
      */
     virtual void readCallback(funPtr callbacks1, funPtr *callback2) override;
     //@}
+
+protected:
+    /*!
+     * @brief Write array of fixed width scalars.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    template <typename T>
+    void writeScalars(const T *values, uint32_t count);
+
+    /*!
+     * @brief Read array of fixed width scalars.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    template <typename T>
+    void readScalars(T *values, uint32_t count);
+
+    /*!
+     * @brief Write packed message header.
+     *
+     * @param[in] version Version byte of the header.
+     * @param[in] type Type of message.
+     * @param[in] service Which interface is requested.
+     * @param[in] request Which function need be called.
+     * @param[in] sequence Sequence number, written when enabled by setHeaderSequence().
+     */
+    void writeHeader(uint8_t version, message_type_t type, uint32_t service, const Hash request, uint32_t sequence);
+
+    /*!
+     * @brief Read packed message header following the version byte.
+     *
+     * @param[out] type Type of message.
+     * @param[out] service Which interface was used.
+     * @param[out] request Which function was called.
+     * @param[out] sequence Sequence number, 0 when not present.
+     */
+    void readHeader(message_type_t *type, uint32_t *service, Hash *request, uint32_t *sequence);
+
+    /*!
+     * @brief Write value as LEB128 varint.
+     *
+     * @param[in] value Value to write.
+     */
+    void writeVarint(uint64_t value);
+
+    /*!
+     * @brief Read LEB128 varint.
+     *
+     * Sets kErpcStatus_InvalidArgument when the encoded value does not fit into @a maxValue.
+     *
+     * @param[out] value Decoded value.
+     * @param[in] maxValue Largest value the destination type can hold.
+     */
+    void readVarint(uint64_t *value, uint64_t maxValue);
+
+    uint8_t m_headerVersion; /*!< Header version to write. */
+    bool m_headerSequence;   /*!< Write sequence number into packed headers. */
+    bool m_hasDeadline;      /*!< Deadline to write, or deadline of the last header read. */
+    uint32_t m_deadline;     /*!< Deadline in milliseconds. */
 };
 
 /*!
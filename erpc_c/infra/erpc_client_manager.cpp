@@ -31,12 +31,39 @@ void ClientManager::setTransport(Transport *transport)
     m_transport = transport;
 }
 
-RequestContext ClientManager::createRequest(const erpc::Hash& channel, bool isOneway)
+RequestContext ClientManager::createRequest(const erpc::Hash& channel, bool isOneway, const erpc::Hash method)
 {
+#if ERPC_LATENCY_STATS
+    uint32_t stamp = erpc_latency_now();
+#endif
+
     // Create codec to read and write the request.
     Codec *codec = createBufferAndCodec();
 
-    return RequestContext(channel, ++m_sequence, codec, isOneway);
+    if ((codec != NULL) && m_decodeStorage.isFixed())
+    {
+        // Other outstanding requests may still decode into the storage, or hold data decoded there.
+        if (m_decodeStorageUsers == 0)
+        {
+            m_decodeStorage.reset();
+        }
+        ++m_decodeStorageUsers;
+        codec->setArena(&m_decodeStorage);
+    }
+
+    RequestContext request(channel, ++m_sequence, codec, isOneway, method);
+
+#if ERPC_TRACE
+    erpc_trace_record(kErpcTraceClientValid, channel, request.getSequence());
+#endif
+
+#if ERPC_LATENCY_STATS
+    // The stub encodes the request until it performs it for the first time.
+    LatencyStats::mark(method, kErpcLatencyClientCreate, stamp);
+    request.setLatencyPhase(kErpcLatencyClientEncode, stamp);
+#endif
+
+    return request;
 }
 
 bool ClientManager::performRequest(RequestContext &request)
@@ -80,12 +107,39 @@ bool ClientManager::performClientRequest(RequestContext &request)
     }
 #endif
 
+#if ERPC_LATENCY_STATS
+    if ((request.getState() == RequestContextState::SENDING) && (request.getLatencyPhase() == kErpcLatencyClientEncode))
+    {
+        request.nextLatencyPhase(kErpcLatencyClientSend);
+    }
+#endif
+
+    if ((request.getState() == RequestContextState::SENDING) && (m_batchState == kBatchCollecting))
+    {
+        return appendToBatch(request);
+    }
+
+    if ((request.getState() == RequestContextState::PENDING) && (request.getBatchGeneration() != 0))
+    {
+        return takeBatchReply(request);
+    }
+
     if(request.getState() == RequestContextState::SENDING)
     {
          // Send invocation request to server.
         err = m_transport->send(request.getChannel(), request.getCodec()->getBuffer());
         if( err == kErpcStatus_Success){
+#if ERPC_TRACE
+            erpc_trace_record(kErpcTraceTransportSend, request.getChannel(), request.getSequence());
+#endif
+#if ERPC_MESSAGE_LOGGING
+            err = logMessage(request.getChannel(), request.getCodec()->getBuffer());
+            request.getCodec()->updateStatus(err);
+#endif
             request.setState(RequestContextState::SENT);
+#if ERPC_LATENCY_STATS
+            request.nextLatencyPhase(request.isOneway() ? kErpcLatencyPhaseCount : kErpcLatencyClientWait);
+#endif
         }
         else if (err == kErpcStatus_Pending){
             return false;
@@ -120,7 +174,17 @@ bool ClientManager::performClientRequest(RequestContext &request)
             }
             return false;
         }
+#if ERPC_TRACE
+        erpc_trace_record(kErpcTraceTransportReceive, request.getChannel(), request.getSequence());
+#endif
+#if ERPC_MESSAGE_LOGGING
+        err = logMessage(request.getChannel(), request.getCodec()->getBuffer());
+        request.getCodec()->updateStatus(err);
+#endif
         request.setState(RequestContextState::DONE);
+#if ERPC_LATENCY_STATS
+        request.nextLatencyPhase(kErpcLatencyClientDecode);
+#endif
 
         // Check the reply.
         verifyReply(request);
@@ -144,7 +208,7 @@ bool ClientManager::performNestedClientRequest(RequestContext &request)
 #if ERPC_MESSAGE_LOGGING
     if (request.getCodec()->isStatusOk() == true)
     {
-        err = logMessage(request.getCodec()->getBuffer());
+        err = logMessage(request.getChannel(), request.getCodec()->getBuffer());
         request.getCodec()->updateStatus(err);
     }
 #endif
@@ -170,7 +234,7 @@ bool ClientManager::performNestedClientRequest(RequestContext &request)
 #if ERPC_MESSAGE_LOGGING
         if (request.getCodec()->isStatusOk() == true)
         {
-            err = logMessage(request.getCodec()->getBuffer());
+            err = logMessage(request.getChannel(), request.getCodec()->getBuffer());
             request.getCodec()->updateStatus(err);
         }
 #endif
@@ -235,10 +299,323 @@ Codec *ClientManager::createBufferAndCodec(void)
 
 void ClientManager::releaseRequest(RequestContext &request)
 {
+#if ERPC_LATENCY_STATS
+    if (request.getLatencyPhase() == kErpcLatencyClientDecode)
+    {
+        // Stub decoded the reply before it released the request.
+        request.nextLatencyPhase(kErpcLatencyPhaseCount);
+    }
+#endif
+
+    if ((request.getBatchGeneration() != 0) && (request.getBatchGeneration() == m_batchGeneration))
+    {
+        // Request is dropped before it picked up its batched reply.
+        consumeBatchReply(request);
+    }
+
+    if (request.getState() == RequestContextState::SENDING)
+    {
+        // Request is dropped while the transport still defers its message.
+        m_transport->abandonSend(request.getChannel());
+    }
+
+    if ((request.getCodec()->getArena() == &m_decodeStorage) && (m_decodeStorageUsers > 0))
+    {
+        --m_decodeStorageUsers;
+    }
+
     m_messageFactory->dispose(request.getCodec()->getBuffer());
     m_codecFactory->dispose(request.getCodec());
 }
 
+erpc_status_t ClientManager::beginBatch(void)
+{
+    if (m_batchState != kBatchIdle)
+    {
+        return kErpcStatus_Fail;
+    }
+
+    m_batchCodec = createBufferAndCodec();
+    if (m_batchCodec == NULL)
+    {
+        return kErpcStatus_MemoryError;
+    }
+
+    // Generation 0 marks requests which are not batched.
+    if (++m_batchGeneration == 0)
+    {
+        ++m_batchGeneration;
+    }
+
+    m_batchCalls = 0;
+    m_batchReplies = 0;
+    m_batchConsumed = 0;
+    m_batchChannel = 0;
+    m_batchError = kErpcStatus_Success;
+    m_batchState = kBatchCollecting;
+
+    return kErpcStatus_Success;
+}
+
+erpc_status_t ClientManager::commitBatch(void)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    switch (m_batchState)
+    {
+        case kBatchIdle:
+            return kErpcStatus_Fail;
+
+        case kBatchReplied:
+            return kErpcStatus_Success;
+
+        case kBatchFailed:
+            return m_batchError;
+
+        case kBatchCollecting:
+            if (m_batchCalls == 0)
+            {
+                releaseBatchBuffer();
+                m_batchState = kBatchIdle;
+                return kErpcStatus_Success;
+            }
+            m_batchState = kBatchSending;
+            break;
+
+        default:
+            break;
+    }
+
+    if (m_batchState == kBatchSending)
+    {
+        err = m_transport->send(m_batchChannel, m_batchCodec->getBuffer());
+        if (err == kErpcStatus_Success)
+        {
+#if ERPC_TRACE
+            erpc_trace_record(kErpcTraceTransportSend, m_batchChannel, m_batchSequence);
+#endif
+            if (m_batchReplies == 0)
+            {
+                // Only oneway calls, they are already done.
+                releaseBatchBuffer();
+                m_batchState = kBatchIdle;
+                return kErpcStatus_Success;
+            }
+            m_batchState = kBatchReceiving;
+        }
+        else if (err != kErpcStatus_Pending)
+        {
+            failBatch(err);
+        }
+    }
+
+    if (m_batchState == kBatchReceiving)
+    {
+        err = m_transport->receive(m_batchChannel, m_batchCodec->getBuffer());
+        if (err == kErpcStatus_Success)
+        {
+#if ERPC_TRACE
+            erpc_trace_record(kErpcTraceTransportReceive, m_batchChannel, m_batchSequence);
+#endif
+            err = parseBatchReply();
+            if (err == kErpcStatus_Success)
+            {
+                m_batchState = kBatchReplied;
+                if (m_batchConsumed >= m_batchReplies)
+                {
+                    // Every call of the batch was released meanwhile.
+                    releaseBatchBuffer();
+                    m_batchState = kBatchIdle;
+                }
+            }
+            else
+            {
+                failBatch(err);
+            }
+        }
+        else if (err != kErpcStatus_Pending)
+        {
+            failBatch(err);
+        }
+    }
+
+    return err;
+}
+
+bool ClientManager::isInCollectedBatch(RequestContext &request) const
+{
+    return (m_batchState == kBatchCollecting) && (request.getState() == RequestContextState::PENDING) &&
+           (request.getBatchGeneration() == m_batchGeneration);
+}
+
+bool ClientManager::appendToBatch(RequestContext &request)
+{
+    MessageBuffer *message = request.getCodec()->getBuffer();
+    MessageBuffer *batch = m_batchCodec->getBuffer();
+
+    if (m_batchCalls == 0)
+    {
+        // The batch goes out on the channel of its first call, the server replies there.
+        m_batchChannel = request.getChannel();
+        m_batchSequence = ++m_sequence;
+        m_batchCodec->startWriteMessage(kBatchInvocationMessage, 0, m_batchChannel, m_batchSequence);
+        m_batchCountOffset = batch->getUsed();
+        m_batchCodec->write(m_batchCalls);
+        // Headers carry the sequence only when configured to, the server echoes this one in its reply.
+        m_batchCodec->write(m_batchSequence);
+    }
+
+    if ((m_batchCalls >= ERPC_BATCH_MAX_CALLS) || (batch->getFree() < (sizeof(uint32_t) + message->getUsed())))
+    {
+        if (m_batchCalls == 0)
+        {
+            // Drop the header again, the next call starts the batch over.
+            batch->setUsed(0);
+            m_batchCodec->reset();
+        }
+        request.getCodec()->updateStatus(kErpcStatus_BufferOverrun);
+        return false;
+    }
+
+    m_batchCodec->writeBinary(message->getUsed(), message->get());
+    ++m_batchCalls;
+    (void)batch->write(m_batchCountOffset, &m_batchCalls, sizeof(m_batchCalls));
+
+    if (request.isOneway())
+    {
+        request.setState(RequestContextState::DONE);
+        return true;
+    }
+
+    request.setBatch(m_batchGeneration, m_batchReplies++);
+    request.setState(RequestContextState::PENDING);
+#if ERPC_LATENCY_STATS
+    // The batch is sent by commitBatch(), the call just waits from now on.
+    request.setLatencyPhase(kErpcLatencyClientWait, erpc_latency_now());
+#endif
+    return false;
+}
+
+bool ClientManager::takeBatchReply(RequestContext &request)
+{
+    if (request.getBatchGeneration() != m_batchGeneration)
+    {
+        // Batch of this request was already finished without it.
+        request.getCodec()->updateStatus(kErpcStatus_Fail);
+        return false;
+    }
+
+    if (m_batchState == kBatchFailed)
+    {
+        request.getCodec()->updateStatus(m_batchError);
+    }
+    else if (m_batchState == kBatchReplied)
+    {
+        MessageBuffer *message = request.getCodec()->getBuffer();
+        uint16_t index = request.getBatchIndex();
+
+        if (m_batchReplyLength[index] == 0)
+        {
+            // Server could not process this call.
+            request.getCodec()->updateStatus(kErpcStatus_Fail);
+        }
+        else if (m_batchReplyLength[index] > message->getLength())
+        {
+            request.getCodec()->updateStatus(kErpcStatus_BufferOverrun);
+        }
+        else
+        {
+            (void)message->write(0, m_batchReplyData[index], m_batchReplyLength[index]);
+            message->setUsed(m_batchReplyLength[index]);
+            request.setState(RequestContextState::DONE);
+#if ERPC_LATENCY_STATS
+            request.nextLatencyPhase(kErpcLatencyClientDecode);
+#endif
+            verifyReply(request);
+        }
+    }
+    else
+    {
+        // Batch is not committed or its reply did not arrive yet.
+        return false;
+    }
+
+    consumeBatchReply(request);
+
+    return request.getCodec()->isStatusOk();
+}
+
+void ClientManager::consumeBatchReply(RequestContext &request)
+{
+    request.setBatch(0, 0);
+    ++m_batchConsumed;
+
+    if ((m_batchConsumed >= m_batchReplies) && ((m_batchState == kBatchReplied) || (m_batchState == kBatchFailed)))
+    {
+        releaseBatchBuffer();
+        m_batchState = kBatchIdle;
+    }
+}
+
+erpc_status_t ClientManager::parseBatchReply(void)
+{
+    message_type_t msgType;
+    uint32_t service;
+    Hash requestNumber;
+    uint32_t sequence;
+    uint16_t count = 0;
+
+    m_batchCodec->reset();
+    m_batchCodec->startReadMessage(&msgType, &service, &requestNumber, &sequence);
+    if (m_batchCodec->isStatusOk() && (msgType != kBatchReplyMessage))
+    {
+        m_batchCodec->updateStatus(kErpcStatus_ExpectedReply);
+    }
+
+    m_batchCodec->read(&count);
+    if (m_batchCodec->isStatusOk() && (count != m_batchReplies))
+    {
+        m_batchCodec->updateStatus(kErpcStatus_ExpectedReply);
+    }
+
+    // A reply of an earlier batch which failed or timed out must not be handed to these calls.
+    m_batchCodec->read(&sequence);
+    if (m_batchCodec->isStatusOk() && ((sequence != m_batchSequence) || (requestNumber != m_batchChannel)))
+    {
+        m_batchCodec->updateStatus(kErpcStatus_ExpectedReply);
+    }
+
+    for (uint16_t i = 0; (i < count) && m_batchCodec->isStatusOk(); ++i)
+    {
+        uint32_t length;
+        uint8_t *data;
+
+        // Replies stay in the batch buffer until every call picked up its own.
+        m_batchCodec->readBinary(&length, &data);
+        m_batchReplyData[i] = data;
+        m_batchReplyLength[i] = static_cast<uint16_t>(length);
+    }
+
+    return m_batchCodec->getStatus();
+}
+
+void ClientManager::failBatch(erpc_status_t err)
+{
+    m_batchError = err;
+    releaseBatchBuffer();
+    m_batchState = (m_batchReplies > m_batchConsumed) ? kBatchFailed : kBatchIdle;
+}
+
+void ClientManager::releaseBatchBuffer(void)
+{
+    if (m_batchCodec != NULL)
+    {
+        m_messageFactory->dispose(m_batchCodec->getBuffer());
+        m_codecFactory->dispose(m_batchCodec);
+        m_batchCodec = NULL;
+    }
+}
+
 void ClientManager::callErrorHandler(erpc_status_t err, const erpc::Hash functionID)
 {
     if (m_errorHandler != NULL)
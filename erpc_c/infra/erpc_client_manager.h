@@ -15,6 +15,8 @@
 #include "erpc_client_server_common.h"
 #include "erpc_codec.h"
 #include "erpc_config_internal.h"
+#include "erpc_latency_stats.h"
+#include "erpc_trace.h"
 #include "erpc_transport.h"
 #include <functional>
 #if ERPC_NESTED_CALLS
@@ -68,6 +70,17 @@ public:
     , m_transport(NULL)
     , m_sequence(0)
     , m_errorHandler(NULL)
+    , m_batchState(kBatchIdle)
+    , m_batchCodec(NULL)
+    , m_batchGeneration(0)
+    , m_batchCalls(0)
+    , m_batchCountOffset(0)
+    , m_batchReplies(0)
+    , m_batchConsumed(0)
+    , m_batchChannel(0)
+    , m_batchSequence(0)
+    , m_batchError(kErpcStatus_Success)
+    , m_decodeStorageUsers(0)
 #if ERPC_NESTED_CALLS
     , m_server(NULL)
     , m_serverThreadId(NULL)
@@ -107,8 +120,9 @@ public:
      * @brief This function creates request context.
      *
      * @param[in] isOneway True if need send data only, else false.
+     * @param[in] method Hash of the called method, for statistics.
      */
-    virtual RequestContext createRequest(const erpc::Hash& channel, bool isOneway);
+    virtual RequestContext createRequest(const erpc::Hash& channel, bool isOneway, const erpc::Hash method = 0);
 
     /*!
      * @brief This function performs request.
@@ -141,8 +155,61 @@ public:
      */
     void callErrorHandler(erpc_status_t err, const erpc::Hash functionID);
 
+    /*!
+     * @brief Decode out data of replies into caller-provided storage.
+     *
+     * Client stubs then take the memory for decoded out lists, binaries, strings and structs
+     * from @a buffer instead of erpc_malloc(). A reply which doesn't fit fails with
+     * #kErpcStatus_BufferOverrun. The storage is reset when a request is created while no other
+     * request is outstanding, so data of a reply must be used or copied before the next call,
+     * and it must not be freed. Calls which overlap, like the calls of a batch, share the
+     * storage until the last of them is released.
+     *
+     * @param[in] buffer Storage, NULL goes back to erpc_malloc().
+     * @param[in] size Size of the storage in bytes.
+     */
+    void setDecodeStorage(void *buffer, uint32_t size) { m_decodeStorage.setBuffer(buffer, size); }
+
     void setId(size_t id){m_id = id;}
     size_t getId(){return m_id;}
+
+    /*!
+     * @brief Start collecting calls into one batch request.
+     *
+     * Until commitBatch() is called, client stubs do not send their requests but append
+     * them to the batch. Stubs of calls with a reply stay pending until the batched reply
+     * arrives, then they pick up their own reply when they are called again. A function with
+     * a reply can be called once per batch, a second call while the first one waits in the
+     * batch is rejected with #kErpcStatus_Fail.
+     *
+     * @retval kErpcStatus_Success Batch started.
+     * @retval kErpcStatus_Fail Previous batch is not finished yet.
+     * @retval kErpcStatus_MemoryError No buffer for the batch.
+     */
+    erpc_status_t beginBatch(void);
+
+    /*!
+     * @brief Send the collected batch and receive the batched reply.
+     *
+     * Non-blocking like the stubs, call it until it stops returning #kErpcStatus_Pending.
+     *
+     * @retval kErpcStatus_Success Batch sent and its reply received.
+     * @retval kErpcStatus_Pending Still sending or waiting for the reply.
+     * @retval other Batch failed, pending calls of the batch report this error.
+     */
+    erpc_status_t commitBatch(void);
+
+    /*!
+     * @brief Check whether a call waits in the batch which is still being collected.
+     *
+     * Such a call cannot make progress before commitBatch(), so calling its stub again is
+     * a second call of the same function and not a poll of the first one.
+     *
+     * @param[in] request Request context to check.
+     *
+     * @return True when the request is pending in the batch being collected.
+     */
+    bool isInCollectedBatch(RequestContext &request) const;
     
 #if ERPC_NESTED_CALLS
     /*!
@@ -167,7 +234,33 @@ protected:
     uint32_t m_sequence;                    //!< Sequence number.
     client_error_handler_t m_errorHandler;  //!< Pointer to function error handler.
     size_t m_id;
-    
+
+    /*! @brief States of the client batch. */
+    enum BatchState
+    {
+        kBatchIdle,       //!< No batch.
+        kBatchCollecting, //!< Stubs append their requests.
+        kBatchSending,    //!< Batch request is being sent.
+        kBatchReceiving,  //!< Waiting for the batched reply.
+        kBatchReplied,    //!< Reply received, stubs pick up their part.
+        kBatchFailed      //!< Batch failed, stubs pick up the error.
+    };
+
+    BatchState m_batchState;                                 //!< Current batch state.
+    Codec *m_batchCodec;                                     //!< Codec with the batch request and reply.
+    uint32_t m_batchGeneration;                              //!< Identifies the current batch in requests.
+    uint16_t m_batchCalls;                                   //!< Count of calls in the batch.
+    uint16_t m_batchCountOffset;                             //!< Offset of the call count in the batch.
+    uint16_t m_batchReplies;                                 //!< Count of calls expecting a reply.
+    uint16_t m_batchConsumed;                                //!< Count of replies already picked up.
+    Hash m_batchChannel;                                     //!< Channel of the batch (first call).
+    uint32_t m_batchSequence;                                //!< Sequence of the batch request, echoed by its reply.
+    erpc_status_t m_batchError;                              //!< Error of a failed batch.
+    const uint8_t *m_batchReplyData[ERPC_BATCH_MAX_CALLS];   //!< Start of each reply in the batched reply.
+    uint16_t m_batchReplyLength[ERPC_BATCH_MAX_CALLS];       //!< Length of each reply in the batched reply.
+    Arena m_decodeStorage;                                   //!< Caller-provided storage for decoded replies.
+    uint16_t m_decodeStorageUsers;                           //!< Requests created and not released, using the storage.
+
 #if ERPC_NESTED_CALLS
     Server *m_server;                     //!< Server used for nested calls.
     Thread::thread_id_t m_serverThreadId; //!< Thread in which server run function is called.
@@ -197,6 +290,50 @@ protected:
     //! @brief Validate that an incoming message is a reply.
     virtual void verifyReply(RequestContext &request);
 
+    /*!
+     * @brief Append an encoded request to the batch.
+     *
+     * @param[in] request Request in SENDING state.
+     *
+     * @return True when the request is done (oneway), false when it waits for the batched reply.
+     */
+    bool appendToBatch(RequestContext &request);
+
+    /*!
+     * @brief Hand the batched reply of a request over to its codec.
+     *
+     * @param[in] request Batched request in PENDING state.
+     *
+     * @return True when the reply was taken, false when it is not available (yet).
+     */
+    bool takeBatchReply(RequestContext &request);
+
+    /*!
+     * @brief Account a batched request as finished and release the batch after the last one.
+     *
+     * @param[in] request Batched request.
+     */
+    void consumeBatchReply(RequestContext &request);
+
+    /*!
+     * @brief Parse the batched reply into per-call replies.
+     *
+     * @return Status of parsing.
+     */
+    erpc_status_t parseBatchReply(void);
+
+    /*!
+     * @brief Mark the batch as failed with given error.
+     *
+     * @param[in] err Error reported to pending calls of the batch.
+     */
+    void failBatch(erpc_status_t err);
+
+    /*!
+     * @brief Dispose the batch buffer and codec.
+     */
+    void releaseBatchBuffer(void);
+
     /*!
      * @brief Create message buffer and codec.
      *
@@ -233,7 +370,18 @@ class RequestContext
 {
 public:
     
-    RequestContext(): m_channel{}, m_state(RequestContextState::INVALID) {}
+    RequestContext()
+    : m_channel{}
+    , m_method(0)
+    , m_state(RequestContextState::INVALID)
+    , m_batchGeneration(0)
+    , m_batchIndex(0)
+#if ERPC_LATENCY_STATS
+    , m_latencyPhase(kErpcLatencyPhaseCount)
+    , m_latencyStamp(0)
+#endif
+    {
+    }
 
     /*!
      * @brief Constructor.
@@ -243,13 +391,21 @@ public:
      * @param[in] sequence Sequence number.
      * @param[in] codec Set in inout codec.
      * @param[in] isOneway Set information if codec is only oneway or bidirectional.
+     * @param[in] method Hash of the called method.
      */
-    RequestContext(const erpc::Hash& channel, uint32_t sequence, Codec *codec, bool argIsOneway)
+    RequestContext(const erpc::Hash& channel, uint32_t sequence, Codec *codec, bool argIsOneway, const Hash method = 0)
     : m_channel{channel}
+    , m_method{method}
     , m_sequence{sequence}
     , m_codec{codec}
     , m_oneway{argIsOneway}
     , m_state{RequestContextState::VALID}
+    , m_batchGeneration{0}
+    , m_batchIndex{0}
+#if ERPC_LATENCY_STATS
+    , m_latencyPhase{kErpcLatencyPhaseCount}
+    , m_latencyStamp{0}
+#endif
     {
     }
 
@@ -282,16 +438,85 @@ public:
     void setIsOneway(bool oneway) { m_oneway = oneway; }
 
     RequestContextState getState() { return m_state;}
-    void setState(RequestContextState state) { m_state = state; }
+    void setState(RequestContextState state)
+    {
+#if ERPC_TRACE
+        if ((state != m_state) && (state != RequestContextState::INVALID))
+        {
+            erpc_trace_record(static_cast<erpc_trace_event_t>(kErpcTraceClientValid + (state - RequestContextState::VALID)),
+                              m_channel, m_sequence);
+        }
+#endif
+        m_state = state;
+    }
 
     const Hash& getChannel() const { return m_channel;}
 
+    /*!
+     * @brief Get hash of the called method.
+     *
+     * @return Method hash, 0 when the caller didn't pass it.
+     */
+    Hash getMethod(void) const { return m_method; }
+
+    /*!
+     * @brief Assign the request to a client batch.
+     *
+     * @param[in] generation Batch the request belongs to, 0 when not batched.
+     * @param[in] index Index of the request reply in the batched reply.
+     */
+    void setBatch(uint32_t generation, uint16_t index)
+    {
+        m_batchGeneration = generation;
+        m_batchIndex = index;
+    }
+
+    uint32_t getBatchGeneration(void) const { return m_batchGeneration; }
+    uint16_t getBatchIndex(void) const { return m_batchIndex; }
+
+#if ERPC_LATENCY_STATS
+    /*!
+     * @brief Start a latency phase without recording the previous one.
+     *
+     * @param[in] phase Phase the request enters.
+     * @param[in] stamp Time the phase started.
+     */
+    void setLatencyPhase(erpc_latency_phase_t phase, uint32_t stamp)
+    {
+        m_latencyPhase = phase;
+        m_latencyStamp = stamp;
+    }
+
+    /*!
+     * @brief Record latency of the current phase and start the next one.
+     *
+     * @param[in] phase Phase the request enters, #kErpcLatencyPhaseCount when it is done.
+     */
+    void nextLatencyPhase(erpc_latency_phase_t phase)
+    {
+        if (m_latencyPhase < kErpcLatencyPhaseCount)
+        {
+            LatencyStats::mark(m_method, m_latencyPhase, m_latencyStamp);
+        }
+        m_latencyPhase = phase;
+    }
+
+    erpc_latency_phase_t getLatencyPhase(void) const { return m_latencyPhase; }
+#endif
+
 protected:
     erpc::Hash m_channel;
+    Hash m_method;       //!< Hash of the called method.
     uint32_t m_sequence; //!< Sequence number. To be sure that reply belong to current request.
     Codec *m_codec;      //!< Inout codec. Codec for receiving and sending data.
     bool m_oneway;       //!< When true, request context will be oneway type (only send data).
     RequestContextState m_state;
+    uint32_t m_batchGeneration; //!< Client batch the request belongs to, 0 when not batched.
+    uint16_t m_batchIndex;      //!< Index of the request reply in the batched reply.
+#if ERPC_LATENCY_STATS
+    erpc_latency_phase_t m_latencyPhase; //!< Phase the request is in.
+    uint32_t m_latencyStamp;             //!< Time the phase started.
+#endif
 };
 
 } // namespace erpc
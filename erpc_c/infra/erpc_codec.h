@@ -11,8 +11,10 @@
 #ifndef _EMBEDDED_RPC__CODEC_H_
 #define _EMBEDDED_RPC__CODEC_H_
 
+#include "erpc_arena.h"
 #include "erpc_common.h"
 #include "erpc_message_buffer.h"
+#include "erpc_port.h"
 
 #include <cstring>
 #include <stdint.h>
@@ -42,7 +44,10 @@ typedef enum _message_type
     kReplyMessage,
     kNotificationMessage,
     kFastMessage,
-    kFastOnewayMessage
+    kFastOnewayMessage,
+    kOnewayBatchMessage,
+    kBatchInvocationMessage,
+    kBatchReplyMessage
 } message_type_t;
 
 typedef void *funPtr;          // Pointer to functions
@@ -102,6 +107,7 @@ public:
     virtual void setBuffer(MessageBuffer &buf)
     {
         m_buffer = buf;
+        m_buffer.setIntegrityCheck(integrity_);
         m_cursor.set(&m_buffer);
         m_status = kErpcStatus_Success;
     }
@@ -141,8 +147,62 @@ public:
         }
     }
 
-    void setSkipCrc(bool skip){ skipCrc_ = skip; }
-    bool getSkipCrc(){ return skipCrc_; }
+    /// skip-CRC travels with the message buffer, so the transport sees it
+    void setSkipCrc(bool skip){ m_buffer.setSkipCrc(skip); }
+    bool getSkipCrc(){ return m_buffer.getSkipCrc(); }
+
+    /// the transport attaches its integrity check, the check value is then computed while writing
+    void setIntegrityCheck(IntegrityCheck *check){ integrity_ = check; m_buffer.setIntegrityCheck(check); }
+
+    /// the server attaches its per-request arena and the client the caller's decode storage,
+    /// NULL makes allocate() use erpc_malloc() only
+    void setArena(Arena *arena){ arena_ = arena; }
+    Arena *getArena(){ return arena_; }
+
+    /*!
+     * @brief Allocate memory for decoded data.
+     *
+     * Memory comes from the attached arena. When there is none or it is exhausted, erpc_malloc()
+     * is used, unless the arena is caller-provided storage. Exhausted storage sets
+     * kErpcStatus_BufferOverrun instead.
+     *
+     * @param[in] size Size of the memory in bytes.
+     *
+     * @return Pointer to the memory, NULL when out of memory.
+     */
+    void *allocate(uint32_t size)
+    {
+        void *ptr = (arena_ != NULL) ? arena_->allocate(size) : NULL;
+
+        if (ptr == NULL)
+        {
+            if ((arena_ != NULL) && arena_->isFixed())
+            {
+                updateStatus(kErpcStatus_BufferOverrun);
+            }
+            else
+            {
+                ptr = erpc_malloc(size);
+            }
+        }
+
+        return ptr;
+    }
+
+    /*!
+     * @brief Free memory returned by allocate() or erpc_malloc().
+     *
+     * Arena memory is freed at once when the request is done, so only other memory is freed.
+     *
+     * @param[in] ptr Pointer to the memory, may be NULL.
+     */
+    void release(void *ptr)
+    {
+        if ((arena_ == NULL) || !arena_->contains(ptr))
+        {
+            erpc_free(ptr);
+        }
+    }
     
     void setFast(bool fast){ fastMessage_ = fast; }
     bool getFast(){ return fastMessage_; }
@@ -240,6 +300,89 @@ public:
      */
     virtual void write(double value) = 0;
 
+    /*!
+     * @brief Prototype for write array of int8_t values.
+     *
+     * Encoded the same as writing each element. The default does exactly that, codecs
+     * override it to code the whole array at once.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int8_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of int16_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int16_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of int32_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int32_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of int64_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int64_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of uint8_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint8_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of uint16_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint16_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of uint32_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint32_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of uint64_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint64_t *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of float values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const float *values, uint32_t count) { writeEach(values, count); }
+
+    /*!
+     * @brief Prototype for write array of double values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const double *values, uint32_t count) { writeEach(values, count); }
+
     /*!
      * @brief Prototype for write uintptr value.
      *
@@ -392,6 +535,89 @@ public:
      */
     virtual void read(double *value) = 0;
 
+    /*!
+     * @brief Prototype for read array of int8_t values.
+     *
+     * Decoded the same as reading each element. The default does exactly that, codecs
+     * override it to code the whole array at once.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int8_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of int16_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int16_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of int32_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int32_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of int64_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int64_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of uint8_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint8_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of uint16_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint16_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of uint32_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint32_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of uint64_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint64_t *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of float values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(float *values, uint32_t count) { readEach(values, count); }
+
+    /*!
+     * @brief Prototype for read array of double values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(double *values, uint32_t count) { readEach(values, count); }
+
     /*!
      * @brief Prototype for read uintptr value.
      *
@@ -454,13 +680,44 @@ public:
     virtual void readCallback(funPtr callbacks1, funPtr *callback2) = 0;
 
 protected:
+    /*!
+     * @brief Write array element by element.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    template <typename T>
+    void writeEach(const T *values, uint32_t count)
+    {
+        for (uint32_t i = 0; (i < count) && isStatusOk(); ++i)
+        {
+            write(values[i]);
+        }
+    }
+
+    /*!
+     * @brief Read array element by element.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    template <typename T>
+    void readEach(T *values, uint32_t count)
+    {
+        for (uint32_t i = 0; (i < count) && isStatusOk(); ++i)
+        {
+            read(&values[i]);
+        }
+    }
+
     MessageBuffer m_buffer;         /*!< Message buffer object */
     MessageBuffer::Cursor m_cursor; /*!< Copy data to message buffers. */
     erpc_status_t m_status;         /*!< Status of serialized data. */
 
-    bool skipCrc_ = false;
     bool fastMessage_ = false; 
     bool oneway_ = false;
+    IntegrityCheck *integrity_ = NULL;
+    Arena *arena_ = NULL;
 };
 
 /*!
@@ -24,6 +24,42 @@
 
 namespace erpc{
     using Hash = uint32_t;
+
+    //! Bit position of the priority field inside a function id (channel hash).
+    static const uint32_t kHashPriorityShift = 24U;
+
+    //! Mask of the priority field after shifting, priorities range from 0 (lowest) to 31 (highest).
+    static const uint32_t kHashPriorityMask = 0x1FU;
+
+    //! Mask of the prototype hash part of a function id.
+    static const uint32_t kHashIdMask = 0x00FFFFFFU;
+
+    /*!
+     * @brief Returns the priority erpcgen folded into the channel hash (@priority annotation).
+     *
+     * @param[in] channel Channel hash (function id).
+     *
+     * @return Priority in range 0..31, higher value means more urgent.
+     */
+    static inline uint32_t getHashPriority(Hash channel)
+    {
+        return (channel >> kHashPriorityShift) & kHashPriorityMask;
+    }
+
+    /*!
+     * @brief Maps a channel hash onto a 29-bit extended CAN arbitration identifier.
+     *
+     * On CAN the lowest identifier wins arbitration, so the priority is inverted and placed
+     * into the most significant bits, followed by the 24-bit prototype hash.
+     *
+     * @param[in] channel Channel hash (function id).
+     *
+     * @return Extended CAN identifier.
+     */
+    static inline uint32_t getCanArbitrationId(Hash channel)
+    {
+        return ((kHashPriorityMask - getHashPriority(channel)) << kHashPriorityShift) | (channel & kHashIdMask);
+    }
 }
 
 /*! @brief eRPC status return codes. */
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_compact_codec.h"
+
+/// for resolving the forward declaration of Transport in erpc_codec.h
+#include "erpc_transport.h"
+
+#include "erpc_manually_constructed.h"
+
+#if ERPC_ALLOCATION_POLICY == ERPC_ALLOCATION_POLICY_DYNAMIC
+#include <new>
+#endif
+#include <cassert>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+// High bit keeps the version apart from BasicCodec versions.
+const uint8_t CompactCodec::kCompactCodecVersion = 0x81;
+
+static inline uint64_t zigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static inline int64_t zigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1U);
+}
+
+void CompactCodec::startWriteMessage(message_type_t type, uint32_t service, const Hash request, uint32_t sequence)
+{
+    if (getFast())
+    {
+        BasicCodec::startWriteMessage(type, service, request, sequence);
+    }
+    else
+    {
+        writeHeader(kCompactCodecVersion, type, service, request, sequence);
+    }
+}
+
+void CompactCodec::write(int16_t value)
+{
+    writeVarint(zigzagEncode(value));
+}
+
+void CompactCodec::write(int32_t value)
+{
+    writeVarint(zigzagEncode(value));
+}
+
+void CompactCodec::write(int64_t value)
+{
+    writeVarint(zigzagEncode(value));
+}
+
+void CompactCodec::write(uint16_t value)
+{
+    writeVarint(value);
+}
+
+void CompactCodec::write(uint32_t value)
+{
+    writeVarint(value);
+}
+
+void CompactCodec::write(uint64_t value)
+{
+    writeVarint(value);
+}
+
+void CompactCodec::writeArray(const int16_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::write(values[i]);
+    }
+}
+
+void CompactCodec::writeArray(const int32_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::write(values[i]);
+    }
+}
+
+void CompactCodec::writeArray(const int64_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::write(values[i]);
+    }
+}
+
+void CompactCodec::writeArray(const uint16_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::write(values[i]);
+    }
+}
+
+void CompactCodec::writeArray(const uint32_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::write(values[i]);
+    }
+}
+
+void CompactCodec::writeArray(const uint64_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::write(values[i]);
+    }
+}
+
+void CompactCodec::startReadMessage(message_type_t *type, uint32_t *service, Hash *request, uint32_t *sequence)
+{
+    if (getFast())
+    {
+        BasicCodec::startReadMessage(type, service, request, sequence);
+    }
+    else
+    {
+        uint8_t version = 0;
+
+        readData(&version, sizeof(version));
+
+        if (!m_status && (version != kCompactCodecVersion))
+        {
+            updateStatus(kErpcStatus_InvalidMessageVersion);
+        }
+
+        readHeader(type, service, request, sequence);
+    }
+}
+
+void CompactCodec::readSignedVarint(int64_t *value, int64_t minValue, int64_t maxValue)
+{
+    uint64_t encoded = 0;
+
+    readVarint(&encoded, UINT64_MAX);
+
+    if (!m_status)
+    {
+        int64_t result = zigzagDecode(encoded);
+        if ((result < minValue) || (result > maxValue))
+        {
+            updateStatus(kErpcStatus_InvalidArgument);
+        }
+        else
+        {
+            *value = result;
+        }
+    }
+}
+
+void CompactCodec::read(int16_t *value)
+{
+    int64_t v = 0;
+
+    readSignedVarint(&v, INT16_MIN, INT16_MAX);
+    if (!m_status)
+    {
+        *value = static_cast<int16_t>(v);
+    }
+}
+
+void CompactCodec::read(int32_t *value)
+{
+    int64_t v = 0;
+
+    readSignedVarint(&v, INT32_MIN, INT32_MAX);
+    if (!m_status)
+    {
+        *value = static_cast<int32_t>(v);
+    }
+}
+
+void CompactCodec::read(int64_t *value)
+{
+    readSignedVarint(value, INT64_MIN, INT64_MAX);
+}
+
+void CompactCodec::read(uint16_t *value)
+{
+    uint64_t v = 0;
+
+    readVarint(&v, UINT16_MAX);
+    if (!m_status)
+    {
+        *value = static_cast<uint16_t>(v);
+    }
+}
+
+void CompactCodec::read(uint32_t *value)
+{
+    uint64_t v = 0;
+
+    readVarint(&v, UINT32_MAX);
+    if (!m_status)
+    {
+        *value = static_cast<uint32_t>(v);
+    }
+}
+
+void CompactCodec::read(uint64_t *value)
+{
+    readVarint(value, UINT64_MAX);
+}
+
+void CompactCodec::readArray(int16_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::read(&values[i]);
+    }
+}
+
+void CompactCodec::readArray(int32_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::read(&values[i]);
+    }
+}
+
+void CompactCodec::readArray(int64_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::read(&values[i]);
+    }
+}
+
+void CompactCodec::readArray(uint16_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::read(&values[i]);
+    }
+}
+
+void CompactCodec::readArray(uint32_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::read(&values[i]);
+    }
+}
+
+void CompactCodec::readArray(uint64_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; (i < count) && !m_status; ++i)
+    {
+        CompactCodec::read(&values[i]);
+    }
+}
+
+ERPC_MANUALLY_CONSTRUCTED_ARRAY_STATIC(CompactCodec, s_compactCodecManual, ERPC_CODEC_COUNT);
+
+Codec *CompactCodecFactory ::create()
+{
+    ERPC_CREATE_NEW_OBJECT(CompactCodec, s_compactCodecManual, ERPC_CODEC_COUNT)
+}
+
+Codec *CompactCodecFactory ::create(Transport *underlyingTransportPtr)
+{
+    Codec *codec = create();
+    /// let the transport adjust the codec, as BasicCodecFactory does
+    if (underlyingTransportPtr != nullptr)
+    {
+        underlyingTransportPtr->codecCreationCallback(codec);
+    }
+    return codec;
+}
+
+void CompactCodecFactory ::dispose(Codec *codec)
+{
+    ERPC_DESTROY_OBJECT(codec, s_compactCodecManual, ERPC_CODEC_COUNT)
+}
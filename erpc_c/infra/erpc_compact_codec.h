@@ -0,0 +1,308 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__COMPACT_SERIALIZATION_H_
+#define _EMBEDDED_RPC__COMPACT_SERIALIZATION_H_
+
+#include "erpc_basic_codec.h"
+
+/*!
+ * @addtogroup infra_codec
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+/*!
+ * @brief Size optimized binary serialization format.
+ *
+ * Same layout as BasicCodec, but multi-byte integers are written as LEB128 varints,
+ * signed ones zigzag encoded first. Lengths of strings, binaries and lists and union
+ * discriminators are integers too, so values below 128 (or -64..63 for signed) take a
+ * single byte. Bools, 8-bit integers and floating point values are written unchanged.
+ *
+ * Messages start with the BasicCodec packed header carrying #kCompactCodecVersion. Fast
+ * messages use the BasicCodec fast header.
+ *
+ * Both sides of a connection have to use the same codec.
+ *
+ * @ingroup infra_codec
+ */
+class CompactCodec : public BasicCodec
+{
+public:
+    static const uint8_t kCompactCodecVersion; /*!< Codec version. */
+
+    CompactCodec(void)
+    : BasicCodec()
+    {
+    }
+
+    //! @name Encoding
+    //@{
+    /*!
+     * @brief Prototype for write header of message.
+     *
+     * @param[in] type Type of message.
+     * @param[in] service Which interface is requested.
+     * @param[in] request Which function need be called.
+     * @param[in] sequence Send sequence number to be sure that
+     *                    received message is reply for current request. or write function.
+     */
+    virtual void startWriteMessage(message_type_t type, uint32_t service, const Hash request, uint32_t sequence) override;
+
+    /*!
+     * @brief Prototype for write int16_t value.
+     *
+     * @param[in] value int16_t typed value to write.
+     */
+    virtual void write(int16_t value) override;
+
+    /*!
+     * @brief Prototype for write int32_t value.
+     *
+     * @param[in] value int32_t typed value to write.
+     */
+    virtual void write(int32_t value) override;
+
+    /*!
+     * @brief Prototype for write int64_t value.
+     *
+     * @param[in] value int64_t typed value to write.
+     */
+    virtual void write(int64_t value) override;
+
+    /*!
+     * @brief Prototype for write uint16_t value.
+     *
+     * @param[in] value uint16_t typed value to write.
+     */
+    virtual void write(uint16_t value) override;
+
+    /*!
+     * @brief Prototype for write uint32_t value.
+     *
+     * @param[in] value uint32_t typed value to write.
+     */
+    virtual void write(uint32_t value) override;
+
+    /*!
+     * @brief Prototype for write uint64_t value.
+     *
+     * @param[in] value uint64_t typed value to write.
+     */
+    virtual void write(uint64_t value) override;
+
+    /*!
+     * @brief Prototype for write array of int16_t values.
+     *
+     * Element by element as varints, without a virtual call per element.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of int32_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of int64_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const int64_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint16_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint32_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for write array of uint64_t values.
+     *
+     * @param[in] values Array to write.
+     * @param[in] count Number of elements.
+     */
+    virtual void writeArray(const uint64_t *values, uint32_t count) override;
+
+    using BasicCodec::write;
+    using BasicCodec::writeArray;
+    //@}
+
+    //! @name Decoding
+    //@{
+    /*!
+     * @brief Prototype for read header of message.
+     *
+     * @param[out] type Type of message.
+     * @param[out] service Which interface was used.
+     * @param[out] request Which function was called.
+     * @param[out] sequence Returned sequence number to be sure that
+     *                     received message is reply for current request.
+     */
+    virtual void startReadMessage(message_type_t *type, uint32_t *service, Hash *request,
+                                  uint32_t *sequence) override;
+
+    /*!
+     * @brief Prototype for read int16_t value.
+     *
+     * @param[in] value int16_t typed value to read.
+     */
+    virtual void read(int16_t *value) override;
+
+    /*!
+     * @brief Prototype for read int32_t value.
+     *
+     * @param[in] value int32_t typed value to read.
+     */
+    virtual void read(int32_t *value) override;
+
+    /*!
+     * @brief Prototype for read int64_t value.
+     *
+     * @param[in] value int64_t typed value to read.
+     */
+    virtual void read(int64_t *value) override;
+
+    /*!
+     * @brief Prototype for read uint16_t value.
+     *
+     * @param[in] value uint16_t typed value to read.
+     */
+    virtual void read(uint16_t *value) override;
+
+    /*!
+     * @brief Prototype for read uint32_t value.
+     *
+     * @param[in] value uint32_t typed value to read.
+     */
+    virtual void read(uint32_t *value) override;
+
+    /*!
+     * @brief Prototype for read uint64_t value.
+     *
+     * @param[in] value uint64_t typed value to read.
+     */
+    virtual void read(uint64_t *value) override;
+
+    /*!
+     * @brief Prototype for read array of int16_t values.
+     *
+     * Element by element as varints, without a virtual call per element.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of int32_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of int64_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(int64_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint16_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint16_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint32_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint32_t *values, uint32_t count) override;
+
+    /*!
+     * @brief Prototype for read array of uint64_t values.
+     *
+     * @param[out] values Array to fill.
+     * @param[in] count Number of elements.
+     */
+    virtual void readArray(uint64_t *values, uint32_t count) override;
+
+    using BasicCodec::read;
+    using BasicCodec::readArray;
+    //@}
+
+protected:
+    /*!
+     * @brief Read zigzag encoded LEB128 varint.
+     *
+     * @param[out] value Decoded value.
+     * @param[in] minValue Smallest value the destination type can hold.
+     * @param[in] maxValue Largest value the destination type can hold.
+     */
+    void readSignedVarint(int64_t *value, int64_t minValue, int64_t maxValue);
+};
+
+/*!
+ * @brief Compact codec factory implements functions from codec factory.
+ *
+ * @ingroup infra_codec
+ */
+class CompactCodecFactory : public CodecFactory
+{
+public:
+    /*!
+     * @brief Return created codec.
+     *
+     * @return Pointer to created codec.
+     */
+    virtual Codec *create() override;
+    virtual Codec *create(Transport *transport) override;
+
+    /*!
+     * @brief Dispose codec.
+     *
+     * @param[in] codec Codec to dispose.
+     */
+    virtual void dispose(Codec *codec) override;
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__COMPACT_SERIALIZATION_H_
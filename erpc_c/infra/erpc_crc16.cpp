@@ -27,9 +27,14 @@ Crc16::Crc16(void)
 
 Crc16::~Crc16(void) {}
 
-uint16_t Crc16::computeCRC16(const uint8_t *data, uint32_t lengthInBytes)
+uint16_t Crc16::computeCRC16(const uint8_t *data, uint32_t lengthInBytes) const
 {
-    uint32_t crc = m_crcStart;
+    return updateCRC16(static_cast<uint16_t>(m_crcStart), data, lengthInBytes);
+}
+
+uint16_t Crc16::updateCRC16(uint16_t crcIn, const uint8_t *data, uint32_t lengthInBytes) const
+{
+    uint32_t crc = crcIn;
     uint32_t j;
     uint32_t i;
     uint32_t byte;
@@ -9,6 +9,8 @@
 #ifndef _EMBEDDED_RPC__CRC16_H_
 #define _EMBEDDED_RPC__CRC16_H_
 
+#include "erpc_integrity.h"
+
 #include <stdint.h>
 
 /*!
@@ -25,8 +27,10 @@ namespace erpc {
 
 /*!
  * @brief Class for compute crc16.
+ *
+ * Default integrity check of framed transports.
  */
-class Crc16
+class Crc16 : public IntegrityCheck
 {
 public:
     /*!
@@ -44,7 +48,7 @@ public:
     /*!
      * @brief Crc16 destructor
      */
-    ~Crc16(void);
+    virtual ~Crc16(void);
 
     /*!
      * @brief Compute a ITU-CCITT CRC-16 over the provided data.
@@ -54,7 +58,19 @@ public:
      * @param[in] data Pointer to data used for crc16.
      * @param[in] lengthInBytes Data length.
      */
-    uint16_t computeCRC16(const uint8_t *data, uint32_t lengthInBytes);
+    uint16_t computeCRC16(const uint8_t *data, uint32_t lengthInBytes) const;
+
+    /*!
+     * @brief Continue a CRC-16 over more data.
+     *
+     * Start with getStart(), the result over all chunks equals computeCRC16() over the
+     * concatenated data.
+     *
+     * @param[in] crc CRC of the preceding data.
+     * @param[in] data Pointer to data used for crc16.
+     * @param[in] lengthInBytes Data length.
+     */
+    uint16_t updateCRC16(uint16_t crc, const uint8_t *data, uint32_t lengthInBytes) const;
 
     /*!
      * @brief Set crc start number.
@@ -63,6 +79,14 @@ public:
      */
     void setCrcStart(uint32_t crcStart);
 
+    virtual uint8_t getId(void) const override { return kIntegrityCrc16; }
+    virtual uint8_t getSize(void) const override { return 2; }
+    virtual uint32_t getStart(void) const override { return static_cast<uint16_t>(m_crcStart); }
+    virtual uint32_t update(uint32_t value, const uint8_t *data, uint32_t lengthInBytes) const override
+    {
+        return updateCRC16(static_cast<uint16_t>(value), data, lengthInBytes);
+    }
+
 protected:
     uint32_t m_crcStart; /*!< CRC start number. */
 };
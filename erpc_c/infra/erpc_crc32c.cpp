@@ -0,0 +1,171 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc32c.h"
+
+#include <cstring>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define ERPC_CRC32C_SSE42 (1)
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+/* Not built for SSE4.2, use the instruction when the CPU has it. */
+#define ERPC_CRC32C_SSE42 (1)
+#define ERPC_CRC32C_RUNTIME_CHECK (1)
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define ERPC_CRC32C_ARM (1)
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t updateSoftware(uint32_t crc, const uint8_t *data, uint32_t lengthInBytes)
+{
+    // Reflected polynomial 0x82F63B78, one nibble per lookup.
+    static const uint32_t s_table[16] = { 0x00000000U, 0x105EC76FU, 0x20BD8EDEU, 0x30E349B1U,
+                                          0x417B1DBCU, 0x5125DAD3U, 0x61C69362U, 0x7198540DU,
+                                          0x82F63B78U, 0x92A8FC17U, 0xA24BB5A6U, 0xB21572C9U,
+                                          0xC38D26C4U, 0xD3D3E1ABU, 0xE330A81AU, 0xF36E6F75U };
+
+    for (uint32_t i = 0; i < lengthInBytes; ++i)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ s_table[crc & 0x0FU];
+        crc = (crc >> 4) ^ s_table[crc & 0x0FU];
+    }
+
+    return crc;
+}
+
+#if ERPC_CRC32C_SSE42
+#if ERPC_CRC32C_RUNTIME_CHECK
+__attribute__((target("sse4.2")))
+#endif
+static uint32_t updateSse42(uint32_t crc, const uint8_t *data, uint32_t lengthInBytes)
+{
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (lengthInBytes >= 8U)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        lengthInBytes -= 8U;
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    while (lengthInBytes >= 4U)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        lengthInBytes -= 4U;
+    }
+    while (lengthInBytes > 0U)
+    {
+        crc = _mm_crc32_u8(crc, *data++);
+        --lengthInBytes;
+    }
+
+    return crc;
+}
+#endif
+
+#if ERPC_CRC32C_ARM
+static uint32_t updateArm(uint32_t crc, const uint8_t *data, uint32_t lengthInBytes)
+{
+    while (lengthInBytes >= 4U)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32cw(crc, word);
+        data += 4;
+        lengthInBytes -= 4U;
+    }
+    while (lengthInBytes > 0U)
+    {
+        crc = __crc32cb(crc, *data++);
+        --lengthInBytes;
+    }
+
+    return crc;
+}
+#endif
+
+uint32_t Crc32c::update(uint32_t value, const uint8_t *data, uint32_t lengthInBytes) const
+{
+#if ERPC_CRC32C_SSE42
+    if (isAvailable(kImplementationSse42))
+    {
+        return updateSse42(value, data, lengthInBytes);
+    }
+#endif
+#if ERPC_CRC32C_ARM
+    return updateArm(value, data, lengthInBytes);
+#endif
+
+    return updateSoftware(value, data, lengthInBytes);
+}
+
+bool Crc32c::isAvailable(implementation_t implementation)
+{
+    bool available = false;
+
+    switch (implementation)
+    {
+        case kImplementationTable:
+            available = true;
+            break;
+#if ERPC_CRC32C_SSE42
+        case kImplementationSse42:
+        {
+#if ERPC_CRC32C_RUNTIME_CHECK
+            static const bool s_hasSse42 = __builtin_cpu_supports("sse4.2");
+            available = s_hasSse42;
+#else
+            available = true;
+#endif
+            break;
+        }
+#endif
+#if ERPC_CRC32C_ARM
+        case kImplementationArm:
+            available = true;
+            break;
+#endif
+        default:
+            break;
+    }
+
+    return available;
+}
+
+uint32_t Crc32c::updateWith(implementation_t implementation, uint32_t value, const uint8_t *data,
+                            uint32_t lengthInBytes)
+{
+    switch (implementation)
+    {
+#if ERPC_CRC32C_SSE42
+        case kImplementationSse42:
+            return updateSse42(value, data, lengthInBytes);
+#endif
+#if ERPC_CRC32C_ARM
+        case kImplementationArm:
+            return updateArm(value, data, lengthInBytes);
+#endif
+        default:
+            return updateSoftware(value, data, lengthInBytes);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__CRC32C_H_
+#define _EMBEDDED_RPC__CRC32C_H_
+
+#include "erpc_integrity.h"
+
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_transport
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Class for compute CRC-32C (Castagnoli).
+ *
+ * Detects more errors than CRC-16 on large frames. On x86 CPUs with SSE4.2 and on ARMv8
+ * with the CRC extension the CRC32 instruction is used, which is much faster than the
+ * table-less CRC-16. Otherwise a small nibble table implementation is used.
+ */
+class Crc32c : public IntegrityCheck
+{
+public:
+    /*!
+     * @brief Implementations of the update step.
+     */
+    enum implementation_t
+    {
+        kImplementationTable, /*!< Nibble table, always available. */
+        kImplementationSse42, /*!< x86 SSE4.2 CRC32 instruction. */
+        kImplementationArm,   /*!< ARMv8 CRC extension. */
+    };
+
+    /*!
+     * @brief Constructor.
+     */
+    Crc32c(void) {}
+
+    /*!
+     * @brief Crc32c destructor
+     */
+    virtual ~Crc32c(void) {}
+
+    virtual uint8_t getId(void) const override { return kIntegrityCrc32c; }
+    virtual uint8_t getSize(void) const override { return 4; }
+    virtual uint32_t getStart(void) const override { return 0xFFFFFFFFU; }
+    virtual uint32_t update(uint32_t value, const uint8_t *data, uint32_t lengthInBytes) const override;
+    virtual uint32_t finish(uint32_t value) const override { return ~value; }
+
+    /*!
+     * @brief Check whether an implementation is built in and supported by this CPU.
+     *
+     * @param[in] implementation Implementation to check.
+     *
+     * @return True when updateWith() can use it.
+     */
+    static bool isAvailable(implementation_t implementation);
+
+    /*!
+     * @brief Update the CRC with the given implementation instead of the fastest one.
+     *
+     * Lets tests and benchmarks cover every code path. The implementation must be available.
+     *
+     * @param[in] implementation Implementation to use.
+     * @param[in] value Running CRC.
+     * @param[in] data Data to add.
+     * @param[in] lengthInBytes Length of @a data.
+     *
+     * @return Updated running CRC.
+     */
+    static uint32_t updateWith(implementation_t implementation, uint32_t value, const uint8_t *data,
+                               uint32_t lengthInBytes);
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__CRC32C_H_
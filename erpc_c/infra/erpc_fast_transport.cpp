@@ -66,7 +66,11 @@ erpc_status_t FastTransport::receive(const Hash& channel, MessageBuffer *message
     }
     else{
     }
-    
+
+#if ERPC_TRANSPORT_STATS
+    m_stats.countReceive(channel, (ret == kErpcStatus_Success) ? message->getUsed() : 0U, ret);
+#endif
+
     return ret;
 }
 
@@ -78,6 +82,9 @@ erpc_status_t FastTransport::send(const Hash& channel, MessageBuffer *message)
 
     /// message data should not exceed our fast frame
     if(messageLength > sizeof(FastFrame)){
+#if ERPC_TRANSPORT_STATS
+        m_stats.countSend(channel, messageLength, kErpcStatus_BufferOverrun);
+#endif
         return kErpcStatus_BufferOverrun;
     }
 
@@ -110,7 +117,11 @@ erpc_status_t FastTransport::send(const Hash& channel, MessageBuffer *message)
     else{
         ret = kErpcStatus_Pending;
     }
-  
+
+#if ERPC_TRANSPORT_STATS
+    m_stats.countSend(channel, messageLength, ret);
+#endif
+
     return ret;
 }
 
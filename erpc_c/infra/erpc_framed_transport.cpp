@@ -9,6 +9,7 @@
  */
 
 #include "erpc_framed_transport.h"
+#include "erpc_codec.h"
 #include "erpc_message_buffer.h"
 
 #include <cassert>
@@ -29,78 +30,140 @@ FramedTransport::FramedTransport(void)
 , m_sendLock()
 , m_receiveLock()
 #endif
+#if ERPC_COBS_FRAMING
+, m_framing(kFramingLengthHeader)
+#endif
+, m_receiveChunkSize(0)
 {
 }
 
 FramedTransport::~FramedTransport(void) {}
 
-void FramedTransport::setCrc16(Crc16 *crcImpl)
+erpc_status_t FramedTransport::setIntegrityCheck(IntegrityCheck *check)
 {
-    assert(crcImpl);
-    m_crcImpl = crcImpl;
+    assert(check);
+    assert((check->getSize() <= sizeof(uint32_t)) && "Check value does not fit the frame.");
+
+#if ERPC_HEADER_VERSION == 1U
+    /// the legacy header would truncate a wider value and cannot tell the peer which check it is
+    bool headerFraming = true;
+#if ERPC_COBS_FRAMING
+    headerFraming = (m_framing != kFramingCobs);
+#endif
+    if (headerFraming && (check->getSize() > sizeof(uint16_t)))
+    {
+        return kErpcStatus_InvalidArgument;
+    }
+#endif
+
+    m_crcImpl = check;
+    return kErpcStatus_Success;
+}
+
+void FramedTransport::codecCreationCallback(Codec *codec)
+{
+    codec->setIntegrityCheck(m_crcImpl);
 }
 
 erpc_status_t FramedTransport::receive(const Hash& channel, MessageBuffer *message)
 {
-    assert(m_crcImpl && "Uninitialized Crc16 object.");
+    erpc_status_t ret = receiveFrame(channel, message);
+
+#if ERPC_TRANSPORT_STATS
+    m_stats.countReceive(channel, (ret == kErpcStatus_Success) ? message->getUsed() : 0U, ret);
+#endif
+
+    return ret;
+}
+
+erpc_status_t FramedTransport::send(const Hash& channel, MessageBuffer *message)
+{
+    erpc_status_t ret = sendFrame(channel, message);
+
+#if ERPC_TRANSPORT_STATS
+    m_stats.countSend(channel, message->getUsed(), ret);
+#endif
+
+    return ret;
+}
+
+erpc_status_t FramedTransport::receiveFrame(const Hash& channel, MessageBuffer *message)
+{
+    assert(m_crcImpl && "Uninitialized integrity check object.");
 
     erpc_status_t ret = kErpcStatus_Fail;
 
+#if ERPC_COBS_FRAMING
+    if (m_framing == kFramingCobs)
+    {
+        return receiveCobs(channel, message);
+    }
+#endif
+
     if(!headerReceived_)
     {
         // Receive header first.
-        ret = underlyingReceive(channel, (uint8_t *)&headerBuffer_, sizeof(headerBuffer_));
+        ret = underlyingReceive(channel, headerBuffer_, headerSize());
 
         if (ret == kErpcStatus_Success)
         {
-            /// evaluate redundant message sizes
-            uint16_t realMessageSize = 0;
-            if(headerBuffer_.m_messageSize == headerBuffer_.m_messageSize2){ // a == b
-                realMessageSize = headerBuffer_.m_messageSize;
-            }
-            else if(headerBuffer_.m_messageSize == headerBuffer_.m_messageSize3){ // a == c
-                realMessageSize = headerBuffer_.m_messageSize;
-            }
-            else if(headerBuffer_.m_messageSize2 == headerBuffer_.m_messageSize3){ // b == c
-                realMessageSize = headerBuffer_.m_messageSize2;
-            }
-            else{
-                /// todo: ignore?
-            }
-            /// remember correct message size
-            headerBuffer_.m_messageSize = realMessageSize;
-
-            // received size can't be zero.
-            if (headerBuffer_.m_messageSize == 0){
+            // received size can't be corrupted or zero.
+            if (!decodeHeader(headerBuffer_, &rxMessageSize_, &rxCheck_, &rxSkipCrc_) || (rxMessageSize_ == 0U)){
                 ret = kErpcStatus_ReceiveFailed;
             }
             // received size can't be larger then buffer length.
-            else if (headerBuffer_.m_messageSize > message->getLength()){
+            else if (rxMessageSize_ > message->getLength()){
                 ret = kErpcStatus_ReceiveFailed;
             } 
     
             if (ret == kErpcStatus_Success){
                 headerReceived_ = true;
+                rxChannel_ = channel;
+                rxReceived_ = 0;
+                rxRunningCheck_ = m_crcImpl->getStart();
             }
         }
     }
 
     if (headerReceived_)
     {
-        // Receive rest of the message now we know its size.
-        ret = underlyingReceive(channel, message->get(), headerBuffer_.m_messageSize);
+        // Receive rest of the message now we know its size, chunk by chunk so that each chunk
+        // is checked right after it was copied into the buffer.
+        ret = kErpcStatus_Success;
+        while ((ret == kErpcStatus_Success) && (rxReceived_ < rxMessageSize_))
+        {
+            uint32_t chunk = rxMessageSize_ - rxReceived_;
+            if ((m_receiveChunkSize != 0U) && (chunk > m_receiveChunkSize))
+            {
+                chunk = m_receiveChunkSize;
+            }
+
+            ret = underlyingReceive(channel, &message->get()[rxReceived_], chunk);
+            if (ret == kErpcStatus_Success)
+            {
+                if (!rxSkipCrc_)
+                {
+                    rxRunningCheck_ = m_crcImpl->update(rxRunningCheck_, &message->get()[rxReceived_], chunk);
+                }
+                rxReceived_ += chunk;
+            }
+        }
 
         if (ret == kErpcStatus_Success)
         {
-            // Verify CRC.
-            uint16_t computedCrc = m_crcImpl->computeCRC16(message->get(), headerBuffer_.m_messageSize);
-            if (computedCrc != headerBuffer_.m_crc)
+            // Verify check value, unless the sender skipped it.
+            uint32_t check = rxSkipCrc_ ? rxCheck_ : m_crcImpl->finish(rxRunningCheck_);
+#if ERPC_HEADER_VERSION == 1U
+            check &= 0xFFFFU;
+#endif
+            if (check != rxCheck_)
             {
                 ret = kErpcStatus_CrcCheckFailed;
             }
             else{
                 /// and set message buffer length to used and continue with receive = succes
-                message->setUsed(headerBuffer_.m_messageSize);
+                message->setUsed(rxMessageSize_);
+                message->setSkipCrc(rxSkipCrc_);
             }
 
             /// crc ok or crc failed, reset receive flags
@@ -119,9 +182,9 @@ erpc_status_t FramedTransport::receive(const Hash& channel, MessageBuffer *messa
     return ret;
 }
 
-erpc_status_t FramedTransport::send(const Hash& channel, MessageBuffer *message)
+erpc_status_t FramedTransport::sendFrame(const Hash& channel, MessageBuffer *message)
 {
-    assert(m_crcImpl && "Uninitialized Crc16 object.");
+    assert(m_crcImpl && "Uninitialized integrity check object.");
 #if !ERPC_THREADS_IS(NONE)
     Mutex::Guard lock(m_sendLock);
 #endif
@@ -129,23 +192,69 @@ erpc_status_t FramedTransport::send(const Hash& channel, MessageBuffer *message)
     erpc_status_t ret = kErpcStatus_Success;
     uint16_t messageLength = message->getUsed();
     uint8_t* bytePtr = reinterpret_cast<uint8_t*>(message->get());
+    uint32_t priority = getHashPriority(channel);
+
+    /// a started frame is never interrupted, other channels have to wait for its end
+    if (this->headerSend_ && (channel != this->sendChannel_))
+    {
+        addSendWaiter(channel);
+        return kErpcStatus_Pending;
+    }
+
+    /// between frames, let a waiting higher priority channel go first
+    if (!this->headerSend_ && ((this->waitingSendPriorities_ >> priority) > 1U))
+    {
+        addSendWaiter(channel);
+        return kErpcStatus_Pending;
+    }
+
+#if ERPC_COBS_FRAMING
+    if (m_framing == kFramingCobs)
+    {
+        if (!this->headerSend_)
+        {
+            this->headerSend_ = true;
+            this->sendChannel_ = channel;
+            removeSendWaiter(channel);
+            this->cobsTxCheck_ = m_crcImpl->getStart();
+        }
+        return sendCobs(channel, message);
+    }
+#endif
+
+#if ERPC_HEADER_VERSION != 1U
+    /// top bit of the packed size field is the skip-CRC flag
+    if (messageLength >= kPackedFrameSkipCrc)
+    {
+        removeSendWaiter(channel);
+        return kErpcStatus_BufferOverrun;
+    }
+#endif
 
     // Send header first.
     if(!this->headerSend_)
     {
-        Header h;
-        h.m_messageSize = messageLength;
-        h.m_messageSize2 = messageLength;
-        h.m_messageSize3 = messageLength;
-        h.m_crc = m_crcImpl->computeCRC16(message->get(), messageLength);
+        uint8_t h[sizeof(Header)];
+        bool skipCrc = message->getSkipCrc() && (ERPC_HEADER_VERSION != 1U);
+        uint32_t check = 0U;
+        /// the codec computed the check value while writing, unless the message was changed since
+        if (!skipCrc && !message->getCheckValue(m_crcImpl, &check))
+        {
+            check = m_crcImpl->compute(message->get(), messageLength);
+        }
+        uint32_t hSize = encodeHeader(h, messageLength, check, skipCrc);
 
         /// this should be done in one cycle, and can be repeated N times, 
         /// because it's not fragmented into multiple header packets
-        uint32_t sendBytes = underlyingSend(channel, (uint8_t *)&h, sizeof(h));
-        if(sendBytes == sizeof(h)){
+        uint32_t sendBytes = underlyingSend(channel, h, hSize);
+        if(sendBytes == hSize){
             this->headerSend_ = true;
+            this->sendChannel_ = channel;
+            removeSendWaiter(channel);
         }
         else if (sendBytes == std::numeric_limits<uint32_t>::max()) {
+            /// the sender gets the error and will not retry, stop deferring others for it
+            removeSendWaiter(channel);
             ret = kErpcStatus_SendFailed;
         }
         else{
@@ -182,3 +291,365 @@ erpc_status_t FramedTransport::send(const Hash& channel, MessageBuffer *message)
   
     return ret;
 }
+
+uint32_t FramedTransport::pendingChannels(Hash *channels, uint32_t maxChannels)
+{
+    bool inFrame = headerReceived_;
+
+#if ERPC_COBS_FRAMING
+    inFrame = inFrame || (this->cobsRxCode_ != 0U) || (this->cobsRxStagePos_ != this->cobsRxStageLen_);
+#endif
+
+    /// a partially received frame, or staged data behind it, has to be finished before another channel is read
+    if (inFrame)
+    {
+        if (maxChannels == 0U)
+        {
+            return 0;
+        }
+        channels[0] = rxChannel_;
+        return 1;
+    }
+
+    return underlyingPendingChannels(channels, maxChannels);
+}
+
+void FramedTransport::abandonSend(const Hash &channel)
+{
+#if !ERPC_THREADS_IS(NONE)
+    Mutex::Guard lock(m_sendLock);
+#endif
+
+    removeSendWaiter(channel);
+}
+
+void FramedTransport::addSendWaiter(const Hash &channel)
+{
+    uint32_t priority = getHashPriority(channel);
+
+    for (uint32_t i = 0; i < waitingSendCount_; ++i)
+    {
+        if (waitingSendChannels_[i] == channel)
+        {
+            return;
+        }
+    }
+
+    if (waitingSendCount_ < ERPC_WAITING_SENDERS_COUNT)
+    {
+        waitingSendChannels_[waitingSendCount_++] = channel;
+        ++waitingSendPerPriority_[priority];
+        waitingSendPriorities_ |= (1UL << priority);
+    }
+}
+
+void FramedTransport::removeSendWaiter(const Hash &channel)
+{
+    uint32_t priority = getHashPriority(channel);
+
+    for (uint32_t i = 0; i < waitingSendCount_; ++i)
+    {
+        if (waitingSendChannels_[i] == channel)
+        {
+            waitingSendChannels_[i] = waitingSendChannels_[--waitingSendCount_];
+            /// the level stays held back while another channel of it still waits
+            if (--waitingSendPerPriority_[priority] == 0U)
+            {
+                waitingSendPriorities_ &= ~(1UL << priority);
+            }
+            return;
+        }
+    }
+}
+
+uint32_t FramedTransport::headerSize(void) const
+{
+    return (ERPC_HEADER_VERSION == 1U) ? sizeof(Header) : (kPackedFrameHeaderSize + m_crcImpl->getSize());
+}
+
+/*!
+ * @brief Check nibble of the packed frame header over size and integrity check id.
+ */
+static inline uint8_t headerCheckNibble(uint8_t sizeLow, uint8_t sizeHigh, uint8_t id)
+{
+    uint8_t x = static_cast<uint8_t>(sizeLow ^ sizeHigh);
+
+    return static_cast<uint8_t>(~(x ^ (x >> 4) ^ id) & 0x0FU);
+}
+
+uint32_t FramedTransport::encodeHeader(uint8_t *header, uint16_t messageSize, uint32_t check, bool skipCrc) const
+{
+#if ERPC_HEADER_VERSION == 1U
+    (void)skipCrc;
+    Header h;
+    h.m_messageSize = messageSize;
+    h.m_messageSize2 = messageSize;
+    h.m_messageSize3 = messageSize;
+    h.m_crc = static_cast<uint16_t>(check);
+    memcpy(header, &h, sizeof(h));
+#else
+    uint8_t id = m_crcImpl->getId();
+
+    if (skipCrc)
+    {
+        messageSize |= kPackedFrameSkipCrc;
+    }
+    header[0] = static_cast<uint8_t>(messageSize);
+    header[1] = static_cast<uint8_t>(messageSize >> 8);
+    header[2] = static_cast<uint8_t>((id << 4) | headerCheckNibble(header[0], header[1], id));
+    for (uint8_t i = 0; i < m_crcImpl->getSize(); ++i)
+    {
+        header[kPackedFrameHeaderSize + i] = static_cast<uint8_t>(check >> (8U * i));
+    }
+#endif
+
+    return headerSize();
+}
+
+bool FramedTransport::decodeHeader(const uint8_t *header, uint16_t *messageSize, uint32_t *check, bool *skipCrc) const
+{
+#if ERPC_HEADER_VERSION == 1U
+    Header h;
+    memcpy(&h, header, sizeof(h));
+
+    /// evaluate redundant message sizes
+    if((h.m_messageSize == h.m_messageSize2) || (h.m_messageSize == h.m_messageSize3)){ // a == b or a == c
+        *messageSize = h.m_messageSize;
+    }
+    else if(h.m_messageSize2 == h.m_messageSize3){ // b == c
+        *messageSize = h.m_messageSize2;
+    }
+    else{
+        return false;
+    }
+    *check = h.m_crc;
+    *skipCrc = false;
+#else
+    uint8_t id = m_crcImpl->getId();
+
+    /// a frame with another integrity check can't be verified
+    if (header[2] != static_cast<uint8_t>((id << 4) | headerCheckNibble(header[0], header[1], id)))
+    {
+        return false;
+    }
+    *messageSize = static_cast<uint16_t>(header[0] | (header[1] << 8));
+    *skipCrc = ((*messageSize & kPackedFrameSkipCrc) != 0U);
+    *messageSize &= static_cast<uint16_t>(~kPackedFrameSkipCrc);
+    *check = 0;
+    for (uint8_t i = 0; i < m_crcImpl->getSize(); ++i)
+    {
+        *check |= static_cast<uint32_t>(header[kPackedFrameHeaderSize + i]) << (8U * i);
+    }
+#endif
+
+    return true;
+}
+
+#if ERPC_COBS_FRAMING
+erpc_status_t FramedTransport::sendCobs(const Hash &channel, MessageBuffer *message)
+{
+    for (;;)
+    {
+        if (this->cobsTxBlockSent_ == this->cobsTxBlockLen_)
+        {
+            if (this->cobsTxDone_)
+            {
+                break;
+            }
+            fillCobsBlock(message);
+        }
+
+        uint32_t sendBytes = underlyingSend(channel, &this->cobsTxBlock_[this->cobsTxBlockSent_],
+                                            this->cobsTxBlockLen_ - this->cobsTxBlockSent_);
+        if (sendBytes == std::numeric_limits<uint32_t>::max())
+        {
+            this->cobsTxDone_ = true;
+            break;
+        }
+
+        this->cobsTxBlockSent_ += sendBytes;
+        if (this->cobsTxBlockSent_ < this->cobsTxBlockLen_)
+        {
+            return kErpcStatus_Pending;
+        }
+    }
+
+    erpc_status_t ret = (this->cobsTxBlockSent_ == this->cobsTxBlockLen_) ? kErpcStatus_Success : kErpcStatus_SendFailed;
+
+    this->headerSend_ = false;
+    this->cobsTxPos_ = 0;
+    this->cobsTxBlockLen_ = 0;
+    this->cobsTxBlockSent_ = 0;
+    this->cobsTxDone_ = false;
+
+    return ret;
+}
+
+void FramedTransport::fillCobsBlock(MessageBuffer *message)
+{
+    const uint8_t *data = message->get();
+    uint32_t messageLength = message->getUsed();
+    uint32_t total = messageLength + m_crcImpl->getSize();
+    uint16_t length = 0;
+    bool zeroEnded = false;
+
+    // Scan, copy and checksum in one pass, the check value follows the message.
+    while ((this->cobsTxPos_ < total) && (length < 254U))
+    {
+        uint8_t byte;
+        if (this->cobsTxPos_ < messageLength)
+        {
+            byte = data[this->cobsTxPos_];
+            this->cobsTxCheck_ = m_crcImpl->update(this->cobsTxCheck_, &byte, 1);
+        }
+        else
+        {
+            byte = static_cast<uint8_t>(m_crcImpl->finish(this->cobsTxCheck_) >> (8U * (this->cobsTxPos_ - messageLength)));
+        }
+        ++this->cobsTxPos_;
+
+        if (byte == 0U)
+        {
+            zeroEnded = true;
+            break;
+        }
+        this->cobsTxBlock_[1U + length++] = byte;
+    }
+
+    this->cobsTxBlock_[0] = (length == 254U) ? 0xFFU : static_cast<uint8_t>(length + 1U);
+    this->cobsTxBlockLen_ = length + 1U;
+    this->cobsTxBlockSent_ = 0;
+
+    // A block ended by a zero needs a following block, even an empty one, to carry it.
+    if ((this->cobsTxPos_ == total) && !zeroEnded)
+    {
+        this->cobsTxBlock_[this->cobsTxBlockLen_++] = 0;
+        this->cobsTxDone_ = true;
+    }
+}
+
+erpc_status_t FramedTransport::receiveCobs(const Hash &channel, MessageBuffer *message)
+{
+    erpc_status_t ret;
+    uint8_t byte;
+
+    for (;;)
+    {
+        if (this->cobsRxStagePos_ == this->cobsRxStageLen_)
+        {
+            uint32_t received = 0;
+
+            ret = underlyingReceiveSome(channel, this->cobsRxStage_, sizeof(this->cobsRxStage_), &received);
+            if (ret != kErpcStatus_Success)
+            {
+                if (ret != kErpcStatus_Pending)
+                {
+                    resetCobsReceive();
+                }
+                break;
+            }
+            this->cobsRxStagePos_ = 0;
+            this->cobsRxStageLen_ = static_cast<uint8_t>(received);
+        }
+        byte = this->cobsRxStage_[this->cobsRxStagePos_++];
+
+        if (byte == 0U)
+        {
+            if ((this->cobsRxCode_ == 0U) && !this->cobsRxDiscard_)
+            {
+                // Delimiter without frame, e.g. at link start.
+                continue;
+            }
+
+            uint32_t check = 0;
+            ret = kErpcStatus_Success;
+            for (uint8_t i = 0; i < this->cobsRxTailCount_; ++i)
+            {
+                check |= static_cast<uint32_t>(this->cobsRxTail_[i]) << (8U * i);
+            }
+
+            if (this->cobsRxDiscard_ || (this->cobsRxRemaining_ != 0U) ||
+                (this->cobsRxTailCount_ < m_crcImpl->getSize()) || (this->cobsRxLen_ == 0U))
+            {
+                ret = kErpcStatus_ReceiveFailed;
+            }
+            else if (check != m_crcImpl->finish(this->cobsRxCheck_))
+            {
+                ret = kErpcStatus_CrcCheckFailed;
+            }
+            else
+            {
+                message->setUsed(this->cobsRxLen_);
+                message->setSkipCrc(false);
+            }
+
+            resetCobsReceive();
+            break;
+        }
+
+        if (this->cobsRxDiscard_)
+        {
+            continue;
+        }
+
+        if (this->cobsRxRemaining_ == 0U)
+        {
+            // Block boundary, every block but a full one is followed by a zero.
+            if (this->cobsRxCode_ == 0U)
+            {
+                this->cobsRxCheck_ = m_crcImpl->getStart();
+                this->rxChannel_ = channel;
+            }
+            else if (this->cobsRxCode_ != 0xFFU)
+            {
+                pushCobsByte(message, 0);
+            }
+            this->cobsRxCode_ = byte;
+            this->cobsRxRemaining_ = byte - 1U;
+        }
+        else
+        {
+            pushCobsByte(message, byte);
+            --this->cobsRxRemaining_;
+        }
+    }
+
+    return ret;
+}
+
+void FramedTransport::pushCobsByte(MessageBuffer *message, uint8_t data)
+{
+    uint8_t tailSize = m_crcImpl->getSize();
+
+    if (this->cobsRxTailCount_ < tailSize)
+    {
+        this->cobsRxTail_[this->cobsRxTailCount_++] = data;
+    }
+    else if (this->cobsRxLen_ >= message->getLength())
+    {
+        // Too long for the buffer, drop the frame and resynchronize on the next delimiter.
+        this->cobsRxDiscard_ = true;
+    }
+    else
+    {
+        uint8_t out = data;
+        if (tailSize > 0U)
+        {
+            out = this->cobsRxTail_[0];
+            memmove(&this->cobsRxTail_[0], &this->cobsRxTail_[1], tailSize - 1U);
+            this->cobsRxTail_[tailSize - 1U] = data;
+        }
+        message->get()[this->cobsRxLen_++] = out;
+        this->cobsRxCheck_ = m_crcImpl->update(this->cobsRxCheck_, &out, 1);
+    }
+}
+
+void FramedTransport::resetCobsReceive(void)
+{
+    this->cobsRxLen_ = 0;
+    this->cobsRxCode_ = 0;
+    this->cobsRxRemaining_ = 0;
+    this->cobsRxTailCount_ = 0;
+    this->cobsRxDiscard_ = false;
+}
+#endif
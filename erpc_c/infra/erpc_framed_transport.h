@@ -44,6 +44,23 @@ struct Header
     uint16_t m_crc;         //!< CRC-16 over the message data.
 };
 
+/*!
+ * @brief Size of the packed frame header without the integrity check value.
+ *
+ * Little-endian u16 message size, then a byte with the IntegrityCheck id in the high nibble
+ * and a check nibble over size and id in the low nibble, so a corrupted size is rejected
+ * before the receiver waits for the wrong amount of data. The check value follows,
+ * IntegrityCheck::getSize() bytes little-endian. The top bit of the size is
+ * #kPackedFrameSkipCrc.
+ */
+static const uint8_t kPackedFrameHeaderSize = 3;
+
+/*! @brief Size field flag of the packed frame header: no CRC was computed for the message. */
+static const uint16_t kPackedFrameSkipCrc = 0x8000U;
+
+/*! @brief Receive chunk size of byte stream transports, small enough to stay in L1 cache. */
+static const uint16_t kStreamReceiveChunkSize = 2048U;
+
 /*!
  * @brief Base class for framed transport layers.
  *
@@ -54,19 +71,66 @@ struct Header
  *
  * Frames have a maximum size of 64kB, as a 16-bit frame size is used.
  *
- * @note This implementation currently assumes both sides of the communications channel
- *  are the same endianness.
+ * With ERPC_HEADER_VERSION 2 the frame header is packed little-endian
+ * (#kPackedFrameHeaderSize bytes plus the check value, 5 bytes with CRC-16) and frames are
+ * limited to 32kB. Version 1 sends the legacy Header struct with the size three times in host
+ * byte order.
+ *
+ * Sends are scheduled by the priority encoded in the channel hash (@priority annotation).
+ * A frame that has started is always finished first. While it is in flight, other channels
+ * get #kErpcStatus_Pending and are recorded as waiting. Between frames, a channel may only
+ * start when no higher-priority channel is waiting, so urgent messages pre-empt bulk
+ * transfers at frame boundaries. A channel stops waiting when its send fails or its sender
+ * gives up the message (abandonSend()), so it cannot hold lower priorities back forever. Waiting
+ * channels are counted per priority, a level is released when the last of its channels stops
+ * waiting.
+ *
+ * On the receive side pendingChannels() reports the channels for which the link has data, as
+ * told by underlyingPendingChannels(), and only the channel of a partially received frame
+ * while that frame is incomplete or received COBS data is still staged. Servers use it to
+ * serve the most urgent channel first.
  *
- * The frame header includes a CRC-16 over the data for integrity checking. This class
- * includes a default CRC-16 implementation that is optimized for code size, but is
- * relatively slow. If a faster implementation is desired, you can pass the new CRC
- * function to setCRCFunction().
+ * With ERPC_COBS_FRAMING enabled, setFraming(kFramingCobs) replaces the length header by
+ * COBS encoding: the message and its check value are byte-stuffed so that they contain no zero
+ * byte, and a zero byte ends each frame. After a corrupted or dropped byte only the damaged
+ * frame is lost, the receiver starts over at the next delimiter. Encoding and the CRC are
+ * done in one pass over the message, overhead is one byte per 254 bytes plus CRC and
+ * delimiter. COBS frames have no length, they are received in chunks of whatever the link
+ * has (underlyingReceiveSome()) into a staging buffer and decoded from there. It suits serial
+ * links rather than TCP. Both sides have to use the same framing.
+ *
+ * The check value of sent messages is computed by the codec while it writes the message
+ * (see codecCreationCallback()), messages changed after encoding are checked again here.
+ * Received data is checked right after it was received, in chunks of setReceiveChunkSize()
+ * on byte stream transports, so the data is still in cache.
+ *
+ * Messages marked with MessageBuffer::setSkipCrc() (functions with the skipCrcCheck
+ * attribute) are sent with the #kPackedFrameSkipCrc flag and no CRC, and the receiver
+ * skips the check and marks the received message the same way. The legacy header and COBS
+ * frames have no room for the flag, they always carry the CRC.
+ *
+ * The frame header includes an integrity check value over the data, selected per transport
+ * by setIntegrityCheck(): CRC-16 (the default set up by erpc_client_init() and
+ * erpc_server_init(), small but slow), CRC-32C (hardware accelerated where available,
+ * stronger on large frames) or none for reliable links. The packed header carries the id of
+ * the check, frames with another one are rejected with #kErpcStatus_ReceiveFailed. The
+ * legacy header has a 16-bit field and no id, it takes CRC-16 or none only. COBS frames carry
+ * the whole check value but no id, both sides have to select the same check.
  *
  * @ingroup infra_transport
  */
 class FramedTransport : public Transport
 {
 public:
+    /*!
+     * @brief Framing of messages on the byte stream.
+     */
+    enum framing_t
+    {
+        kFramingLengthHeader, /*!< Frame header with message size and CRC. */
+        kFramingCobs,         /*!< COBS encoded message and CRC, zero byte delimited. */
+    };
+
     /*!
      * @brief Constructor.
      */
@@ -80,8 +144,8 @@ public:
     /*!
      * @brief Receives an entire message.
      *
-     * The frame header and message data are received. The CRC-16 in the frame header is
-     * compared with the computed CRC. If the received CRC is invalid, #kErpcStatus_Fail
+     * The frame header and message data are received. The check value in the frame header
+     * is compared with the computed one. If it differs, #kErpcStatus_CrcCheckFailed
      * will be returned.
      *
      * The @a message is only filled with the message data, not the frame header.
@@ -102,19 +166,77 @@ public:
      * @param[in] message Pass message buffer to send.
      *
      * @retval kErpcStatus_Success When sending was successful.
+     * @retval kErpcStatus_Pending When the frame is not completely sent yet, or another frame
+     *  owns the transport, or a higher-priority channel waits to send.
+     * @retval kErpcStatus_BufferOverrun When the message is too long for the packed frame header.
      * @retval other Subclass may return other errors from the underlyingSend() method.
      */
     virtual erpc_status_t send(const Hash& channel, MessageBuffer *message) override;
 
     /*!
-     * @brief This functions sets the CRC-16 implementation.
+     * @brief Collect channels with a message waiting.
+     *
+     * @param[out] channels Array to be filled with pending channel hashes.
+     * @param[in] maxChannels Capacity of @a channels.
+     *
+     * @return Number of channels written into @a channels.
+     */
+    virtual uint32_t pendingChannels(Hash *channels, uint32_t maxChannels) override;
+
+    /*!
+     * @brief Stop holding lower priorities back for a message which will not be sent.
+     *
+     * A frame of the channel which is already being sent is still finished by the next send().
+     *
+     * @param[in] channel Channel of the abandoned message.
+     */
+    virtual void abandonSend(const Hash &channel) override;
+
+    /*!
+     * @brief This functions sets the integrity check computed over each frame.
+     *
+     * Call before the first message is sent or received. The legacy header (ERPC_HEADER_VERSION 1)
+     * has a 16-bit check field and no check id, so it takes only CRC-16 or none, unless COBS
+     * framing was selected before.
+     *
+     * @param[in] check Integrity check object.
+     *
+     * @retval kErpcStatus_Success The check is used.
+     * @retval kErpcStatus_InvalidArgument A check wider than 16 bits with the legacy header.
+     */
+    virtual erpc_status_t setIntegrityCheck(IntegrityCheck *check) override;
+
+    /*!
+     * @brief Attach the integrity check to new codecs, they compute the check value while writing.
      *
-     * @param[in] crcImpl Object containing crc-16 compute function.
+     * @param[in] codec Newly created codec.
      */
-    virtual void setCrc16(Crc16 *crcImpl) override;
+    virtual void codecCreationCallback(Codec *codec) override;
+
+    /*!
+     * @brief Receive message data in chunks and check each chunk right after it was received.
+     *
+     * Only for byte stream transports, where underlyingReceive() may split the data sent by
+     * one underlyingSend() call. Packet based transports (SPI, I2C) receive the message in one
+     * call.
+     *
+     * @param[in] chunkSize Chunk size in bytes, 0 to receive the message at once.
+     */
+    void setReceiveChunkSize(uint16_t chunkSize) { m_receiveChunkSize = chunkSize; }
+
+#if ERPC_COBS_FRAMING
+    /*!
+     * @brief Select framing of messages.
+     *
+     * Call before the first message is sent or received.
+     *
+     * @param[in] framing Framing used in both directions.
+     */
+    void setFraming(framing_t framing) { m_framing = framing; }
+#endif
 
 protected:
-    Crc16 *m_crcImpl; /*!< CRC object. */
+    IntegrityCheck *m_crcImpl; /*!< Integrity check object. */
 
 #if !ERPC_THREADS_IS(NONE)
     Mutex m_sendLock;    //!< Mutex protecting send.
@@ -143,11 +265,201 @@ protected:
      */
     virtual erpc_status_t underlyingReceive(const erpc::Hash& channel, uint8_t *data, uint32_t size) = 0;
 
+    /*!
+     * @brief Collect channels for which the link has received data.
+     *
+     * Links which carry several channels side by side (e.g. CAN identifiers) override it, the
+     * default reports the single channel returned by hasMessage().
+     *
+     * @param[out] channels Array to be filled with pending channel hashes.
+     * @param[in] maxChannels Capacity of @a channels.
+     *
+     * @return Number of channels written into @a channels.
+     */
+    virtual uint32_t underlyingPendingChannels(Hash *channels, uint32_t maxChannels)
+    {
+        return Transport::pendingChannels(channels, maxChannels);
+    }
+
+#if ERPC_COBS_FRAMING
+    /*!
+     * @brief Receive at least one and at most @a size bytes.
+     *
+     * Used by COBS framing, which does not know the frame length in advance. Byte stream
+     * transports override it to return the data the link already has in one call, the default
+     * receives a single byte with underlyingReceive().
+     *
+     * @param[inout] data Preallocated buffer for receiving data.
+     * @param[in] size Capacity of @a data.
+     * @param[out] received Count of bytes received, at least one on success.
+     *
+     * @retval kErpcStatus_Success When data was read successfully.
+     * @retval other Error of the link, as from underlyingReceive().
+     */
+    virtual erpc_status_t underlyingReceiveSome(const erpc::Hash &channel, uint8_t *data, uint32_t size,
+                                                uint32_t *received)
+    {
+        (void)size;
+        *received = 1U;
+        return underlyingReceive(channel, data, 1U);
+    }
+#endif
+
+    /*!
+     * @brief Serialize frame header.
+     *
+     * @param[out] header Buffer of at least sizeof(Header) bytes.
+     * @param[in] messageSize Size of the message following the header.
+     * @param[in] check Integrity check value of the message.
+     * @param[in] skipCrc Message is sent without CRC.
+     *
+     * @return Size of the frame header in bytes.
+     */
+    uint32_t encodeHeader(uint8_t *header, uint16_t messageSize, uint32_t check, bool skipCrc) const;
+
+    /*!
+     * @brief Parse frame header.
+     *
+     * @param[in] header Received frame header.
+     * @param[out] messageSize Size of the message following the header.
+     * @param[out] check Integrity check value of the message.
+     * @param[out] skipCrc Message was sent without CRC.
+     *
+     * @retval true The header is consistent.
+     * @retval false The message size is corrupted or another integrity check is used.
+     */
+    bool decodeHeader(const uint8_t *header, uint16_t *messageSize, uint32_t *check, bool *skipCrc) const;
+
+    /*!
+     * @brief Receive one frame, see receive().
+     *
+     * @param[in] channel Channel to receive from.
+     * @param[in] message Message buffer, to which will be stored incoming message.
+     *
+     * @return Same as receive().
+     */
+    erpc_status_t receiveFrame(const Hash &channel, MessageBuffer *message);
+
+    /*!
+     * @brief Send one frame, see send().
+     *
+     * @param[in] channel Channel the message belongs to.
+     * @param[in] message Message to send.
+     *
+     * @return Same as send().
+     */
+    erpc_status_t sendFrame(const Hash &channel, MessageBuffer *message);
+
+    /*!
+     * @brief Return size of the frame header in bytes.
+     */
+    uint32_t headerSize(void) const;
+
+#if ERPC_COBS_FRAMING
+    /*!
+     * @brief Receive COBS frame, chunk by chunk until the delimiter.
+     *
+     * Bytes received behind the delimiter stay staged for the next frame.
+     *
+     * @param[in] channel Channel to receive from.
+     * @param[in] message Message buffer, to which will be stored incoming message.
+     *
+     * @retval kErpcStatus_Success When a frame with valid check value was received.
+     * @retval kErpcStatus_ReceiveFailed When a damaged or too long frame was dropped.
+     * @retval kErpcStatus_CrcCheckFailed When the check value did not match.
+     * @retval other Subclass may return other errors from the underlyingReceive() method.
+     */
+    erpc_status_t receiveCobs(const Hash &channel, MessageBuffer *message);
+
+    /*!
+     * @brief Send message as COBS frame.
+     *
+     * @param[in] channel Channel the message belongs to.
+     * @param[in] message Message to send.
+     *
+     * @retval kErpcStatus_Success When the frame was sent.
+     * @retval kErpcStatus_Pending When the frame is not completely sent yet.
+     * @retval kErpcStatus_SendFailed When underlyingSend() failed.
+     */
+    erpc_status_t sendCobs(const Hash &channel, MessageBuffer *message);
+
+    /*!
+     * @brief Encode next COBS block of message and check value into the send block buffer.
+     *
+     * @param[in] message Message which is sent.
+     */
+    void fillCobsBlock(MessageBuffer *message);
+
+    /*!
+     * @brief Store decoded byte, the last bytes of a frame are held back as check value.
+     *
+     * @param[in] message Message buffer which is received.
+     * @param[in] data Decoded byte.
+     */
+    void pushCobsByte(MessageBuffer *message, uint8_t data);
+
+    /*!
+     * @brief Reset COBS receive state.
+     */
+    void resetCobsReceive(void);
+
+    framing_t m_framing; /*!< Framing of messages. */
+#endif
+
+    uint16_t m_receiveChunkSize; /*!< Message data is received and checked in chunks of this size, 0 at once. */
+
 private:
-    Header headerBuffer_;
+    /*!
+     * @brief Record a channel as waiting to send, at most once.
+     *
+     * Channels beyond ERPC_WAITING_SENDERS_COUNT are not recorded, they wait without holding
+     * lower priorities back.
+     *
+     * @param[in] channel Channel which got #kErpcStatus_Pending.
+     */
+    void addSendWaiter(const Hash &channel);
+
+    /*!
+     * @brief Stop recording a channel as waiting, its priority is released with its last channel.
+     *
+     * @param[in] channel Channel which sends, failed or abandoned its message.
+     */
+    void removeSendWaiter(const Hash &channel);
+
+    uint8_t headerBuffer_[sizeof(Header)]; //!< Received frame header.
+    uint16_t rxMessageSize_ = 0;           //!< Message size of the received frame header.
+    uint32_t rxCheck_ = 0;                 //!< Check value of the received frame header.
+    bool rxSkipCrc_ = false;               //!< Received frame carries no CRC.
+    uint16_t rxReceived_ = 0;              //!< Message bytes received so far.
+    uint32_t rxRunningCheck_ = 0;          //!< Running check of the received message bytes.
     bool headerReceived_ = false;
+    Hash rxChannel_ = 0;                   //!< Channel of the frame which is being received.
     bool headerSend_ = false;
     uint32_t sentBytesInBuffer_ = 0;
+    Hash sendChannel_ = 0;                                   //!< Channel owning the frame which is being sent.
+    Hash waitingSendChannels_[ERPC_WAITING_SENDERS_COUNT];   //!< Channels deferred in favour of other frames.
+    uint32_t waitingSendCount_ = 0;                          //!< Entries of waitingSendChannels_.
+    uint8_t waitingSendPerPriority_[kHashPriorityMask + 1U] = {}; //!< Deferred channels of each priority.
+    uint32_t waitingSendPriorities_ = 0;                     //!< Bit mask of priorities with deferred channels.
+
+#if ERPC_COBS_FRAMING
+    uint8_t cobsTxBlock_[256];      //!< Code byte, up to 254 data bytes and the delimiter.
+    uint16_t cobsTxBlockLen_ = 0;   //!< Bytes in cobsTxBlock_.
+    uint16_t cobsTxBlockSent_ = 0;  //!< Bytes of cobsTxBlock_ already sent.
+    uint32_t cobsTxPos_ = 0;        //!< Encoded bytes of message and check value.
+    uint32_t cobsTxCheck_ = 0;      //!< Running check of the encoded message bytes.
+    bool cobsTxDone_ = false;       //!< Last block including the delimiter is in cobsTxBlock_.
+    uint32_t cobsRxLen_ = 0;        //!< Bytes stored into the received message.
+    uint8_t cobsRxCode_ = 0;        //!< Code byte of the current block, 0 before the first block.
+    uint8_t cobsRxRemaining_ = 0;   //!< Data bytes left in the current block.
+    uint8_t cobsRxTail_[4];         //!< Last decoded bytes, the check value at the end of the frame.
+    uint8_t cobsRxTailCount_ = 0;   //!< Valid bytes in cobsRxTail_.
+    uint32_t cobsRxCheck_ = 0;      //!< Running check of the stored bytes.
+    bool cobsRxDiscard_ = false;    //!< Frame is broken, skip until the next delimiter.
+    uint8_t cobsRxStage_[64];       //!< Received bytes which are not decoded yet.
+    uint8_t cobsRxStagePos_ = 0;    //!< Next byte of cobsRxStage_ to decode.
+    uint8_t cobsRxStageLen_ = 0;    //!< Valid bytes in cobsRxStage_.
+#endif
 };
 
 } // namespace erpc
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__INTEGRITY_H_
+#define _EMBEDDED_RPC__INTEGRITY_H_
+
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_transport
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Interface of the integrity check computed over each frame.
+ *
+ * The check is computed incrementally: start with getStart(), feed the data in any number
+ * of chunks with update() and pass the result to finish() to get the value sent on the wire.
+ * The value is at most 32 bits, getSize() bytes are sent, least significant byte first.
+ *
+ * getId() is signalled in the frame header, so a receiver configured with another check
+ * rejects the frame instead of reporting checksum errors.
+ */
+class IntegrityCheck
+{
+public:
+    /*!
+     * @brief Wire identifiers of the integrity checks.
+     */
+    enum integrity_id_t
+    {
+        kIntegrityNone = 0,   /*!< No check. */
+        kIntegrityCrc16 = 1,  /*!< CRC-16 CCITT, see Crc16. */
+        kIntegrityCrc32c = 2, /*!< CRC-32C (Castagnoli), see Crc32c. */
+    };
+
+    /*!
+     * @brief IntegrityCheck destructor
+     */
+    virtual ~IntegrityCheck(void) {}
+
+    /*!
+     * @brief Return identifier signalled in the frame header.
+     *
+     * @return Value of integrity_id_t, at most 15.
+     */
+    virtual uint8_t getId(void) const = 0;
+
+    /*!
+     * @brief Return size of the check value on the wire.
+     *
+     * @return Size in bytes, 0 to 4.
+     */
+    virtual uint8_t getSize(void) const = 0;
+
+    /*!
+     * @brief Return running value before any data.
+     *
+     * @return Start value for update().
+     */
+    virtual uint32_t getStart(void) const = 0;
+
+    /*!
+     * @brief Continue the check over more data.
+     *
+     * @param[in] value Running value of the preceding data.
+     * @param[in] data Pointer to data.
+     * @param[in] lengthInBytes Data length.
+     *
+     * @return Running value including @a data.
+     */
+    virtual uint32_t update(uint32_t value, const uint8_t *data, uint32_t lengthInBytes) const = 0;
+
+    /*!
+     * @brief Turn running value into the check value.
+     *
+     * @param[in] value Running value over all data.
+     *
+     * @return Check value.
+     */
+    virtual uint32_t finish(uint32_t value) const { return value; }
+
+    /*!
+     * @brief Compute the check value over the provided data.
+     *
+     * @param[in] data Pointer to data.
+     * @param[in] lengthInBytes Data length.
+     *
+     * @return Check value.
+     */
+    uint32_t compute(const uint8_t *data, uint32_t lengthInBytes) const
+    {
+        return finish(update(getStart(), data, lengthInBytes));
+    }
+};
+
+/*!
+ * @brief No integrity check.
+ *
+ * For links which are reliable already, e.g. TCP on loopback. Frames carry no check value.
+ */
+class IntegrityNone : public IntegrityCheck
+{
+public:
+    virtual uint8_t getId(void) const override { return kIntegrityNone; }
+    virtual uint8_t getSize(void) const override { return 0; }
+    virtual uint32_t getStart(void) const override { return 0; }
+    virtual uint32_t update(uint32_t value, const uint8_t *data, uint32_t lengthInBytes) const override
+    {
+        (void)data;
+        (void)lengthInBytes;
+        return value;
+    }
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__INTEGRITY_H_
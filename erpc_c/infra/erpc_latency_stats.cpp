@@ -0,0 +1,167 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_latency_stats.h"
+
+#if ERPC_LATENCY_STATS
+
+#include "erpc_slot_table.h"
+
+#if !defined(ERPC_LATENCY_STATS_CLOCK)
+#include <chrono>
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+//! @brief Histograms of one method.
+struct MethodHistograms
+{
+    LatencyHistogram m_histograms[kErpcLatencyPhaseCount]; //!< Histogram per phase.
+};
+
+//! @brief Percentiles reported in erpc_latency_entry_t, in 1/1000.
+const uint32_t kPercentiles[] = { 500U, 900U, 990U, 999U };
+
+const char *const kPhaseNames[kErpcLatencyPhaseCount] = {
+    "client_create", "client_encode", "client_send",    "client_wait",
+    "client_decode", "server_queue",  "server_handler", "server_reply",
+};
+
+// Static storage is zero-initialized, every slot starts free and empty.
+SlotTable<MethodHistograms, ERPC_LATENCY_STATS_METHODS> s_methods;
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t LatencyHistogram::read(erpc_latency_entry_t *entry, bool reset)
+{
+    uint32_t counts[kBucketCount];
+    uint32_t total = 0;
+    uint32_t first = kBucketCount;
+
+    for (uint32_t bucket = 0; bucket < kBucketCount; ++bucket)
+    {
+        counts[bucket] = reset ? m_buckets[bucket].exchange(0U, std::memory_order_relaxed) :
+                                 m_buckets[bucket].load(std::memory_order_relaxed);
+        if ((counts[bucket] != 0U) && (first == kBucketCount))
+        {
+            first = bucket;
+        }
+        total += counts[bucket];
+    }
+
+    entry->maxNs = reset ? m_max.exchange(0U, std::memory_order_relaxed) : m_max.load(std::memory_order_relaxed);
+    entry->count = total;
+    if (total == 0U)
+    {
+        return 0U;
+    }
+
+    entry->minNs = lowerBoundOf(first);
+
+    uint32_t *results[] = { &entry->p50Ns, &entry->p90Ns, &entry->p99Ns, &entry->p999Ns };
+    uint32_t percentile = 0;
+    uint32_t seen = 0;
+
+    for (uint32_t bucket = first; (bucket < kBucketCount) && (percentile < 4U); ++bucket)
+    {
+        seen += counts[bucket];
+
+        // Upper bound of the bucket, not above the largest latency seen.
+        uint32_t upper = (bucket + 1U < kBucketCount) ? (lowerBoundOf(bucket + 1U) - 1U) : UINT32_MAX;
+        if (upper > entry->maxNs)
+        {
+            upper = entry->maxNs;
+        }
+
+        while ((percentile < 4U) &&
+               (static_cast<uint64_t>(seen) * 1000U >= static_cast<uint64_t>(total) * kPercentiles[percentile]))
+        {
+            *results[percentile++] = upper;
+        }
+    }
+
+    return total;
+}
+
+void LatencyStats::record(Hash method, erpc_latency_phase_t phase, uint32_t ns)
+{
+    MethodHistograms *histograms = s_methods.find(method, true);
+
+    if (histograms != NULL)
+    {
+        histograms->m_histograms[phase].record(ns);
+    }
+}
+
+uint32_t erpc_latency_now(void)
+{
+#if defined(ERPC_LATENCY_STATS_CLOCK)
+    return ERPC_LATENCY_STATS_CLOCK();
+#else
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#endif
+}
+
+uint32_t erpc_latency_stats_snapshot(erpc_latency_entry_t *entries, uint32_t capacity, bool reset)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < ERPC_LATENCY_STATS_METHODS; ++i)
+    {
+        if (!s_methods.isReady(i))
+        {
+            continue;
+        }
+
+        for (uint32_t phase = 0; (phase < kErpcLatencyPhaseCount) && (count < capacity); ++phase)
+        {
+            erpc_latency_entry_t *entry = &entries[count];
+
+            if (s_methods.getValue(i).m_histograms[phase].read(entry, reset) != 0U)
+            {
+                entry->method = s_methods.getKey(i);
+                entry->phase = phase;
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+void erpc_latency_stats_reset(void)
+{
+    erpc_latency_entry_t entry;
+
+    for (uint32_t i = 0; i < ERPC_LATENCY_STATS_METHODS; ++i)
+    {
+        for (uint32_t phase = 0; phase < kErpcLatencyPhaseCount; ++phase)
+        {
+            (void)s_methods.getValue(i).m_histograms[phase].read(&entry, true);
+        }
+    }
+}
+
+const char *erpc_latency_phase_name(uint32_t phase)
+{
+    return (phase < kErpcLatencyPhaseCount) ? kPhaseNames[phase] : "unknown";
+}
+
+#endif // ERPC_LATENCY_STATS
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__LATENCY_STATS_H_
+#define _EMBEDDED_RPC__LATENCY_STATS_H_
+
+#include "erpc_config_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_utility
+ * @{
+ * @file
+ */
+
+#if ERPC_LATENCY_STATS
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Phases of a call with their own latency histogram.
+typedef enum erpc_latency_phase
+{
+    kErpcLatencyClientCreate = 0,  //!< Client creates the request buffer and codec.
+    kErpcLatencyClientEncode = 1,  //!< Client stub encodes the request.
+    kErpcLatencyClientSend = 2,    //!< Transport sends the request.
+    kErpcLatencyClientWait = 3,    //!< Client waits for the reply.
+    kErpcLatencyClientDecode = 4,  //!< Client stub decodes the reply.
+    kErpcLatencyServerQueue = 5,   //!< Received request waits for its handler.
+    kErpcLatencyServerHandler = 6, //!< Server decodes, runs the handler and encodes the reply.
+    kErpcLatencyServerReply = 7,   //!< Transport sends the reply.
+    kErpcLatencyPhaseCount = 8     //!< Count of phases.
+} erpc_latency_phase_t;
+
+//! @brief Latency of one method in one phase, as returned by erpc_latency_stats_snapshot().
+typedef struct erpc_latency_entry
+{
+    uint32_t method;  //!< Method hash.
+    uint32_t phase;   //!< Phase, see #erpc_latency_phase_t.
+    uint32_t count;   //!< Count of recorded calls.
+    uint32_t minNs;   //!< Lower bound of the smallest latency.
+    uint32_t p50Ns;   //!< Median.
+    uint32_t p90Ns;   //!< 90th percentile.
+    uint32_t p99Ns;   //!< 99th percentile.
+    uint32_t p999Ns;  //!< 99.9th percentile.
+    uint32_t maxNs;   //!< Largest latency.
+} erpc_latency_entry_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @brief Return current time of the latency clock.
+ *
+ * Uses ERPC_LATENCY_STATS_CLOCK() when it is defined, std::chrono::steady_clock otherwise.
+ *
+ * @return Time in nanoseconds, wraps around after 2^32 ns.
+ */
+uint32_t erpc_latency_now(void);
+
+/*!
+ * @brief Copy the latency of every method and phase with recorded calls.
+ *
+ * Percentiles are upper bounds of the histogram bucket they fall into, so they are at most
+ * 12.5 % above the real value.
+ *
+ * @param[out] entries Array the entries are written to.
+ * @param[in] capacity Count of entries the array holds.
+ * @param[in] reset Reset the histograms read, calls recorded meanwhile are not lost.
+ *
+ * @return Count of entries written.
+ */
+uint32_t erpc_latency_stats_snapshot(erpc_latency_entry_t *entries, uint32_t capacity, bool reset);
+
+/*!
+ * @brief Clear all histograms.
+ */
+void erpc_latency_stats_reset(void);
+
+/*!
+ * @brief Return name of a phase for export.
+ *
+ * @param[in] phase Phase, see #erpc_latency_phase_t.
+ *
+ * @return Name like "client_wait", "unknown" for invalid phases.
+ */
+const char *erpc_latency_phase_name(uint32_t phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+#include "erpc_common.h"
+
+#include <atomic>
+
+namespace erpc {
+
+/*!
+ * @brief Log-bucketed latency histogram.
+ *
+ * Each power of two is split into 8 linear buckets, so a bucket is at most 12.5 % wide and
+ * latencies from 1 ns to 4.29 s fit into 240 buckets. Recording is one relaxed atomic add,
+ * it needs no lock and any thread may record.
+ *
+ * @ingroup infra_utility
+ */
+class LatencyHistogram
+{
+public:
+    //! @brief Count of linear buckets per power of two, as bits.
+    static const uint32_t kSubBucketBits = 3U;
+
+    //! @brief Count of linear buckets per power of two.
+    static const uint32_t kSubBuckets = 1U << kSubBucketBits;
+
+    //! @brief Count of buckets.
+    static const uint32_t kBucketCount = (32U - kSubBucketBits + 1U) * kSubBuckets;
+
+    /*!
+     * @brief Record one latency.
+     *
+     * @param[in] ns Latency in nanoseconds.
+     */
+    void record(uint32_t ns)
+    {
+        m_buckets[bucketOf(ns)].fetch_add(1U, std::memory_order_relaxed);
+
+        uint32_t max = m_max.load(std::memory_order_relaxed);
+        while ((ns > max) && !m_max.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /*!
+     * @brief Fill percentiles of the histogram into an entry.
+     *
+     * @param[out] entry Entry to fill, method and phase are left unchanged.
+     * @param[in] reset Clear the histogram while reading it.
+     *
+     * @return Count of recorded latencies.
+     */
+    uint32_t read(erpc_latency_entry_t *entry, bool reset);
+
+    /*!
+     * @brief Return bucket of a latency.
+     *
+     * @param[in] ns Latency in nanoseconds.
+     *
+     * @return Bucket index.
+     */
+    static uint32_t bucketOf(uint32_t ns)
+    {
+        if (ns < kSubBuckets)
+        {
+            return ns;
+        }
+
+#if defined(__GNUC__)
+        uint32_t msb = 31U - static_cast<uint32_t>(__builtin_clz(ns));
+#else
+        uint32_t msb = 0U;
+        for (uint32_t value = ns >> 1U; value != 0U; value >>= 1U)
+        {
+            ++msb;
+        }
+#endif
+        uint32_t shift = msb - kSubBucketBits;
+        return ((shift + 1U) << kSubBucketBits) | ((ns >> shift) & (kSubBuckets - 1U));
+    }
+
+    /*!
+     * @brief Return the smallest latency of a bucket.
+     *
+     * @param[in] bucket Bucket index.
+     *
+     * @return Latency in nanoseconds.
+     */
+    static uint32_t lowerBoundOf(uint32_t bucket)
+    {
+        if (bucket < kSubBuckets)
+        {
+            return bucket;
+        }
+
+        uint32_t shift = (bucket >> kSubBucketBits) - 1U;
+        return (kSubBuckets | (bucket & (kSubBuckets - 1U))) << shift;
+    }
+
+protected:
+    std::atomic<uint32_t> m_buckets[kBucketCount]; //!< Count of latencies per bucket.
+    std::atomic<uint32_t> m_max;                   //!< Largest latency recorded.
+};
+
+/*!
+ * @brief Latency histograms of every phase, per method.
+ *
+ * Methods get their slot on the first recorded call, from a table of
+ * ERPC_LATENCY_STATS_METHODS slots. Calls of methods which don't fit anymore are dropped.
+ *
+ * @ingroup infra_utility
+ */
+class LatencyStats
+{
+public:
+    /*!
+     * @brief Record latency of a call in one phase.
+     *
+     * @param[in] method Method hash.
+     * @param[in] phase Phase of the call.
+     * @param[in] ns Latency in nanoseconds.
+     */
+    static void record(Hash method, erpc_latency_phase_t phase, uint32_t ns);
+
+    /*!
+     * @brief Record latency from a timestamp until now.
+     *
+     * @param[in] method Method hash.
+     * @param[in] phase Phase of the call.
+     * @param[in,out] stamp Time the phase started, set to now.
+     */
+    static void mark(Hash method, erpc_latency_phase_t phase, uint32_t &stamp)
+    {
+        uint32_t now = erpc_latency_now();
+        record(method, phase, now - stamp);
+        stamp = now;
+    }
+};
+
+} // namespace erpc
+
+#endif // __cplusplus
+
+#endif // ERPC_LATENCY_STATS
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__LATENCY_STATS_H_
@@ -53,7 +53,13 @@ erpc_status_t MessageBuffer::write(uint16_t offset, const void *data, uint32_t l
     {
         if (length > 0U)
         {
-            memcpy(m_buf, data, length);
+            memcpy(&m_buf[offset], data, length);
+
+            // Patched bytes (e.g. a batch count) are not covered by the running check anymore.
+            if (offset != m_checkLength)
+            {
+                m_checkValid = false;
+            }
         }
 
         err = kErpcStatus_Success;
@@ -68,10 +74,51 @@ erpc_status_t MessageBuffer::copy(const MessageBuffer *other)
 
     m_used = other->m_used;
     memcpy(m_buf, other->m_buf, m_used);
+    copyAttributes(other);
 
     return kErpcStatus_Success;
 }
 
+void MessageBuffer::copyAttributes(const MessageBuffer *other)
+{
+    m_skipCrc = other->m_skipCrc;
+    m_check = other->m_check;
+    m_checkValue = other->m_checkValue;
+    m_checkLength = other->m_checkLength;
+    m_checkValid = other->m_checkValid;
+}
+
+void MessageBuffer::written(const uint8_t *data, uint32_t length)
+{
+    uint32_t offset = static_cast<uint32_t>(data - m_buf);
+
+    if ((m_check != NULL) && !m_skipCrc)
+    {
+        if (offset == 0U)
+        {
+            m_checkValue = m_check->getStart();
+            m_checkLength = 0;
+            m_checkValid = true;
+        }
+
+        if (m_checkValid && (offset == m_checkLength))
+        {
+            m_checkValue = m_check->update(m_checkValue, data, length);
+            m_checkLength += length;
+        }
+        else
+        {
+            m_checkValid = false;
+        }
+    }
+    else
+    {
+        m_checkValid = false;
+    }
+
+    m_used += length;
+}
+
 void MessageBuffer::swap(MessageBuffer *other)
 {
     assert(other);
@@ -81,9 +128,11 @@ void MessageBuffer::swap(MessageBuffer *other)
     other->m_len = m_len;
     other->m_used = m_used;
     other->m_buf = m_buf;
+    other->copyAttributes(this);
     m_len = temp.m_len;
     m_used = temp.m_used;
     m_buf = temp.m_buf;
+    copyAttributes(&temp);
 }
 
 void MessageBuffer::Cursor::set(MessageBuffer *buffer)
@@ -131,9 +180,9 @@ erpc_status_t MessageBuffer::Cursor::write(const void *data, uint32_t length)
     else
     {
         memcpy(m_pos, data, length);
+        m_buffer->written(m_pos, length);
         m_pos += length;
         m_remaining -= length;
-        m_buffer->setUsed(m_buffer->getUsed() + length);
 
         err = kErpcStatus_Success;
     }
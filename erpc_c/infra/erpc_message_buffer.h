@@ -11,6 +11,7 @@
 #define _EMBEDDED_RPC__MESSAGE_BUFFER_H_
 
 #include "erpc_common.h"
+#include "erpc_integrity.h"
 
 #include <cstddef>
 #include <stdint.h>
@@ -32,6 +33,11 @@ namespace erpc {
  * The MessageBuffer object does not own the buffer memory. It simply provides an interface
  * to accessing that memory in a convenient manner.
  *
+ * With an integrity check attached, writes through a Cursor maintain a running check value
+ * while the data is written, so the transport does not have to read the message again.
+ * Writing at offset 0 starts it over. Cursor writes which do not continue at its end,
+ * write() at any other offset than its end and setUsed() drop it.
+ *
  * @ingroup infra_codec
  */
 class MessageBuffer
@@ -46,6 +52,11 @@ public:
     : m_buf(NULL)
     , m_len(0)
     , m_used(0)
+    , m_skipCrc(false)
+    , m_check(NULL)
+    , m_checkValue(0)
+    , m_checkLength(0)
+    , m_checkValid(false)
     {
     }
 
@@ -61,6 +72,11 @@ public:
     : m_buf(buffer)
     , m_len(length)
     , m_used(0)
+    , m_skipCrc(false)
+    , m_check(NULL)
+    , m_checkValue(0)
+    , m_checkLength(0)
+    , m_checkValid(false)
     {
     }
 
@@ -77,6 +93,8 @@ public:
         m_buf = buffer;
         m_len = length;
         m_used = 0;
+        m_skipCrc = false;
+        m_checkValid = false;
     }
 
     /*!
@@ -119,7 +137,67 @@ public:
      *
      * @param[in] used Length of used space of buffer.
      */
-    void setUsed(uint16_t used) { m_used = used; }
+    void setUsed(uint16_t used)
+    {
+        m_used = used;
+        m_checkValid = false;
+    }
+
+    /*!
+     * @brief This function marks the message to be framed without CRC.
+     *
+     * Set by the codec of functions marked to skip the CRC check, and by transports on
+     * received messages whose frame header carried the flag.
+     *
+     * @param[in] skip True to skip CRC computation and check.
+     */
+    void setSkipCrc(bool skip) { m_skipCrc = skip; }
+
+    /*!
+     * @brief This function returns whether the message is framed without CRC.
+     *
+     * @return True when no CRC is computed for this message.
+     */
+    bool getSkipCrc(void) const { return m_skipCrc; }
+
+    /*!
+     * @brief This function attaches the integrity check computed while writing.
+     *
+     * @param[in] check Integrity check of the transport, or NULL for none.
+     */
+    void setIntegrityCheck(IntegrityCheck *check)
+    {
+        m_check = check;
+        m_checkValid = false;
+    }
+
+    /*!
+     * @brief This function returns the check value computed while writing.
+     *
+     * @param[in] check Integrity check the caller needs.
+     * @param[out] value Check value over all used bytes.
+     *
+     * @retval true The running check of @a check covers exactly the used bytes.
+     * @retval false The value has to be computed over the data.
+     */
+    bool getCheckValue(const IntegrityCheck *check, uint32_t *value) const
+    {
+        bool valid = m_checkValid && (check != NULL) && (m_check == check) && (m_checkLength == m_used);
+
+        if (valid)
+        {
+            *value = check->finish(m_checkValue);
+        }
+
+        return valid;
+    }
+
+    /*!
+     * @brief This function copies flags and running check of a buffer holding the same data.
+     *
+     * @param[in] other MessageBuffer the data was copied from.
+     */
+    void copyAttributes(const MessageBuffer *other);
 
     /*!
      * @brief This function read data from local buffer.
@@ -355,6 +433,19 @@ private:
     uint8_t *volatile m_buf;  /*!< Buffer used to read write data. */
     uint16_t volatile m_len;  /*!< Length of buffer. */
     uint16_t volatile m_used; /*!< Used buffer bytes. */
+    bool m_skipCrc;           /*!< Message is framed without CRC. */
+    IntegrityCheck *m_check;  /*!< Integrity check computed while writing. */
+    uint32_t m_checkValue;    /*!< Running check value. */
+    uint16_t m_checkLength;   /*!< Bytes covered by m_checkValue, from offset 0. */
+    bool m_checkValid;        /*!< m_checkValue is valid. */
+
+    /*!
+     * @brief Account bytes written by a Cursor and update the running check.
+     *
+     * @param[in] data Written data, inside the buffer.
+     * @param[in] length Length of written data.
+     */
+    void written(const uint8_t *data, uint32_t length);
 };
 
 /*!
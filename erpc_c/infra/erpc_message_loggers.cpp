@@ -20,16 +20,54 @@
 using namespace erpc;
 using namespace std;
 
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+//! @brief First sleep before a busy logger is retried.
+static const uint32_t kLogRetryMinUsecs = 10U;
+
+//! @brief Longest sleep between retries of a busy logger.
+static const uint32_t kLogRetryMaxUsecs = 1000U;
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // Code
 ////////////////////////////////////////////////////////////////////////////////
 
 ERPC_MANUALLY_CONSTRUCTED_ARRAY_STATIC(MessageLogger, s_messageLoggersManual, ERPC_MESSAGE_LOGGERS_COUNT);
 
+MessageLoggers::MessageLoggers(void)
+: m_logger(NULL)
+#if ERPC_MESSAGE_LOGGING_ASYNC
+, m_logQueue()
+, m_logDropped(0)
+, m_logWriterIdle(false)
+, m_logStop(false)
+, m_logThread(&logThreadEntry, ERPC_MESSAGE_LOGGING_THREAD_PRIORITY, ERPC_MESSAGE_LOGGING_THREAD_STACK_SIZE,
+              "erpc_logger")
+, m_logWake(0)
+, m_logStopped(0)
+, m_logThreadStarted(false)
+#endif
+{
+}
+
 MessageLoggers::~MessageLoggers(void)
 {
     MessageLogger *logger;
 
+#if ERPC_MESSAGE_LOGGING_ASYNC
+    if (m_logThreadStarted)
+    {
+        // Let the thread write what is queued and wait until it is gone.
+        m_logStop.store(true);
+        m_logWake.put();
+        (void)m_logStopped.get();
+    }
+#endif
+
     while (m_logger != NULL)
     {
         logger = m_logger;
@@ -64,20 +102,42 @@ bool MessageLoggers::addMessageLogger(Transport *transport)
                 _logger->setNext(logger);
             }
             retVal = true;
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+            if (!m_logThreadStarted)
+            {
+                m_logThreadStarted = true;
+                m_logThread.start(this);
+            }
+#endif
         }
     }
 
     return retVal;
 }
 
-erpc_status_t MessageLoggers::logMessage(MessageBuffer *msg)
+erpc_status_t MessageLoggers::logMessage(const Hash &channel, MessageBuffer *msg)
 {
     erpc_status_t err = kErpcStatus_Success;
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+    if (m_logger != NULL)
+    {
+        if (!m_logQueue.fits(msg) || !m_logQueue.enqueue(channel, msg))
+        {
+            (void)m_logDropped.fetch_add(1U, std::memory_order_relaxed);
+        }
+        else if (m_logWriterIdle.exchange(false))
+        {
+            m_logWake.put();
+        }
+    }
+#else
     MessageLogger *_logger = m_logger;
 
     while (_logger != NULL)
     {
-        err = _logger->getLogger()->send(msg);
+        err = _logger->getLogger()->send(channel, msg);
         if (err == kErpcStatus_Success)
         {
             _logger = _logger->getNext();
@@ -87,10 +147,67 @@ erpc_status_t MessageLoggers::logMessage(MessageBuffer *msg)
             break;
         }
     }
+#endif
 
     return err;
 }
 
+#if ERPC_MESSAGE_LOGGING_ASYNC
+void MessageLoggers::writeLogs(void)
+{
+    Hash channel;
+    MessageBuffer *msg;
+
+    while ((msg = m_logQueue.peek(&channel)) != NULL)
+    {
+        for (MessageLogger *logger = m_logger; logger != NULL; logger = logger->getNext())
+        {
+            uint32_t backoff = kLogRetryMinUsecs;
+            erpc_status_t err;
+
+            while ((err = logger->getLogger()->send(channel, msg)) == kErpcStatus_Pending)
+            {
+                // The logger is busy, give it time instead of spinning on it.
+                Thread::sleep(backoff);
+                backoff = ((backoff * 2U) < kLogRetryMaxUsecs) ? (backoff * 2U) : kLogRetryMaxUsecs;
+            }
+
+            if (err != kErpcStatus_Success)
+            {
+                (void)m_logDropped.fetch_add(1U, std::memory_order_relaxed);
+            }
+        }
+
+        // Hand the slot back to producers.
+        m_logQueue.pop();
+    }
+}
+
+void MessageLoggers::logThreadEntry(void *arg)
+{
+    MessageLoggers *loggers = static_cast<MessageLoggers *>(arg);
+
+    for (;;)
+    {
+        loggers->writeLogs();
+        if (loggers->m_logStop.load())
+        {
+            break;
+        }
+
+        // A producer queueing right after the check sees the idle flag and wakes us.
+        loggers->m_logWriterIdle.store(true);
+        if (loggers->m_logQueue.isEmpty() && !loggers->m_logStop.load())
+        {
+            (void)loggers->m_logWake.get();
+        }
+        loggers->m_logWriterIdle.store(false);
+    }
+
+    loggers->m_logStopped.put();
+}
+#endif
+
 MessageLogger *MessageLoggers::create(Transport *transport)
 {
     ERPC_CREATE_NEW_OBJECT(MessageLogger, s_messageLoggersManual, ERPC_MESSAGE_LOGGERS_COUNT, transport)
@@ -9,7 +9,18 @@
 #ifndef _EMBEDDED_RPC__LOGEVENTLISTENERS_H_
 #define _EMBEDDED_RPC__LOGEVENTLISTENERS_H_
 
+#include "erpc_config_internal.h"
 #include "erpc_transport.h"
+#if ERPC_MESSAGE_LOGGING_ASYNC
+#include "erpc_message_queue.h"
+#include "erpc_threading.h"
+
+#include <atomic>
+
+#if ERPC_THREADS_IS(NONE)
+#error "ERPC_MESSAGE_LOGGING_ASYNC needs a threading model, the loggers are written by their own thread."
+#endif
+#endif
 
 /*!
  * @addtogroup infra_transport
@@ -72,6 +83,11 @@ protected:
 /*!
  * @brief Logging messages functionality.
  *
+ * With ERPC_MESSAGE_LOGGING_ASYNC, logMessage() only copies the message into a bounded
+ * lock-free queue of ERPC_MESSAGE_LOGGING_SLOTS messages and returns. A thread started with
+ * the first logger writes queued messages to the logger transports, so a slow logger never
+ * stalls the calls. Messages which don't fit into the queue are dropped and counted.
+ *
  * @ingroup infra_utility
  */
 class MessageLoggers
@@ -80,8 +96,7 @@ public:
     /*!
      * @brief Constructor.
      */
-    MessageLoggers(void)
-    : m_logger(NULL){};
+    MessageLoggers(void);
 
     /*!
      * @brief Transport destructor
@@ -98,17 +113,56 @@ public:
      */
     bool addMessageLogger(Transport *transport);
 
+#if ERPC_MESSAGE_LOGGING_ASYNC
+    /*!
+     * @brief Return count of messages which were not logged.
+     *
+     * Counts messages dropped because the queue was full or they didn't fit into a queue slot,
+     * and messages a logger transport failed to send.
+     *
+     * @return Count of dropped messages.
+     */
+    uint32_t getDroppedLogMessages(void) const { return m_logDropped.load(std::memory_order_relaxed); }
+#endif
+
 protected:
     MessageLogger *m_logger; /*!< Pointer to first logger. */
 
     /*!
-     * @brief This function add given transport to newly created MessageLogger object.
+     * @brief This function sends given message to all loggers.
      *
+     * @param[in] channel Channel of the message.
      * @param[in] msg Buffer which will be logged.
      *
-     * @return The eRPC status based on transport type.
+     * @return The eRPC status based on transport type, always #kErpcStatus_Success in async mode.
+     */
+    erpc_status_t logMessage(const Hash &channel, MessageBuffer *msg);
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+    /*!
+     * @brief Write queued messages to the loggers, runs in the logging thread.
+     *
+     * A logger which is busy (#kErpcStatus_Pending) is retried after a sleep which doubles up to
+     * a millisecond, so the thread does not spin on it.
+     */
+    void writeLogs(void);
+
+    /*!
+     * @brief Entry of the logging thread.
+     *
+     * @param[in] arg MessageLoggers object.
      */
-    erpc_status_t logMessage(MessageBuffer *msg);
+    static void logThreadEntry(void *arg);
+
+    MessageQueue<ERPC_MESSAGE_LOGGING_SLOTS> m_logQueue;  /*!< Queued messages, consumed by the logging thread. */
+    std::atomic<uint32_t> m_logDropped;                   /*!< Count of messages not logged. */
+    std::atomic<bool> m_logWriterIdle;                    /*!< Logging thread waits for m_logWake. */
+    std::atomic<bool> m_logStop;                          /*!< Logging thread shall exit. */
+    Thread m_logThread;                                   /*!< Thread writing the loggers. */
+    Semaphore m_logWake;                                  /*!< Wakes the idle logging thread. */
+    Semaphore m_logStopped;                               /*!< Put by the logging thread when it exits. */
+    bool m_logThreadStarted;                              /*!< Logging thread runs. */
+#endif
 
 private:
     /**
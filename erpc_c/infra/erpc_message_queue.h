@@ -0,0 +1,187 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__MESSAGE_QUEUE_H_
+#define _EMBEDDED_RPC__MESSAGE_QUEUE_H_
+
+#include "erpc_config_internal.h"
+#include "erpc_message_buffer.h"
+#include "erpc_transport.h"
+
+#include <atomic>
+#include <cstring>
+
+/*!
+ * @addtogroup infra_utility
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Bounded lock-free queue of message copies, for many producers and a single consumer.
+ *
+ * Dmitry Vyukov's bounded queue: each cell carries a sequence number which tells producers
+ * whether it is free and the consumer whether it is published. Producers claim a cell with
+ * one compare-exchange and copy the message in, the consumer writes the head message out
+ * and hands the cell back.
+ *
+ * Only one thread at a time may call peek() and pop(), the caller provides that exclusion.
+ *
+ * @tparam slotCount Count of queued messages, must be a power of two.
+ *
+ * @ingroup infra_utility
+ */
+template <uint32_t slotCount>
+class MessageQueue
+{
+    static_assert((slotCount != 0U) && ((slotCount & (slotCount - 1U)) == 0U), "slotCount must be a power of two.");
+
+public:
+    /*!
+     * @brief Constructor.
+     */
+    MessageQueue(void)
+    : m_enqueuePos(0)
+    , m_dequeuePos(0)
+    {
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+            m_slots[i].m_channel = 0;
+            m_slots[i].m_buffer.set(m_slots[i].m_data, sizeof(m_slots[i].m_data));
+        }
+    }
+
+    /*!
+     * @brief Check whether a message fits into a queue cell.
+     *
+     * @param[in] message Message to check.
+     *
+     * @retval true enqueue() can take the message.
+     * @retval false The message is larger than ERPC_DEFAULT_BUFFER_SIZE.
+     */
+    static bool fits(const MessageBuffer *message) { return message->getUsed() <= ERPC_DEFAULT_BUFFER_SIZE; }
+
+    /*!
+     * @brief Claim a cell and copy the message into it, with its flags and running check.
+     *
+     * @param[in] channel Channel the message belongs to.
+     * @param[in] message Message to copy, it has to fit().
+     *
+     * @retval true The message was queued.
+     * @retval false The queue is full.
+     */
+    bool enqueue(const Hash &channel, MessageBuffer *message)
+    {
+        Slot *slot;
+        uint32_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            slot = &m_slots[pos & kSlotMask];
+            int32_t diff = (int32_t)(slot->m_sequence.load(std::memory_order_acquire) - pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->m_channel = channel;
+        std::memcpy(slot->m_data, message->get(), message->getUsed());
+        slot->m_buffer.setUsed(message->getUsed());
+        slot->m_buffer.copyAttributes(message);
+
+        // Publish the message to the consumer.
+        slot->m_sequence.store(pos + 1U, std::memory_order_release);
+
+        return true;
+    }
+
+    /*!
+     * @brief Check whether the head cell holds a published message.
+     *
+     * @retval true Nothing to consume.
+     * @retval false A message is waiting.
+     */
+    bool isEmpty(void) const
+    {
+        uint32_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        return m_slots[pos & kSlotMask].m_sequence.load(std::memory_order_acquire) != (pos + 1U);
+    }
+
+    /*!
+     * @brief Return the head message without removing it, consumer only.
+     *
+     * @param[out] channel Channel of the message.
+     *
+     * @return Head message, NULL when the queue is empty. Valid until pop().
+     */
+    MessageBuffer *peek(Hash *channel)
+    {
+        if (isEmpty())
+        {
+            return NULL;
+        }
+
+        Slot *slot = &m_slots[m_dequeuePos.load(std::memory_order_relaxed) & kSlotMask];
+        *channel = slot->m_channel;
+        return &slot->m_buffer;
+    }
+
+    /*!
+     * @brief Remove the head message returned by peek() and hand its cell back to producers.
+     */
+    void pop(void)
+    {
+        uint32_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        m_slots[pos & kSlotMask].m_sequence.store(pos + slotCount, std::memory_order_release);
+        m_dequeuePos.store(pos + 1U, std::memory_order_relaxed);
+    }
+
+protected:
+    /*!
+     * @brief Queue cell holding a copy of one message.
+     */
+    struct Slot
+    {
+        std::atomic<uint32_t> m_sequence;         //!< Vyukov sequence number of the cell.
+        Hash m_channel;                           //!< Channel the message belongs to.
+        MessageBuffer m_buffer;                   //!< View over m_data with used length of the message.
+        uint8_t m_data[ERPC_DEFAULT_BUFFER_SIZE]; //!< Message data.
+    };
+
+    static const uint32_t kSlotMask = slotCount - 1U; /*!< Cell index of a position. */
+
+    Slot m_slots[slotCount];            /*!< Queue storage. */
+    std::atomic<uint32_t> m_enqueuePos; /*!< Next position producers claim. */
+    std::atomic<uint32_t> m_dequeuePos; /*!< Next position the consumer takes, written by the consumer only. */
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__MESSAGE_QUEUE_H_
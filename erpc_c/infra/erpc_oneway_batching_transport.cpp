@@ -0,0 +1,257 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_oneway_batching_transport.h"
+
+#include <cassert>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//! Size of the length prefix BasicCodec writes in front of each sub-message.
+static const uint16_t kSubMessageOverhead = sizeof(uint32_t);
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+OnewayBatchingTransport::OnewayBatchingTransport(Transport *transport)
+: Transport()
+, m_transport(transport)
+, m_batchBuffer(m_batchData, sizeof(m_batchData))
+, m_batchCodec()
+, m_count(0)
+, m_countOffset(0)
+, m_firstOffset(0)
+, m_firstLength(0)
+, m_channel(0)
+, m_flushing(false)
+, m_threshold(sizeof(m_batchData))
+, m_budget(0)
+, m_clock(NULL)
+, m_batchStart(0)
+#if !ERPC_THREADS_IS(NONE)
+, m_lock()
+#endif
+{
+    assert(m_transport);
+}
+
+OnewayBatchingTransport::~OnewayBatchingTransport(void) {}
+
+void OnewayBatchingTransport::setFlushThreshold(uint16_t threshold)
+{
+    m_threshold = (threshold < sizeof(m_batchData)) ? threshold : sizeof(m_batchData);
+}
+
+void OnewayBatchingTransport::setTimeBudget(uint32_t budget, clock_fn_t clock)
+{
+    m_budget = budget;
+    m_clock = clock;
+}
+
+erpc_status_t OnewayBatchingTransport::receive(const Hash &channel, MessageBuffer *message)
+{
+    checkTimeBudget();
+    return m_transport->receive(channel, message);
+}
+
+erpc_status_t OnewayBatchingTransport::send(const Hash &channel, MessageBuffer *message)
+{
+#if !ERPC_THREADS_IS(NONE)
+    Mutex::Guard lock(m_lock);
+#endif
+
+    erpc_status_t err = kErpcStatus_Success;
+
+    // Finish a batch whose write already started before anything else.
+    if (m_flushing)
+    {
+        err = flushBatch();
+        if (err != kErpcStatus_Success)
+        {
+            return err;
+        }
+    }
+
+    if (isBatchable(message))
+    {
+        // A batch goes out on one channel with its priority, so it never mixes channels.
+        uint32_t needed = kSubMessageOverhead + message->getUsed();
+        if ((m_count != 0) && ((channel != m_channel) || (m_batchCodec.getBuffer()->getFree() < needed)))
+        {
+            err = flushBatch();
+            if (err != kErpcStatus_Success)
+            {
+                return err;
+            }
+        }
+
+        append(channel, message);
+
+        if (m_batchCodec.getBuffer()->getUsed() >= m_threshold)
+        {
+            err = flushBatch();
+            if (err == kErpcStatus_Pending)
+            {
+                // Message is accepted, the rest of the batch goes out with the next call.
+                err = kErpcStatus_Success;
+            }
+        }
+    }
+    else
+    {
+        // Keep ordering, queued oneway messages go out first.
+        err = flushBatch();
+        if (err == kErpcStatus_Success)
+        {
+            err = m_transport->send(channel, message);
+        }
+    }
+
+    return err;
+}
+
+Hash OnewayBatchingTransport::hasMessage(void)
+{
+    checkTimeBudget();
+    return m_transport->hasMessage();
+}
+
+uint32_t OnewayBatchingTransport::pendingChannels(Hash *channels, uint32_t maxChannels)
+{
+    return m_transport->pendingChannels(channels, maxChannels);
+}
+
+void OnewayBatchingTransport::abandonSend(const Hash &channel)
+{
+    m_transport->abandonSend(channel);
+}
+
+erpc_status_t OnewayBatchingTransport::setIntegrityCheck(IntegrityCheck *check)
+{
+    return m_transport->setIntegrityCheck(check);
+}
+
+void OnewayBatchingTransport::flush(void)
+{
+    {
+#if !ERPC_THREADS_IS(NONE)
+        Mutex::Guard lock(m_lock);
+#endif
+        (void)flushBatch();
+    }
+
+    m_transport->flush();
+}
+
+void OnewayBatchingTransport::codecCreationCallback(Codec *codec)
+{
+    m_transport->codecCreationCallback(codec);
+}
+
+bool OnewayBatchingTransport::isBatchable(MessageBuffer *message)
+{
+    message_type_t type;
+    uint32_t service;
+    Hash request;
+    uint32_t sequence;
+    BasicCodec codec;
+    MessageBuffer view(message->get(), message->getUsed());
+
+    // The batch envelope is BasicCodec encoded, messages of other codecs (CompactCodec) are sent unbatched.
+    if ((message->getUsed() == 0U) || ((message->get()[0] != BasicCodec::kBasicCodecVersion) &&
+                                       (message->get()[0] != BasicCodec::kBasicCodecLegacyVersion)))
+    {
+        return false;
+    }
+
+    if ((message->getUsed() + kSubMessageOverhead + sizeof(PayloadHeader) + sizeof(m_count)) > sizeof(m_batchData))
+    {
+        return false;
+    }
+
+    codec.setBuffer(view);
+    codec.startReadMessage(&type, &service, &request, &sequence);
+
+    return (codec.isStatusOk() && (type == kOnewayMessage));
+}
+
+void OnewayBatchingTransport::append(const Hash &channel, MessageBuffer *message)
+{
+    MessageBuffer *batch = m_batchCodec.getBuffer();
+
+    if (m_count == 0)
+    {
+        m_batchBuffer.set(m_batchData, sizeof(m_batchData));
+        m_batchCodec.setBuffer(m_batchBuffer);
+        m_batchCodec.startWriteMessage(kOnewayBatchMessage, 0, 0, 0);
+        m_countOffset = batch->getUsed();
+        m_batchCodec.write(m_count);
+        m_firstOffset = batch->getUsed() + kSubMessageOverhead;
+        m_firstLength = message->getUsed();
+        m_channel = channel;
+        if (m_clock != NULL)
+        {
+            m_batchStart = m_clock();
+        }
+    }
+
+    m_batchCodec.writeBinary(message->getUsed(), message->get());
+    ++m_count;
+    (void)batch->write(m_countOffset, &m_count, sizeof(m_count));
+}
+
+erpc_status_t OnewayBatchingTransport::flushBatch(void)
+{
+    erpc_status_t err;
+
+    if (m_count == 0)
+    {
+        return kErpcStatus_Success;
+    }
+
+    m_flushing = true;
+
+    if (m_count == 1)
+    {
+        // No need for the batch envelope around a single message.
+        MessageBuffer single(&m_batchData[m_firstOffset], m_firstLength);
+        single.setUsed(m_firstLength);
+        err = m_transport->send(m_channel, &single);
+    }
+    else
+    {
+        err = m_transport->send(m_channel, m_batchCodec.getBuffer());
+    }
+
+    if (err != kErpcStatus_Pending)
+    {
+        m_count = 0;
+        m_flushing = false;
+    }
+
+    return err;
+}
+
+void OnewayBatchingTransport::checkTimeBudget(void)
+{
+    if ((m_clock != NULL) && (m_count != 0))
+    {
+#if !ERPC_THREADS_IS(NONE)
+        Mutex::Guard lock(m_lock);
+#endif
+        if ((m_count != 0) && ((m_clock() - m_batchStart) >= m_budget))
+        {
+            (void)flushBatch();
+        }
+    }
+}
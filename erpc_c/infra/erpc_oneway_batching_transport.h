@@ -0,0 +1,213 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__ONEWAY_BATCHING_TRANSPORT_H_
+#define _EMBEDDED_RPC__ONEWAY_BATCHING_TRANSPORT_H_
+
+#include "erpc_basic_codec.h"
+#include "erpc_config_internal.h"
+#include "erpc_transport.h"
+#if !ERPC_THREADS_IS(NONE)
+#include "erpc_threading.h"
+#endif
+
+/*!
+ * @addtogroup infra_transport
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Transport wrapper which coalesces oneway messages into a single frame.
+ *
+ * Oneway messages (#kOnewayMessage) are not sent immediately but appended to a batch
+ * message (#kOnewayBatchMessage). The batch holds a uint16 count followed by the
+ * sub-messages encoded as binaries, so one frame header, one CRC pass and one write
+ * cover the whole batch. The server unpacks and dispatches the sub-messages in order.
+ *
+ * The batch is written out when:
+ *  - its size reaches the flush threshold,
+ *  - the time budget since the first queued message elapsed (checked on every call),
+ *  - flush() is called,
+ *  - a oneway message of another channel is queued, a batch is sent on the channel
+ *    (and with the priority) of its messages,
+ *  - any other message is sent, so ordering between messages is kept.
+ *
+ * A batch with a single message is sent as that plain message. Only BasicCodec messages
+ * are batched, messages of other codecs (CompactCodec) are sent unbatched. Transports which switch
+ * codecs into fast mode (FastTransport) should not be wrapped, fast messages carry
+ * no message type to batch on.
+ *
+ * @ingroup infra_transport
+ */
+class OnewayBatchingTransport : public Transport
+{
+public:
+    /*!
+     * @brief Returns current time in arbitrary ticks, used for the time budget.
+     */
+    typedef uint32_t (*clock_fn_t)(void);
+
+    /*!
+     * @brief Constructor.
+     *
+     * @param[in] transport Transport which sends the batches.
+     */
+    OnewayBatchingTransport(Transport *transport);
+
+    /*!
+     * @brief OnewayBatchingTransport destructor
+     */
+    virtual ~OnewayBatchingTransport(void);
+
+    /*!
+     * @brief Flushes an expired batch and receives from the wrapped transport.
+     *
+     * @param[in] channel Channel to receive from.
+     * @param[in] message Message buffer, to which will be stored incoming message.
+     *
+     * @return Status of the wrapped transport receive.
+     */
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override;
+
+    /*!
+     * @brief Appends a oneway message to the batch, sends any other message directly.
+     *
+     * @param[in] channel Channel the message belongs to.
+     * @param[in] message Message buffer to send.
+     *
+     * @retval kErpcStatus_Success When the message was queued or sent.
+     * @retval kErpcStatus_Pending When the batch or the message is still being written.
+     * @retval other Error of the wrapped transport.
+     */
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override;
+
+    /*!
+     * @brief Flushes an expired batch and forwards to the wrapped transport.
+     *
+     * @return Channel with a pending message, 0 if none.
+     */
+    virtual Hash hasMessage(void) override;
+
+    /*!
+     * @brief Forwards to the wrapped transport.
+     *
+     * @param[out] channels Array to be filled with pending channel hashes.
+     * @param[in] maxChannels Capacity of @a channels.
+     *
+     * @return Number of channels written into @a channels.
+     */
+    virtual uint32_t pendingChannels(Hash *channels, uint32_t maxChannels) override;
+
+    /*!
+     * @brief Forwards to the wrapped transport.
+     *
+     * @param[in] channel Channel of the abandoned message.
+     */
+    virtual void abandonSend(const Hash &channel) override;
+
+    /*!
+     * @brief This functions sets the integrity check of the wrapped transport.
+     *
+     * @param[in] check Integrity check object.
+     *
+     * @return Status of the wrapped transport, see Transport::setIntegrityCheck().
+     */
+    virtual erpc_status_t setIntegrityCheck(IntegrityCheck *check) override;
+
+    /*!
+     * @brief Writes out the batch and flushes the wrapped transport.
+     */
+    virtual void flush(void) override;
+
+    /*!
+     * @brief Forwards to the wrapped transport.
+     *
+     * @param[in] codec Newly created codec.
+     */
+    virtual void codecCreationCallback(Codec *codec) override;
+
+    /*!
+     * @brief Set batch size in bytes at which the batch is written out.
+     *
+     * @param[in] threshold Size threshold, capped to the batch buffer size.
+     */
+    void setFlushThreshold(uint16_t threshold);
+
+    /*!
+     * @brief Set how long a batch may wait before it is written out.
+     *
+     * @param[in] budget Time budget in ticks of @a clock.
+     * @param[in] clock Time source, NULL disables the time budget.
+     */
+    void setTimeBudget(uint32_t budget, clock_fn_t clock);
+
+protected:
+    /*!
+     * @brief Check whether the message is a oneway message which may be batched.
+     *
+     * @param[in] message Message to check.
+     *
+     * @return True when the message can be appended to a batch.
+     */
+    bool isBatchable(MessageBuffer *message);
+
+    /*!
+     * @brief Append message to the batch.
+     *
+     * @param[in] channel Channel the message belongs to.
+     * @param[in] message Message to append.
+     */
+    void append(const Hash &channel, MessageBuffer *message);
+
+    /*!
+     * @brief Write out the batch if it holds any message.
+     *
+     * @retval kErpcStatus_Success Nothing to send or the batch was sent.
+     * @retval kErpcStatus_Pending The batch is partially sent, call again.
+     * @retval other Error of the wrapped transport, the batch is dropped.
+     */
+    erpc_status_t flushBatch(void);
+
+    /*!
+     * @brief Write out the batch when its time budget elapsed.
+     */
+    void checkTimeBudget(void);
+
+    Transport *m_transport; /*!< Wrapped transport. */
+
+    uint8_t m_batchData[ERPC_DEFAULT_BUFFER_SIZE]; /*!< Batch message storage. */
+    MessageBuffer m_batchBuffer;                   /*!< Buffer over m_batchData. */
+    BasicCodec m_batchCodec;                       /*!< Codec encoding the batch. */
+    uint16_t m_count;                              /*!< Count of messages in the batch. */
+    uint16_t m_countOffset;                        /*!< Offset of the count field in the batch. */
+    uint16_t m_firstOffset;                        /*!< Offset of the first message data in the batch. */
+    uint16_t m_firstLength;                        /*!< Length of the first message in the batch. */
+    Hash m_channel;                                /*!< Channel of all messages in the batch. */
+    bool m_flushing;                               /*!< Batch write started but not finished. */
+    uint16_t m_threshold;                          /*!< Size at which the batch is written out. */
+    uint32_t m_budget;                             /*!< Time budget of a batch. */
+    clock_fn_t m_clock;                            /*!< Time source for the time budget. */
+    uint32_t m_batchStart;                         /*!< Time of the first message in the batch. */
+
+#if !ERPC_THREADS_IS(NONE)
+    Mutex m_lock; //!< Mutex protecting the batch.
+#endif
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__ONEWAY_BATCHING_TRANSPORT_H_
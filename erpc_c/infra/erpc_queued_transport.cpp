@@ -0,0 +1,194 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_queued_transport.h"
+
+#include <cassert>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+static_assert((ERPC_QUEUED_TRANSPORT_SLOTS_COUNT & (ERPC_QUEUED_TRANSPORT_SLOTS_COUNT - 1U)) == 0U,
+              "ERPC_QUEUED_TRANSPORT_SLOTS_COUNT must be a power of two.");
+
+static const uint32_t kSlotMask = ERPC_QUEUED_TRANSPORT_SLOTS_COUNT - 1U;
+
+//! @brief Marks a used error record, so that errors of channel 0 can be kept too.
+static const uint64_t kErrorUsed = 0x80000000U;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+QueuedTransport::QueuedTransport(Transport *transport)
+: Transport()
+, m_transport(transport)
+, m_queue()
+, m_writerActive(false)
+, m_failedFrames(0)
+{
+    assert(m_transport);
+
+    for (uint32_t i = 0; i < ERPC_QUEUED_TRANSPORT_SLOTS_COUNT; ++i)
+    {
+        m_errors[i].store(0U, std::memory_order_relaxed);
+    }
+}
+
+QueuedTransport::~QueuedTransport(void) {}
+
+erpc_status_t QueuedTransport::receive(const Hash &channel, MessageBuffer *message)
+{
+    (void)drain();
+
+    erpc_status_t err = takeError(channel);
+    if (err != kErpcStatus_Success)
+    {
+        return err;
+    }
+
+    return m_transport->receive(channel, message);
+}
+
+erpc_status_t QueuedTransport::send(const Hash &channel, MessageBuffer *message)
+{
+    if (!m_queue.fits(message))
+    {
+        return kErpcStatus_BufferOverrun;
+    }
+
+    if (!m_queue.enqueue(channel, message))
+    {
+        // Queue full: help the writer and try once more before asking the caller to come back.
+        (void)drain();
+        if (!m_queue.enqueue(channel, message))
+        {
+            return kErpcStatus_Pending;
+        }
+    }
+
+    (void)drain();
+
+    return takeError(channel);
+}
+
+Hash QueuedTransport::hasMessage(void)
+{
+    return m_transport->hasMessage();
+}
+
+uint32_t QueuedTransport::pendingChannels(Hash *channels, uint32_t maxChannels)
+{
+    return m_transport->pendingChannels(channels, maxChannels);
+}
+
+void QueuedTransport::abandonSend(const Hash &channel)
+{
+    (void)takeError(channel);
+    m_transport->abandonSend(channel);
+}
+
+erpc_status_t QueuedTransport::setIntegrityCheck(IntegrityCheck *check)
+{
+    return m_transport->setIntegrityCheck(check);
+}
+
+void QueuedTransport::flush(void)
+{
+    (void)drain();
+    m_transport->flush();
+}
+
+void QueuedTransport::codecCreationCallback(Codec *codec)
+{
+    m_transport->codecCreationCallback(codec);
+}
+
+bool QueuedTransport::drain(void)
+{
+    bool drained;
+
+    do
+    {
+        bool expected = false;
+        if (!m_writerActive.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            // Another thread is the combiner, it will write our frame too.
+            return false;
+        }
+
+        Hash channel;
+        MessageBuffer *frame;
+
+        drained = true;
+        while ((frame = m_queue.peek(&channel)) != NULL)
+        {
+            erpc_status_t err = m_transport->send(channel, frame);
+            if (err == kErpcStatus_Pending)
+            {
+                // Keep the frame at the head, the next combiner resumes it.
+                drained = false;
+                break;
+            }
+
+            if (err != kErpcStatus_Success)
+            {
+                keepError(channel, err);
+            }
+
+            // Hand the slot back to producers.
+            m_queue.pop();
+        }
+
+        m_writerActive.store(false, std::memory_order_release);
+
+        // A producer may have queued a frame after our last check and lost the writer flag to us.
+    } while (drained && !m_queue.isEmpty());
+
+    return drained;
+}
+
+void QueuedTransport::keepError(const Hash &channel, erpc_status_t err)
+{
+    uint64_t record = (static_cast<uint64_t>(channel) << 32) | kErrorUsed | static_cast<uint32_t>(err);
+
+    m_failedFrames.fetch_add(1U, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < ERPC_QUEUED_TRANSPORT_SLOTS_COUNT; ++i)
+    {
+        std::atomic<uint64_t> &entry = m_errors[(channel + i) & kSlotMask];
+        uint64_t expected = 0U;
+
+        if (entry.compare_exchange_strong(expected, record, std::memory_order_release, std::memory_order_relaxed) ||
+            ((expected >> 32) == channel))
+        {
+            // Kept, or the channel has an error already which its caller did not take yet.
+            return;
+        }
+    }
+}
+
+erpc_status_t QueuedTransport::takeError(const Hash &channel)
+{
+    for (uint32_t i = 0; i < ERPC_QUEUED_TRANSPORT_SLOTS_COUNT; ++i)
+    {
+        std::atomic<uint64_t> &entry = m_errors[(channel + i) & kSlotMask];
+        uint64_t record = entry.load(std::memory_order_acquire);
+
+        if ((record != 0U) && ((record >> 32) == channel) &&
+            entry.compare_exchange_strong(record, 0U, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return static_cast<erpc_status_t>(record & ~kErrorUsed & 0xFFFFFFFFU);
+        }
+    }
+
+    return kErpcStatus_Success;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__QUEUED_TRANSPORT_H_
+#define _EMBEDDED_RPC__QUEUED_TRANSPORT_H_
+
+#include "erpc_config_internal.h"
+#include "erpc_message_queue.h"
+#include "erpc_transport.h"
+
+#include <atomic>
+
+/*!
+ * @addtogroup infra_transport
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Transport wrapper which queues outgoing frames for a single writer.
+ *
+ * Senders copy their frame into a bounded lock-free multi-producer queue and return
+ * immediately. Whichever caller wins the writer flag becomes the combiner: it drains the
+ * queue into the wrapped transport on behalf of all producers, so no thread has to come
+ * back to finish its own partially written frame and nobody blocks on the send mutex.
+ *
+ * A frame which the wrapped transport accepts only partially (#kErpcStatus_Pending) stays
+ * at the head of the queue and is resumed by the next combiner, so frames are written in
+ * enqueue order. A frame which the wrapped transport rejects was already reported as queued to
+ * its sender, so the error is kept for the channel of the frame. The next send() or receive()
+ * on that channel returns it: a client waiting for the reply of the lost request gets the
+ * error instead of waiting forever, other channels are not affected. Every failed frame is
+ * counted by getFailedFrames().
+ *
+ * Receiving is forwarded to the wrapped transport after draining the queue, so a client
+ * waiting for a reply keeps pushing its own request out.
+ *
+ * @ingroup infra_transport
+ */
+class QueuedTransport : public Transport
+{
+public:
+    /*!
+     * @brief Constructor.
+     *
+     * @param[in] transport Transport which is written by the combining writer.
+     */
+    QueuedTransport(Transport *transport);
+
+    /*!
+     * @brief QueuedTransport destructor
+     */
+    virtual ~QueuedTransport(void);
+
+    /*!
+     * @brief Drains the send queue and receives a message from the wrapped transport.
+     *
+     * @param[in] channel Channel to receive from.
+     * @param[in] message Message buffer, to which will be stored incoming message.
+     *
+     * @return Status of the wrapped transport receive.
+     */
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override;
+
+    /*!
+     * @brief Copies the message into the send queue and tries to drain it.
+     *
+     * @param[in] channel Channel the message belongs to.
+     * @param[in] message Message buffer to send.
+     *
+     * @retval kErpcStatus_Success When the frame was queued.
+     * @retval kErpcStatus_Pending When the queue is full, try again later.
+     * @retval kErpcStatus_BufferOverrun When the frame does not fit into a queue slot.
+     * @retval other Error of an earlier frame of the same channel reported by the wrapped transport.
+     */
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override;
+
+    /*!
+     * @brief Forwards to the wrapped transport.
+     *
+     * @return Channel with a pending message, 0 if none.
+     */
+    virtual Hash hasMessage(void) override;
+
+    /*!
+     * @brief Forwards to the wrapped transport.
+     *
+     * @param[out] channels Array to be filled with pending channel hashes.
+     * @param[in] maxChannels Capacity of @a channels.
+     *
+     * @return Number of channels written into @a channels.
+     */
+    virtual uint32_t pendingChannels(Hash *channels, uint32_t maxChannels) override;
+
+    /*!
+     * @brief Drops the kept error of the channel and forwards to the wrapped transport.
+     *
+     * @param[in] channel Channel of the abandoned message.
+     */
+    virtual void abandonSend(const Hash &channel) override;
+
+    /*!
+     * @brief This functions sets the integrity check of the wrapped transport.
+     *
+     * @param[in] check Integrity check object.
+     *
+     * @return Status of the wrapped transport, see Transport::setIntegrityCheck().
+     */
+    virtual erpc_status_t setIntegrityCheck(IntegrityCheck *check) override;
+
+    /*!
+     * @brief Writes out all queued frames and flushes the wrapped transport.
+     */
+    virtual void flush(void) override;
+
+    /*!
+     * @brief Forwards to the wrapped transport.
+     *
+     * @param[in] codec Newly created codec.
+     */
+    virtual void codecCreationCallback(Codec *codec) override;
+
+    /*!
+     * @brief Return count of queued frames which the wrapped transport rejected.
+     */
+    uint32_t getFailedFrames(void) const { return m_failedFrames.load(std::memory_order_relaxed); }
+
+protected:
+    /*!
+     * @brief Become the writer if nobody else is and write out queued frames.
+     *
+     * @retval true The queue was drained completely.
+     * @retval false Another writer is active or the wrapped transport is busy.
+     */
+    bool drain(void);
+
+    /*!
+     * @brief Keep the error of a frame for its channel.
+     *
+     * The first error of a channel is kept until it is taken. When errors of
+     * #ERPC_QUEUED_TRANSPORT_SLOTS_COUNT other channels are kept already, the error is only counted.
+     *
+     * @param[in] channel Channel of the failed frame.
+     * @param[in] err Error of the wrapped transport.
+     */
+    void keepError(const Hash &channel, erpc_status_t err);
+
+    /*!
+     * @brief Take the kept error of a channel.
+     *
+     * @param[in] channel Channel of the caller.
+     *
+     * @return Kept error, kErpcStatus_Success if none.
+     */
+    erpc_status_t takeError(const Hash &channel);
+
+    Transport *m_transport; /*!< Wrapped transport. */
+
+    MessageQueue<ERPC_QUEUED_TRANSPORT_SLOTS_COUNT> m_queue; /*!< Queued frames, consumed by the combiner. */
+    std::atomic<bool> m_writerActive;                        /*!< Combiner flag, set by the thread draining it. */
+    std::atomic<uint64_t> m_errors[ERPC_QUEUED_TRANSPORT_SLOTS_COUNT]; /*!< Kept errors, channel in the upper half. */
+    std::atomic<uint32_t> m_failedFrames;                    /*!< Count of frames the wrapped transport rejected. */
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__QUEUED_TRANSPORT_H_
@@ -9,6 +9,7 @@
  */
 
 #include "erpc_server.h"
+#include "erpc_allocation_stats.h"
 #include "assert.h"
 
 using namespace erpc;
@@ -81,6 +82,16 @@ erpc_status_t Server::processMessage(Codec *codec, message_type_t msgType, uint3
     erpc_status_t err = kErpcStatus_Success;
     Service *service;
 
+    if (msgType == kOnewayBatchMessage)
+    {
+        return processOnewayBatch(codec, sequence);
+    }
+
+    if (msgType == kBatchInvocationMessage)
+    {
+        return processBatch(codec, methodId, sequence);
+    }
+
     if ((msgType != kInvocationMessage) && (msgType != kOnewayMessage) && (msgType != kFastMessage) && (msgType != kFastOnewayMessage))
     {
         err = kErpcStatus_InvalidArgument;
@@ -97,12 +108,196 @@ erpc_status_t Server::processMessage(Codec *codec, message_type_t msgType, uint3
 
     if (err == kErpcStatus_Success)
     {
+#if ERPC_ALLOCATION_STATS
+        // Allocations of the handler, its decoded parameters and the reply are counted for the method.
+        AllocationTag allocationTag(methodId);
+#endif
         err = service->handleInvocation(methodId, sequence, codec, m_messageFactory);
     }
 
     return err;
 }
 
+erpc_status_t Server::processOnewayBatch(Codec *codec, uint32_t sequence)
+{
+    erpc_status_t err;
+    uint16_t count = 0;
+    Codec *subCodec = NULL;
+
+    codec->read(&count);
+    err = codec->getStatus();
+
+    if (err == kErpcStatus_Success)
+    {
+        subCodec = m_codecFactory->create(m_transport);
+        if (subCodec == NULL)
+        {
+            err = kErpcStatus_MemoryError;
+        }
+    }
+
+    for (uint16_t i = 0; (err == kErpcStatus_Success) && (i < count); ++i)
+    {
+        uint32_t length;
+        uint8_t *data;
+        message_type_t subType;
+        uint32_t serviceId;
+        Hash methodId;
+        uint32_t subSequence = sequence;
+
+        // Sub-message is decoded in place, it points into the received batch.
+        codec->readBinary(&length, &data);
+        err = codec->getStatus();
+        if (err != kErpcStatus_Success)
+        {
+            break;
+        }
+
+        MessageBuffer subBuffer(data, static_cast<uint16_t>(length));
+        subBuffer.setUsed(static_cast<uint16_t>(length));
+        subCodec->setBuffer(subBuffer);
+
+        err = readHeadOfMessage(subCodec, subType, serviceId, methodId, subSequence);
+        if ((err == kErpcStatus_Success) && (subType != kOnewayMessage))
+        {
+            err = kErpcStatus_InvalidArgument;
+        }
+
+        if (err == kErpcStatus_Success)
+        {
+            err = processMessage(subCodec, subType, serviceId, methodId, subSequence);
+        }
+    }
+
+    if (subCodec != NULL)
+    {
+        m_codecFactory->dispose(subCodec);
+    }
+
+    return err;
+}
+
+erpc_status_t Server::processBatch(Codec *codec, Hash methodId, uint32_t sequence)
+{
+    erpc_status_t err;
+    uint16_t count = 0;
+    uint16_t replies = 0;
+    uint16_t countOffset;
+    uint32_t batchSequence = 0;
+    Codec *subCodec = NULL;
+    Codec *replyCodec = NULL;
+    MessageBuffer scratch;
+    MessageBuffer reply;
+
+    codec->read(&count);
+    codec->read(&batchSequence);
+    err = codec->getStatus();
+
+    if (err == kErpcStatus_Success)
+    {
+        scratch = m_messageFactory->create();
+        reply = m_messageFactory->create();
+        subCodec = m_codecFactory->create(m_transport);
+        replyCodec = m_codecFactory->create(m_transport);
+        if ((scratch.get() == NULL) || (reply.get() == NULL) || (subCodec == NULL) || (replyCodec == NULL))
+        {
+            err = kErpcStatus_MemoryError;
+        }
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        replyCodec->setBuffer(reply);
+        replyCodec->startWriteMessage(kBatchReplyMessage, 0, methodId, sequence);
+        countOffset = replyCodec->getBuffer()->getUsed();
+        replyCodec->write(replies);
+        replyCodec->write(batchSequence);
+    }
+
+    for (uint16_t i = 0; (err == kErpcStatus_Success) && (i < count); ++i)
+    {
+        uint32_t length;
+        uint8_t *data;
+        message_type_t subType = kInvocationMessage;
+        uint32_t serviceId;
+        Hash subMethodId;
+        uint32_t subSequence = sequence;
+        erpc_status_t subErr;
+
+        codec->readBinary(&length, &data);
+        err = codec->getStatus();
+        if ((err == kErpcStatus_Success) && (length > scratch.getLength()))
+        {
+            err = kErpcStatus_BufferOverrun;
+        }
+        if (err != kErpcStatus_Success)
+        {
+            break;
+        }
+
+        // The reply is written over the request, so it cannot stay inside the batch.
+        (void)scratch.write(0, data, length);
+        scratch.setUsed(static_cast<uint16_t>(length));
+        subCodec->setBuffer(scratch);
+
+        subErr = readHeadOfMessage(subCodec, subType, serviceId, subMethodId, subSequence);
+        if ((subErr == kErpcStatus_Success) && (subType != kInvocationMessage) && (subType != kOnewayMessage))
+        {
+            // Only plain calls are batched, nested batches and other messages are not dispatched.
+            err = kErpcStatus_InvalidArgument;
+            break;
+        }
+        if (subErr == kErpcStatus_Success)
+        {
+            subErr = processMessage(subCodec, subType, serviceId, subMethodId, subSequence);
+        }
+
+        if (subType == kInvocationMessage)
+        {
+            if (subErr == kErpcStatus_Success)
+            {
+                replyCodec->writeBinary(subCodec->getBuffer()->getUsed(), subCodec->getBuffer()->get());
+            }
+            else
+            {
+                // Keep reply indexes aligned, the client reports the failed call on its own.
+                replyCodec->writeBinary(0, data);
+            }
+            ++replies;
+        }
+
+        err = replyCodec->getStatus();
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        (void)replyCodec->getBuffer()->write(countOffset, &replies, sizeof(replies));
+
+        // Hand the reply over to the caller's codec, the received batch gets disposed below.
+        codec->getBuffer()->swap(replyCodec->getBuffer());
+        reply = *replyCodec->getBuffer();
+    }
+
+    if (reply.get() != NULL)
+    {
+        m_messageFactory->dispose(&reply);
+    }
+    if (scratch.get() != NULL)
+    {
+        m_messageFactory->dispose(&scratch);
+    }
+    if (subCodec != NULL)
+    {
+        m_codecFactory->dispose(subCodec);
+    }
+    if (replyCodec != NULL)
+    {
+        m_codecFactory->dispose(replyCodec);
+    }
+
+    return err;
+}
+
 Service *Server::findServiceWithId(uint32_t serviceId)
 {
     Service *service = m_firstService;
@@ -177,6 +177,9 @@ protected:
     CodecFactory *m_codecFactory;           /*!< Contains CodecFactory to use. */
     erpc::Transport *m_transport;                 /*!< Transport layer used to send and receive data. */
     Service *m_firstService;                /*!< Contains pointer to first service. */
+#if ERPC_SERVER_ARENA
+    Arena m_arena; /*!< Memory for the data decoded from the request being served. */
+#endif
 
     /*!
      * @brief Process message.
@@ -192,6 +195,39 @@ protected:
     virtual erpc_status_t processMessage(Codec *codec, message_type_t msgType, uint32_t serviceId, Hash methodId,
                                          uint32_t sequence);
 
+    /*!
+     * @brief Unpack a batch of oneway messages and dispatch them in order.
+     *
+     * The batch payload is a count followed by the sub-messages encoded as binaries.
+     * Each sub-message is a complete oneway message which is decoded in place.
+     *
+     * @param[in] codec Codec positioned after the batch message header.
+     * @param[in] sequence Sequence of the batch message.
+     *
+     * @returns #kErpcStatus_Success or the first error of a sub-message.
+     */
+    virtual erpc_status_t processOnewayBatch(Codec *codec, uint32_t sequence);
+
+    /*!
+     * @brief Run a batch of invocations and replace the batch with the batched reply.
+     *
+     * Each sub-request is copied into a scratch buffer and dispatched. Replies of two-way
+     * calls are appended in order to a #kBatchReplyMessage, a call which fails gets an
+     * empty reply. The batch sequence written after the call count is echoed after the reply
+     * count, so the client tells the reply apart from one of an earlier batch. On success the
+     * codec holds the batched reply to be sent back.
+     * Needs two message buffers on top of the received one. A sub-message which is neither
+     * an invocation nor a oneway message fails the whole batch.
+     *
+     * @param[in] codec Codec positioned after the batch message header.
+     * @param[in] methodId Id from the batch header, echoed in the reply.
+     * @param[in] sequence Sequence of the batch message.
+     *
+     * @retval kErpcStatus_InvalidArgument A sub-message of another message type.
+     * @returns #kErpcStatus_Success or error of the batch itself.
+     */
+    virtual erpc_status_t processBatch(Codec *codec, Hash methodId, uint32_t sequence);
+
     /*!
      * @brief Read head of message to identify type of message.
      *
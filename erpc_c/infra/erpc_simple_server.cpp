@@ -9,7 +9,9 @@
  */
 
 #include "erpc_common.h"
+#include "erpc_latency_stats.h"
 #include "erpc_simple_server.h"
+#include "erpc_trace.h"
 
 using namespace erpc;
 
@@ -25,10 +27,32 @@ void SimpleServer::disposeBufferAndCodec(Codec *codec)
         {
             m_messageFactory->dispose(codec->getBuffer());
         }
+#if ERPC_SERVER_ARENA
+        // Everything the shim allocated for this request is released at once.
+        if (codec->getArena() == &m_arena)
+        {
+            m_arena.reset();
+        }
+#endif
         m_codecFactory->dispose(codec);
     }
 }
 
+void SimpleServer::setState(State state, const Hash &channel, uint32_t sequence)
+{
+#if ERPC_TRACE
+    if (state != m_state)
+    {
+        erpc_trace_record(static_cast<erpc_trace_event_t>(kErpcTraceServerReceive + static_cast<uint8_t>(state)), channel,
+                          sequence);
+    }
+#else
+    (void)channel;
+    (void)sequence;
+#endif
+    m_state = state;
+}
+
 erpc_status_t SimpleServer::runInternal(erpc::Hash& channel)
 {
     erpc_status_t err = kErpcStatus_Success;
@@ -40,14 +64,14 @@ erpc_status_t SimpleServer::runInternal(erpc::Hash& channel)
         if (err == kErpcStatus_Success)
         {
             /// acknoledge, go forward
-            m_state = State::RECEIVE_DONE;
+            setState(State::RECEIVE_DONE, channel, m_sequence);
         }
         else if (err == kErpcStatus_Pending){
             /// do nothing
         }
         else{
             /// pretend that nothing happened, reset state machine to the beginning
-            m_state = State::SEND_DONE;
+            setState(State::SEND_DONE, channel, m_sequence);
             return err;
         }
     }
@@ -58,14 +82,14 @@ erpc_status_t SimpleServer::runInternal(erpc::Hash& channel)
         if (err == kErpcStatus_Success)
         {
             /// acknowledge, were done, go to start
-            m_state = State::SEND_DONE;
+            setState(State::SEND_DONE, channel, m_sequence);
         }
         else if (err == kErpcStatus_Pending){
             /// do nothing
         }
         else{
             /// pretend that nothing happened, reset state machine to the beginning
-            m_state = State::SEND_DONE;
+            setState(State::SEND_DONE, channel, m_sequence);
             return err;
         }
     }
@@ -96,7 +120,7 @@ erpc_status_t SimpleServer::runInternalBegin(Codec **codec, MessageBuffer &buff,
         // Receive the next invocation request.
         if (err == kErpcStatus_Success)
         {
-            m_state = State::RECEIVE;
+            setState(State::RECEIVE, methodId, sequence);
         }
     }
 
@@ -106,7 +130,11 @@ erpc_status_t SimpleServer::runInternalBegin(Codec **codec, MessageBuffer &buff,
         // Receive the next invocation request.
         if (err == kErpcStatus_Success)
         {
+            // Traced once the header told which request this is.
             m_state = State::RECEIVE_DONE;
+#if ERPC_LATENCY_STATS
+            m_latencyStamp = erpc_latency_now();
+#endif
 #if ERPC_PRE_POST_ACTION
             pre_post_action_cb preCB = this->getPreCB();
             if (preCB != NULL)
@@ -116,7 +144,7 @@ erpc_status_t SimpleServer::runInternalBegin(Codec **codec, MessageBuffer &buff,
 #endif
 
 #if ERPC_MESSAGE_LOGGING
-            err = logMessage(&buff);
+            err = logMessage(methodId, &buff);
 #endif       
             /// codec factory can now get a reference to a transport, so that
             /// the transport can influence it's underlying codec
@@ -131,12 +159,29 @@ erpc_status_t SimpleServer::runInternalBegin(Codec **codec, MessageBuffer &buff,
             {
                 (*codec)->setBuffer(buff);
 
+#if ERPC_SERVER_ARENA
+                // A nested request served while the arena holds data of the outer one
+                // allocates by erpc_malloc().
+                if (m_arena.getUsed() == 0U)
+                {
+                    (void)m_arena.reserve(buff.getUsed() * ERPC_SERVER_ARENA_SCALE);
+                    (*codec)->setArena(&m_arena);
+                }
+#endif
+
                 err = readHeadOfMessage(*codec, msgType, serviceId, methodId, sequence);
                 if (err != kErpcStatus_Success)
                 {
                     // Dispose of buffers and codecs.
                     disposeBufferAndCodec(*codec);
                 }
+#if ERPC_TRACE
+                else
+                {
+                    erpc_trace_record(kErpcTraceTransportReceive, methodId, sequence);
+                    erpc_trace_record(kErpcTraceServerReceiveDone, methodId, sequence);
+                }
+#endif
             }
         }
     }
@@ -159,10 +204,16 @@ erpc_status_t SimpleServer::runInternalEnd(Codec *codec, message_type_t msgType,
     erpc_status_t err = kErpcStatus_Success;
 
     if(m_state == State::RECEIVE_DONE){
-        m_state = State::PROCESS;
+        setState(State::PROCESS, methodId, sequence);
+#if ERPC_LATENCY_STATS
+        LatencyStats::mark(methodId, kErpcLatencyServerQueue, m_latencyStamp);
+#endif
         err = processMessage(codec, msgType, serviceId, methodId, sequence);
         if (err == kErpcStatus_Success){
-            m_state = State::PROCESS_DONE;
+            setState(State::PROCESS_DONE, methodId, sequence);
+#if ERPC_LATENCY_STATS
+            LatencyStats::mark(methodId, kErpcLatencyServerHandler, m_latencyStamp);
+#endif
         }
         else{
             err = kErpcStatus_Fail;
@@ -173,17 +224,29 @@ erpc_status_t SimpleServer::runInternalEnd(Codec *codec, message_type_t msgType,
 
     if(m_state == State::PROCESS_DONE)
     {
-        m_state = State::SEND;
-        if (msgType == kOnewayMessage || msgType == kFastOnewayMessage){
+        setState(State::SEND, methodId, sequence);
+        if (msgType == kOnewayMessage || msgType == kFastOnewayMessage || msgType == kOnewayBatchMessage){
             // we dont send a response
-            m_state = State::SEND_DONE;
+            setState(State::SEND_DONE, methodId, sequence);
         }
         else{
             err = m_transport->send(methodId, codec->getBuffer());
+#if ERPC_LATENCY_STATS
+            if (err == kErpcStatus_Success)
+            {
+                LatencyStats::mark(methodId, kErpcLatencyServerReply, m_latencyStamp);
+            }
+#endif
+#if ERPC_TRACE
+            if (err == kErpcStatus_Success)
+            {
+                erpc_trace_record(kErpcTraceTransportSend, methodId, sequence);
+            }
+#endif
         }
 
         if(err == kErpcStatus_Success){
-            m_state = State::SEND_DONE;
+            setState(State::SEND_DONE, methodId, sequence);
             // Dispose of buffers and codecs.
             disposeBufferAndCodec(codec);
         }
@@ -271,7 +334,7 @@ erpc_status_t SimpleServer::poll(void)
         /// do your usual thing (check for received message and run internals) 
         /// when we have no current special state (we are done with whatever was before)
         if(m_state == State::SEND_DONE){
-            m_last_channel = m_transport->hasMessage();
+            m_last_channel = selectPendingChannel();
             if (m_last_channel != 0)
             {
                 err = runInternal(m_last_channel);
@@ -295,6 +358,23 @@ erpc_status_t SimpleServer::poll(void)
     return err;
 }
 
+erpc::Hash SimpleServer::selectPendingChannel(void)
+{
+    erpc::Hash channels[ERPC_PENDING_CHANNELS_COUNT];
+    erpc::Hash selected = 0;
+    uint32_t count = m_transport->pendingChannels(channels, ERPC_PENDING_CHANNELS_COUNT);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if ((selected == 0) || (getHashPriority(channels[i]) > getHashPriority(selected)))
+        {
+            selected = channels[i];
+        }
+    }
+
+    return selected;
+}
+
 void SimpleServer::stop(void)
 {
     m_isServerOn = false;
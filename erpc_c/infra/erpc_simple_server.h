@@ -57,6 +57,9 @@ public:
       m_msgType {}, 
       m_serviceId {}, 
       m_sequence {} 
+#if ERPC_LATENCY_STATS
+      , m_latencyStamp {}
+#endif
       {}
 
     /*!
@@ -134,6 +137,26 @@ protected:
      */
     erpc_status_t runInternal(erpc::Hash& channel);
 
+    /*!
+     * @brief Select the channel to process next.
+     *
+     * Asks the transport for all pending channels and picks the one with the highest
+     * priority (see erpc::getHashPriority()). Among equal priorities the first reported
+     * channel wins, so arrival order is kept.
+     *
+     * @return Channel to process, 0 when no message is pending.
+     */
+    erpc::Hash selectPendingChannel(void);
+
+    /*!
+     * @brief Move the request state machine to a new state.
+     *
+     * @param[in] state New state.
+     * @param[in] channel Channel of the request, for tracing.
+     * @param[in] sequence Sequence number of the request, for tracing.
+     */
+    void setState(State state, const erpc::Hash &channel, uint32_t sequence);
+
     /*!
      * @brief Disposing message buffers and codecs.
      *
@@ -152,6 +175,9 @@ protected:
     message_type_t m_msgType;
     uint32_t m_serviceId;
     uint32_t m_sequence;
+#if ERPC_LATENCY_STATS
+    uint32_t m_latencyStamp; /*!< Time the current phase of the served request started. */
+#endif
     
 };
 
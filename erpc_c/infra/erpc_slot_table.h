@@ -0,0 +1,171 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__SLOT_TABLE_H_
+#define _EMBEDDED_RPC__SLOT_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_utility
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpc {
+
+/*!
+ * @brief Fixed table of values of method or channel hashes, slots are claimed without a lock.
+ *
+ * A key takes the first free slot probing linearly from its hash, with one compare-exchange.
+ * Slots are never given back, so a key found once stays in its slot. The table has no
+ * constructor: zero-initialized storage is an empty table, so a static table is usable
+ * before static constructors run. Other tables call init() first.
+ *
+ * @tparam Value Type of the value of a key.
+ * @tparam slotCount Count of slots.
+ *
+ * @ingroup infra_utility
+ */
+template <typename Value, uint32_t slotCount>
+class SlotTable
+{
+public:
+    /*!
+     * @brief Mark every slot free, for a table which is not zero-initialized.
+     *
+     * Values are left as they are.
+     */
+    void init(void)
+    {
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            m_slots[i].m_state.store(kSlotFree, std::memory_order_relaxed);
+            m_slots[i].m_key = 0;
+        }
+    }
+
+    /*!
+     * @brief Find the value of a key, claim a free slot for a new key.
+     *
+     * @param[in] key Method or channel hash.
+     * @param[in] claim Claim a free slot when the key has none.
+     *
+     * @return Value of the key, NULL when it has none.
+     */
+    Value *find(uint32_t key, bool claim)
+    {
+        uint32_t start = key % slotCount;
+
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            Slot &slot = m_slots[(start + i) % slotCount];
+            uint32_t state = slot.m_state.load(std::memory_order_acquire);
+
+            if (state == kSlotFree)
+            {
+                if (!claim)
+                {
+                    return NULL;
+                }
+
+                if (slot.m_state.compare_exchange_strong(state, kSlotClaimed, std::memory_order_acquire))
+                {
+                    slot.m_key = key;
+                    slot.m_state.store(kSlotReady, std::memory_order_release);
+                    return &slot.m_value;
+                }
+            }
+
+            // Another thread claimed the slot just now, its key is written right after.
+            while (state == kSlotClaimed)
+            {
+                state = slot.m_state.load(std::memory_order_acquire);
+            }
+
+            if (slot.m_key == key)
+            {
+                return &slot.m_value;
+            }
+        }
+
+        return NULL;
+    }
+
+    /*!
+     * @brief Find the value of a key without claiming a slot.
+     *
+     * @param[in] key Method or channel hash.
+     *
+     * @return Value of the key, NULL when it has none.
+     */
+    const Value *find(uint32_t key) const
+    {
+        // Lookups never claim a slot, so the table is not modified.
+        return const_cast<SlotTable *>(this)->find(key, false);
+    }
+
+    /*!
+     * @brief Check whether a slot holds the value of a key.
+     *
+     * @param[in] index Slot index, below slotCount.
+     */
+    bool isReady(uint32_t index) const { return m_slots[index].m_state.load(std::memory_order_acquire) == kSlotReady; }
+
+    /*!
+     * @brief Return key of a slot, valid when isReady().
+     *
+     * @param[in] index Slot index, below slotCount.
+     */
+    uint32_t getKey(uint32_t index) const { return m_slots[index].m_key; }
+
+    /*!
+     * @brief Return value of a slot, of a key when isReady().
+     *
+     * @param[in] index Slot index, below slotCount.
+     */
+    Value &getValue(uint32_t index) { return m_slots[index].m_value; }
+
+    /*!
+     * @brief Return value of a slot, of a key when isReady().
+     *
+     * @param[in] index Slot index, below slotCount.
+     */
+    const Value &getValue(uint32_t index) const { return m_slots[index].m_value; }
+
+protected:
+    //! @brief States of a slot.
+    enum SlotState
+    {
+        kSlotFree = 0,    //!< Slot is not used.
+        kSlotClaimed = 1, //!< A thread is writing the key of the slot.
+        kSlotReady = 2    //!< Slot holds the value of its key.
+    };
+
+    //! @brief Value of one key.
+    struct Slot
+    {
+        std::atomic<uint32_t> m_state; //!< See SlotState.
+        uint32_t m_key;                //!< Method or channel hash, valid when ready.
+        Value m_value;                 //!< Value of the key.
+    };
+
+    Slot m_slots[slotCount]; /*!< Table storage. */
+};
+
+} // namespace erpc
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__SLOT_TABLE_H_
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_trace.h"
+
+#if ERPC_TRACE
+
+#include <atomic>
+#include <cstdio>
+#if !defined(ERPC_TRACE_CLOCK)
+#include <chrono>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+//! @brief Recorded event.
+struct TraceEvent
+{
+    uint64_t m_time;     //!< Time in nanoseconds.
+    uint32_t m_channel;  //!< Channel hash.
+    uint32_t m_sequence; //!< Sequence number.
+    uint8_t m_event;     //!< See erpc_trace_event_t.
+};
+
+//! @brief Events of one thread, written by that thread only.
+struct TraceRing
+{
+    std::atomic<uint32_t> m_head;           //!< Count of events ever recorded.
+    std::atomic<uint32_t> m_writing;        //!< Count of events whose recording started.
+    std::atomic<uint32_t> m_tail;           //!< First event not dropped by erpc_trace_clear().
+    TraceEvent m_events[ERPC_TRACE_EVENTS]; //!< Last ERPC_TRACE_EVENTS events.
+};
+
+//! @brief How an event appears in the Chrome trace.
+struct EventFormat
+{
+    const char *m_phase; //!< Chrome event type.
+    const char *m_cat;   //!< Category, async slices are matched within it.
+    const char *m_name;  //!< Event name.
+};
+
+const EventFormat kFormats[kErpcTraceEventCount] = {
+    { "b", "client", "call" },          // kErpcTraceClientValid
+    { "n", "client", "sending" },       // kErpcTraceClientSending
+    { "n", "client", "sent" },          // kErpcTraceClientSent
+    { "n", "client", "pending" },       // kErpcTraceClientPending
+    { "e", "client", "call" },          // kErpcTraceClientDone
+    { "i", "server", "receive" },       // kErpcTraceServerReceive
+    { "b", "server", "serve" },         // kErpcTraceServerReceiveDone
+    { "B", "server", "handler" },       // kErpcTraceServerProcess
+    { "E", "server", "handler" },       // kErpcTraceServerProcessDone
+    { "n", "server", "reply" },         // kErpcTraceServerSend
+    { "e", "server", "serve" },         // kErpcTraceServerSendDone
+    { "i", "transport", "send" },       // kErpcTraceTransportSend
+    { "i", "transport", "receive" },    // kErpcTraceTransportReceive
+};
+
+// Static storage is zero-initialized, rings start empty.
+TraceRing s_rings[ERPC_TRACE_THREADS];
+std::atomic<uint32_t> s_ringCount(0);
+thread_local TraceRing *t_ring = NULL;
+thread_local bool t_noRing = false;
+
+uint64_t traceNow(void)
+{
+#if defined(ERPC_TRACE_CLOCK)
+    return ERPC_TRACE_CLOCK();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#endif
+}
+
+/*!
+ * @brief Return ring of the calling thread, claim one on the first call.
+ *
+ * @return Ring, NULL when all rings are taken.
+ */
+TraceRing *threadRing(void)
+{
+    if ((t_ring == NULL) && !t_noRing)
+    {
+        uint32_t index = s_ringCount.fetch_add(1U, std::memory_order_relaxed);
+        if (index < ERPC_TRACE_THREADS)
+        {
+            t_ring = &s_rings[index];
+        }
+        else
+        {
+            t_noRing = true;
+        }
+    }
+
+    return t_ring;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+void erpc_trace_record(erpc_trace_event_t event, uint32_t channel, uint32_t sequence)
+{
+    TraceRing *ring = threadRing();
+
+    if (ring != NULL)
+    {
+        uint32_t head = ring->m_head.load(std::memory_order_relaxed);
+        TraceEvent &slot = ring->m_events[head % ERPC_TRACE_EVENTS];
+
+        // Announce the slot before touching it, erpc_trace_dump() skips it meanwhile.
+        ring->m_writing.store(head + 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.m_time = traceNow();
+        slot.m_channel = channel;
+        slot.m_sequence = sequence;
+        slot.m_event = static_cast<uint8_t>(event);
+        ring->m_head.store(head + 1U, std::memory_order_release);
+    }
+}
+
+uint32_t erpc_trace_dump(erpc_trace_writer_t writer, void *context)
+{
+    char line[256];
+    uint32_t written = 0;
+    uint32_t rings = s_ringCount.load(std::memory_order_acquire);
+
+    if (rings > ERPC_TRACE_THREADS)
+    {
+        rings = ERPC_TRACE_THREADS;
+    }
+
+    static const char kBegin[] = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    writer(kBegin, sizeof(kBegin) - 1U, context);
+
+    for (uint32_t tid = 0; tid < rings; ++tid)
+    {
+        TraceRing &ring = s_rings[tid];
+        uint32_t head = ring.m_head.load(std::memory_order_acquire);
+        uint32_t index = ring.m_tail.load(std::memory_order_relaxed);
+
+        if ((head - index) > ERPC_TRACE_EVENTS)
+        {
+            index = head - ERPC_TRACE_EVENTS;
+        }
+
+        for (; index != head; ++index)
+        {
+            TraceEvent event = ring.m_events[index % ERPC_TRACE_EVENTS];
+
+            // Drop the copy when the thread started to overwrite its slot meanwhile.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((ring.m_writing.load(std::memory_order_relaxed) - index) > ERPC_TRACE_EVENTS)
+            {
+                continue;
+            }
+
+            if (event.m_event >= kErpcTraceEventCount)
+            {
+                continue;
+            }
+
+            const EventFormat &format = kFormats[event.m_event];
+            int length = snprintf(line, sizeof(line),
+                                  "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%llu.%03u,\"pid\":1,"
+                                  "\"tid\":%u,\"id\":\"0x%08x%08x\",\"s\":\"t\","
+                                  "\"args\":{\"channel\":%u,\"sequence\":%u}}",
+                                  (written != 0U) ? ",\n" : "\n", format.m_name, format.m_cat, format.m_phase,
+                                  static_cast<unsigned long long>(event.m_time / 1000U),
+                                  static_cast<unsigned>(event.m_time % 1000U), static_cast<unsigned>(tid),
+                                  static_cast<unsigned>(event.m_channel), static_cast<unsigned>(event.m_sequence),
+                                  static_cast<unsigned>(event.m_channel), static_cast<unsigned>(event.m_sequence));
+            if ((length > 0) && (static_cast<uint32_t>(length) < sizeof(line)))
+            {
+                writer(line, static_cast<uint32_t>(length), context);
+                ++written;
+            }
+        }
+    }
+
+    static const char kEnd[] = "\n]}\n";
+    writer(kEnd, sizeof(kEnd) - 1U, context);
+
+    return written;
+}
+
+void erpc_trace_clear(void)
+{
+    for (uint32_t i = 0; i < ERPC_TRACE_THREADS; ++i)
+    {
+        s_rings[i].m_tail.store(s_rings[i].m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+#endif // ERPC_TRACE
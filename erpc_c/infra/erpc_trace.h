@@ -0,0 +1,104 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__TRACE_H_
+#define _EMBEDDED_RPC__TRACE_H_
+
+#include "erpc_config_internal.h"
+
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_utility
+ * @{
+ * @file
+ */
+
+#if ERPC_TRACE
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Traced lifecycle events.
+typedef enum erpc_trace_event
+{
+    kErpcTraceClientValid = 0,        //!< Client created a request.
+    kErpcTraceClientSending = 1,      //!< Client stub encoded the request.
+    kErpcTraceClientSent = 2,         //!< Request was sent.
+    kErpcTraceClientPending = 3,      //!< Client waits for the reply.
+    kErpcTraceClientDone = 4,         //!< Request is done, with reply or error.
+    kErpcTraceServerReceive = 5,      //!< Server waits for a request.
+    kErpcTraceServerReceiveDone = 6,  //!< Server received a request.
+    kErpcTraceServerProcess = 7,      //!< Server handler started.
+    kErpcTraceServerProcessDone = 8,  //!< Server handler finished.
+    kErpcTraceServerSend = 9,         //!< Server sends the reply.
+    kErpcTraceServerSendDone = 10,    //!< Server finished the request.
+    kErpcTraceTransportSend = 11,     //!< Transport sent a message.
+    kErpcTraceTransportReceive = 12,  //!< Transport received a message.
+    kErpcTraceEventCount = 13         //!< Count of events.
+} erpc_trace_event_t;
+
+/*!
+ * @brief Function receiving the trace while it is dumped.
+ *
+ * @param[in] data Piece of the trace JSON, not null-terminated.
+ * @param[in] length Length of the piece.
+ * @param[in] context Context passed to erpc_trace_dump().
+ */
+typedef void (*erpc_trace_writer_t)(const char *data, uint32_t length, void *context);
+
+////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @brief Record an event into the ring buffer of the calling thread.
+ *
+ * Threads get their ring on the first event, up to ERPC_TRACE_THREADS threads are traced.
+ * Each ring keeps the last ERPC_TRACE_EVENTS events.
+ *
+ * @param[in] event Event to record.
+ * @param[in] channel Channel hash of the message.
+ * @param[in] sequence Sequence number of the message.
+ */
+void erpc_trace_record(erpc_trace_event_t event, uint32_t channel, uint32_t sequence);
+
+/*!
+ * @brief Write recorded events as Chrome trace JSON.
+ *
+ * The output loads into chrome://tracing and ui.perfetto.dev. Each call is an async slice from
+ * its creation to done, server requests are async slices from receive to reply sent with the
+ * handler as a slice on the server thread. Threads may keep recording, events they overwrite
+ * while the dump copies them are left out.
+ *
+ * @param[in] writer Function receiving the JSON.
+ * @param[in] context Passed to @a writer.
+ *
+ * @return Count of events written.
+ */
+uint32_t erpc_trace_dump(erpc_trace_writer_t writer, void *context);
+
+/*!
+ * @brief Drop all recorded events.
+ */
+void erpc_trace_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ERPC_TRACE
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__TRACE_H_
@@ -13,6 +13,7 @@
 #include "erpc_common.h"
 #include "erpc_crc16.h"
 #include "erpc_message_buffer.h"
+#include "erpc_transport_stats.h"
 
 #include <cstring>
 
@@ -42,7 +43,10 @@ public:
     /*!
      * @brief Constructor.
      */
-    Transport(void) {}
+    Transport(void)
+    : m_crc16(NULL)
+    {
+    }
 
     /*!
      * @brief Transport destructor
@@ -82,18 +86,99 @@ public:
      */
     virtual erpc::Hash hasMessage(void) { return 0; }
 
+    /*!
+     * @brief Collect all channels that currently have a message waiting.
+     *
+     * Used by the server to pick the highest-priority pending message first. Transports
+     * which demultiplex several channels should override it, the default implementation
+     * reports the single channel returned by hasMessage().
+     *
+     * @param[out] channels Array to be filled with pending channel hashes.
+     * @param[in] maxChannels Capacity of @a channels.
+     *
+     * @return Number of channels written into @a channels.
+     */
+    virtual uint32_t pendingChannels(erpc::Hash *channels, uint32_t maxChannels)
+    {
+        erpc::Hash channel = hasMessage();
+        if ((channel == 0) || (maxChannels == 0))
+        {
+            return 0;
+        }
+        channels[0] = channel;
+        return 1;
+    }
+
+    /*!
+     * @brief Tell the transport that a sender gives up a message it did not finish sending.
+     *
+     * Called when a request is released while its message still waits in send(), so that a
+     * scheduling transport stops holding other channels back for it.
+     *
+     * @param[in] channel Channel of the abandoned message.
+     */
+    virtual void abandonSend(const erpc::Hash &channel) { (void)channel; }
+
     /*!
      * @brief This functions sets the CRC-16 implementation.
      *
+     * Same as setIntegrityCheck() with a Crc16 object. The object is remembered, so that
+     * selecting CRC-16 again later keeps its start value (see getCrc16()).
+     *
      * @param[in] crcImpl Object containing crc-16 compute function.
      */
-    virtual void setCrc16(Crc16 *crcImpl) { (void)crcImpl; }
+    virtual void setCrc16(Crc16 *crcImpl)
+    {
+        m_crc16 = crcImpl;
+        (void)setIntegrityCheck(crcImpl);
+    }
+
+    /*!
+     * @brief Return the CRC-16 implementation given to setCrc16().
+     *
+     * @return Crc16 object of this transport, NULL when none was set.
+     */
+    Crc16 *getCrc16(void) const { return m_crc16; }
+
+    /*!
+     * @brief This functions sets the integrity check computed over each frame.
+     *
+     * Transports which do not frame messages ignore it.
+     *
+     * @param[in] check Integrity check object, e.g. Crc16, Crc32c or IntegrityNone.
+     *
+     * @retval kErpcStatus_Success The check is used.
+     * @retval kErpcStatus_InvalidArgument Frames cannot carry the check, the previous one is kept.
+     */
+    virtual erpc_status_t setIntegrityCheck(IntegrityCheck *check)
+    {
+        (void)check;
+        return kErpcStatus_Success;
+    }
 
     virtual void flush() = 0;
 
     /// this function is called when a codec was created, so this transport can
     /// change the codecs underlying behavor in some way
     virtual void codecCreationCallback(Codec* /*codec*/){ }
+
+#if ERPC_TRANSPORT_STATS
+    /*!
+     * @brief Return counters of this transport.
+     *
+     * Transports which send and receive on their own count here, wrapping transports like
+     * QueuedTransport count nothing and leave it to the transport they wrap.
+     *
+     * @return Counters in total and per channel.
+     */
+    TransportStats &getStats(void) { return m_stats; }
+
+protected:
+    TransportStats m_stats; //!< Counters of sent and received messages.
+#endif
+
+protected:
+    Crc16 *m_crc16; //!< CRC-16 implementation given to setCrc16().
 };
 
 /*!
@@ -45,11 +45,11 @@ TransportArbitrator::~TransportArbitrator(void)
     freeClientList(m_clientFreeList);
 }
 
-void TransportArbitrator::setCrc16(Crc16 *crcImpl)
+erpc_status_t TransportArbitrator::setIntegrityCheck(IntegrityCheck *check)
 {
-    assert(crcImpl);
+    assert(check);
     assert(m_sharedTransport);
-    m_sharedTransport->setCrc16(crcImpl);
+    return m_sharedTransport->setIntegrityCheck(check);
 }
 
 bool TransportArbitrator::hasMessage(void)
@@ -115,11 +115,13 @@ public:
     virtual erpc_status_t send(MessageBuffer *message) override;
 
     /*!
-     * @brief This functions sets the CRC-16 implementation.
+     * @brief This functions sets the integrity check of the shared transport.
      *
-     * @param[in] crcImpl Object containing crc-16 compute function.
+     * @param[in] check Integrity check object.
+     *
+     * @return Status of the wrapped transport, see Transport::setIntegrityCheck().
      */
-    virtual void setCrc16(Crc16 *crcImpl) override;
+    virtual erpc_status_t setIntegrityCheck(IntegrityCheck *check) override;
 
     /*!
      * @brief Check if the underlying shared transport has a message
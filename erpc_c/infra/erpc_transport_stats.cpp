@@ -0,0 +1,208 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_transport_stats.h"
+
+#if ERPC_TRANSPORT_STATS
+
+#if !defined(ERPC_TRANSPORT_STATS_CLOCK)
+#include <chrono>
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TransportStats::TransportStats(void)
+{
+    clear(m_totals);
+    m_channels.init();
+    for (uint32_t i = 0; i < ERPC_TRANSPORT_STATS_CHANNELS; ++i)
+    {
+        clear(m_channels.getValue(i));
+    }
+}
+
+void TransportStats::countSend(Hash channel, uint32_t bytes, erpc_status_t status)
+{
+    Counters *channelCounters = m_channels.find(channel, true);
+    Counters *counters[] = { &m_totals, channelCounters };
+
+    if (status == kErpcStatus_Pending)
+    {
+        // Blocked time is measured per channel, a send of another channel may be pending meanwhile.
+        if ((channelCounters != NULL) && (channelCounters->m_sendBlockedSince.load(std::memory_order_relaxed) == 0U))
+        {
+            uint32_t notBlocked = 0U;
+            (void)channelCounters->m_sendBlockedSince.compare_exchange_strong(notBlocked, now(),
+                                                                              std::memory_order_relaxed);
+        }
+
+        for (Counters *c : counters)
+        {
+            if (c != NULL)
+            {
+                c->m_sendPending.fetch_add(1U, std::memory_order_relaxed);
+            }
+        }
+        return;
+    }
+
+    uint32_t blockedUs = 0U;
+    if (channelCounters != NULL)
+    {
+        uint32_t since = channelCounters->m_sendBlockedSince.exchange(0U, std::memory_order_relaxed);
+        if (since != 0U)
+        {
+            blockedUs = now() - since;
+        }
+    }
+
+    for (Counters *c : counters)
+    {
+        if (c == NULL)
+        {
+            continue;
+        }
+
+        if (status == kErpcStatus_Success)
+        {
+            c->m_framesSent.fetch_add(1U, std::memory_order_relaxed);
+            c->m_bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+        }
+        else
+        {
+            c->m_sendErrors.fetch_add(1U, std::memory_order_relaxed);
+        }
+
+        if (blockedUs != 0U)
+        {
+            c->m_sendBlockedUs.fetch_add(blockedUs, std::memory_order_relaxed);
+        }
+    }
+}
+
+void TransportStats::countReceive(Hash channel, uint32_t bytes, erpc_status_t status)
+{
+    Counters *channelCounters = m_channels.find(channel, true);
+    Counters *counters[] = { &m_totals, channelCounters };
+
+    for (Counters *c : counters)
+    {
+        if (c == NULL)
+        {
+            continue;
+        }
+
+        switch (status)
+        {
+            case kErpcStatus_Success:
+                c->m_framesReceived.fetch_add(1U, std::memory_order_relaxed);
+                c->m_bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+                break;
+            case kErpcStatus_Pending:
+                c->m_receivePending.fetch_add(1U, std::memory_order_relaxed);
+                break;
+            case kErpcStatus_CrcCheckFailed:
+                c->m_crcErrors.fetch_add(1U, std::memory_order_relaxed);
+                break;
+            default:
+                c->m_receiveErrors.fetch_add(1U, std::memory_order_relaxed);
+                break;
+        }
+    }
+}
+
+bool TransportStats::read(Hash channel, erpc_transport_stats_t *stats) const
+{
+    if (channel == 0U)
+    {
+        copy(m_totals, 0U, stats);
+        return true;
+    }
+
+    const Counters *counters = m_channels.find(channel);
+    if (counters == NULL)
+    {
+        return false;
+    }
+
+    copy(*counters, channel, stats);
+    return true;
+}
+
+uint32_t TransportStats::readChannels(erpc_transport_stats_t *stats, uint32_t capacity) const
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; (i < ERPC_TRANSPORT_STATS_CHANNELS) && (count < capacity); ++i)
+    {
+        if (m_channels.isReady(i))
+        {
+            copy(m_channels.getValue(i), m_channels.getKey(i), &stats[count++]);
+        }
+    }
+
+    return count;
+}
+
+void TransportStats::reset(void)
+{
+    clear(m_totals);
+    for (uint32_t i = 0; i < ERPC_TRANSPORT_STATS_CHANNELS; ++i)
+    {
+        clear(m_channels.getValue(i));
+    }
+}
+
+void TransportStats::copy(const Counters &counters, Hash channel, erpc_transport_stats_t *stats)
+{
+    stats->channel = channel;
+    stats->bytesSent = counters.m_bytesSent.load(std::memory_order_relaxed);
+    stats->bytesReceived = counters.m_bytesReceived.load(std::memory_order_relaxed);
+    stats->framesSent = counters.m_framesSent.load(std::memory_order_relaxed);
+    stats->framesReceived = counters.m_framesReceived.load(std::memory_order_relaxed);
+    stats->sendPending = counters.m_sendPending.load(std::memory_order_relaxed);
+    stats->receivePending = counters.m_receivePending.load(std::memory_order_relaxed);
+    stats->sendErrors = counters.m_sendErrors.load(std::memory_order_relaxed);
+    stats->receiveErrors = counters.m_receiveErrors.load(std::memory_order_relaxed);
+    stats->crcErrors = counters.m_crcErrors.load(std::memory_order_relaxed);
+    stats->sendBlockedUs = counters.m_sendBlockedUs.load(std::memory_order_relaxed);
+}
+
+void TransportStats::clear(Counters &counters)
+{
+    counters.m_bytesSent.store(0U, std::memory_order_relaxed);
+    counters.m_bytesReceived.store(0U, std::memory_order_relaxed);
+    counters.m_framesSent.store(0U, std::memory_order_relaxed);
+    counters.m_framesReceived.store(0U, std::memory_order_relaxed);
+    counters.m_sendPending.store(0U, std::memory_order_relaxed);
+    counters.m_receivePending.store(0U, std::memory_order_relaxed);
+    counters.m_sendErrors.store(0U, std::memory_order_relaxed);
+    counters.m_receiveErrors.store(0U, std::memory_order_relaxed);
+    counters.m_crcErrors.store(0U, std::memory_order_relaxed);
+    counters.m_sendBlockedUs.store(0U, std::memory_order_relaxed);
+    counters.m_sendBlockedSince.store(0U, std::memory_order_relaxed);
+}
+
+uint32_t TransportStats::now(void)
+{
+#if defined(ERPC_TRANSPORT_STATS_CLOCK)
+    uint32_t us = ERPC_TRANSPORT_STATS_CLOCK();
+#else
+    uint32_t us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                            std::chrono::steady_clock::now().time_since_epoch())
+                                            .count());
+#endif
+    // 0 marks a channel which is not blocked.
+    return (us != 0U) ? us : 1U;
+}
+
+#endif // ERPC_TRANSPORT_STATS
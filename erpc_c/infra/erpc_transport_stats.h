@@ -0,0 +1,169 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__TRANSPORT_STATS_H_
+#define _EMBEDDED_RPC__TRANSPORT_STATS_H_
+
+#include "erpc_config_internal.h"
+
+#include <stdint.h>
+
+/*!
+ * @addtogroup infra_transport
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Counters of a transport, in total or of one channel.
+ *
+ * Counters wrap around at 2^32, readers should take differences between two reads.
+ */
+typedef struct erpc_transport_stats
+{
+    uint32_t channel;        //!< Channel hash, 0 for the totals of the transport.
+    uint32_t bytesSent;      //!< Message bytes sent, without framing.
+    uint32_t bytesReceived;  //!< Message bytes received, without framing.
+    uint32_t framesSent;     //!< Messages sent.
+    uint32_t framesReceived; //!< Messages received.
+    uint32_t sendPending;    //!< Sends which returned kErpcStatus_Pending.
+    uint32_t receivePending; //!< Receives which returned kErpcStatus_Pending.
+    uint32_t sendErrors;     //!< Sends which failed.
+    uint32_t receiveErrors;  //!< Receives which failed, without CRC failures.
+    uint32_t crcErrors;      //!< Received frames with wrong integrity check value.
+    uint32_t sendBlockedUs;  //!< Time from the first pending send until the message was sent or failed.
+} erpc_transport_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+#if ERPC_TRANSPORT_STATS && defined(__cplusplus)
+#include "erpc_common.h"
+#include "erpc_slot_table.h"
+
+#include <atomic>
+
+namespace erpc {
+
+/*!
+ * @brief Counters of one transport, in total and per channel.
+ *
+ * Channels get their counters on the first counted message, from a table of
+ * ERPC_TRANSPORT_STATS_CHANNELS slots. Further channels are only counted in the totals.
+ * Counting is a few relaxed atomic adds, it needs no lock and any thread may count.
+ *
+ * @ingroup infra_transport
+ */
+class TransportStats
+{
+public:
+    /*!
+     * @brief Constructor.
+     */
+    TransportStats(void);
+
+    /*!
+     * @brief Count result of a send.
+     *
+     * @param[in] channel Channel of the message.
+     * @param[in] bytes Size of the message.
+     * @param[in] status Value returned by the send.
+     */
+    void countSend(Hash channel, uint32_t bytes, erpc_status_t status);
+
+    /*!
+     * @brief Count result of a receive.
+     *
+     * @param[in] channel Channel of the message.
+     * @param[in] bytes Size of the received message.
+     * @param[in] status Value returned by the receive.
+     */
+    void countReceive(Hash channel, uint32_t bytes, erpc_status_t status);
+
+    /*!
+     * @brief Read counters.
+     *
+     * @param[in] channel Channel hash, 0 for the totals.
+     * @param[out] stats Counters.
+     *
+     * @retval true Counters were read.
+     * @retval false The channel has no counters of its own.
+     */
+    bool read(Hash channel, erpc_transport_stats_t *stats) const;
+
+    /*!
+     * @brief Read counters of every channel counted separately.
+     *
+     * @param[out] stats Array the counters are written to.
+     * @param[in] capacity Count of entries the array holds.
+     *
+     * @return Count of entries written.
+     */
+    uint32_t readChannels(erpc_transport_stats_t *stats, uint32_t capacity) const;
+
+    /*!
+     * @brief Clear all counters, channels keep their slots.
+     */
+    void reset(void);
+
+protected:
+    //! @brief Counters of the totals or one channel.
+    struct Counters
+    {
+        std::atomic<uint32_t> m_bytesSent;        //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_bytesReceived;    //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_framesSent;       //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_framesReceived;   //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_sendPending;      //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_receivePending;   //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_sendErrors;       //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_receiveErrors;    //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_crcErrors;        //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_sendBlockedUs;    //!< See erpc_transport_stats_t.
+        std::atomic<uint32_t> m_sendBlockedSince; //!< Time of the first pending send, 0 when not blocked.
+    };
+
+    Counters m_totals;                                             //!< Counters of all channels.
+    SlotTable<Counters, ERPC_TRANSPORT_STATS_CHANNELS> m_channels; //!< Counters per channel.
+
+    /*!
+     * @brief Copy counters into a C structure.
+     *
+     * @param[in] counters Counters to copy.
+     * @param[in] channel Channel hash the counters belong to.
+     * @param[out] stats Structure to fill.
+     */
+    static void copy(const Counters &counters, Hash channel, erpc_transport_stats_t *stats);
+
+    /*!
+     * @brief Clear counters.
+     *
+     * @param[in] counters Counters to clear.
+     */
+    static void clear(Counters &counters);
+
+    /*!
+     * @brief Return current time of the blocked-send clock.
+     *
+     * @return Time in microseconds, never 0.
+     */
+    static uint32_t now(void);
+};
+
+} // namespace erpc
+
+#endif // ERPC_TRANSPORT_STATS && __cplusplus
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__TRANSPORT_STATS_H_
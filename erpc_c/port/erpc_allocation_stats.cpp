@@ -0,0 +1,232 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_allocation_stats.h"
+
+#if ERPC_ALLOCATION_STATS
+
+#include "erpc_slot_table.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+//! @brief Header in front of each block, it tells erpc_free() what it frees.
+struct BlockHeader
+{
+    size_t m_size;     //!< Requested size.
+    uint32_t m_method; //!< Method the block was allocated for, 0 for none.
+};
+
+//! @brief Header size, rounded up so the data keeps the alignment of the allocator.
+const size_t kHeaderSize =
+    ((sizeof(BlockHeader) + alignof(std::max_align_t) - 1U) / alignof(std::max_align_t)) * alignof(std::max_align_t);
+
+//! @brief Counters of the calling thread, plain integers so the thread-local storage needs no constructor.
+struct ThreadCounters
+{
+    uint32_t m_method;      //!< Current tag.
+    uint64_t m_allocations; //!< See erpc_allocation_stats_t.
+    uint64_t m_bytes;       //!< See erpc_allocation_stats_t.
+    uint64_t m_frees;       //!< See erpc_allocation_stats_t.
+    uint64_t m_freedBytes;  //!< Bytes of the freed blocks.
+};
+
+//! @brief Counters of one method, any thread may free its blocks.
+struct MethodCounters
+{
+    std::atomic<uint64_t> m_allocations; //!< See erpc_allocation_stats_t.
+    std::atomic<uint64_t> m_bytes;       //!< See erpc_allocation_stats_t.
+    std::atomic<uint64_t> m_frees;       //!< See erpc_allocation_stats_t.
+    std::atomic<uint64_t> m_freedBytes;  //!< Bytes of the freed blocks.
+};
+
+thread_local ThreadCounters t_counters;
+// Static storage is zero-initialized, allocations made before static constructors run find an empty table.
+erpc::SlotTable<MethodCounters, ERPC_ALLOCATION_STATS_METHODS> s_methods;
+std::atomic<erpc_allocation_failure_t> s_failureHook(NULL);
+
+/*!
+ * @brief Copy counters of a method into a C structure.
+ */
+void copy(uint32_t method, const MethodCounters &counters, erpc_allocation_stats_t *stats)
+{
+    uint64_t allocations = counters.m_allocations.load(std::memory_order_relaxed);
+    uint64_t bytes = counters.m_bytes.load(std::memory_order_relaxed);
+    uint64_t frees = counters.m_frees.load(std::memory_order_relaxed);
+
+    stats->method = method;
+    stats->allocations = allocations;
+    stats->bytes = bytes;
+    stats->frees = frees;
+    stats->liveObjects = static_cast<int64_t>(allocations - frees);
+    stats->liveBytes = static_cast<int64_t>(bytes - counters.m_freedBytes.load(std::memory_order_relaxed));
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t erpc_allocation_stats_set_method(uint32_t method)
+{
+    uint32_t previous = t_counters.m_method;
+
+    t_counters.m_method = method;
+
+    return previous;
+}
+
+void erpc_allocation_stats_thread(erpc_allocation_stats_t *stats)
+{
+    stats->method = 0;
+    stats->allocations = t_counters.m_allocations;
+    stats->bytes = t_counters.m_bytes;
+    stats->frees = t_counters.m_frees;
+    stats->liveObjects = static_cast<int64_t>(t_counters.m_allocations - t_counters.m_frees);
+    stats->liveBytes = static_cast<int64_t>(t_counters.m_bytes - t_counters.m_freedBytes);
+}
+
+bool erpc_allocation_stats_method(uint32_t method, erpc_allocation_stats_t *stats)
+{
+    const MethodCounters *counters = (method != 0U) ? s_methods.find(method) : NULL;
+
+    if (counters == NULL)
+    {
+        return false;
+    }
+
+    copy(method, *counters, stats);
+    return true;
+}
+
+uint32_t erpc_allocation_stats_methods(erpc_allocation_stats_t *stats, uint32_t capacity)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; (i < ERPC_ALLOCATION_STATS_METHODS) && (count < capacity); ++i)
+    {
+        if (s_methods.isReady(i))
+        {
+            copy(s_methods.getKey(i), s_methods.getValue(i), &stats[count++]);
+        }
+    }
+
+    return count;
+}
+
+void erpc_allocation_stats_reset(void)
+{
+    t_counters.m_allocations = 0;
+    t_counters.m_bytes = 0;
+    t_counters.m_frees = 0;
+    t_counters.m_freedBytes = 0;
+
+    for (uint32_t i = 0; i < ERPC_ALLOCATION_STATS_METHODS; ++i)
+    {
+        MethodCounters &counters = s_methods.getValue(i);
+
+        counters.m_allocations.store(0U, std::memory_order_relaxed);
+        counters.m_bytes.store(0U, std::memory_order_relaxed);
+        counters.m_frees.store(0U, std::memory_order_relaxed);
+        counters.m_freedBytes.store(0U, std::memory_order_relaxed);
+    }
+}
+
+size_t erpc_allocation_stats_block_size(size_t size)
+{
+    return (size <= SIZE_MAX - kHeaderSize) ? (size + kHeaderSize) : SIZE_MAX;
+}
+
+void *erpc_allocation_stats_allocated(void *block, size_t size)
+{
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    BlockHeader *header = static_cast<BlockHeader *>(block);
+    header->m_size = size;
+    header->m_method = t_counters.m_method;
+
+    ++t_counters.m_allocations;
+    t_counters.m_bytes += size;
+
+    if (header->m_method != 0U)
+    {
+        MethodCounters *counters = s_methods.find(header->m_method, true);
+        if (counters != NULL)
+        {
+            counters->m_allocations.fetch_add(1U, std::memory_order_relaxed);
+            counters->m_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+        else
+        {
+            // The table is full, the free must not be counted for the method either.
+            header->m_method = 0U;
+        }
+    }
+
+    return static_cast<uint8_t *>(block) + kHeaderSize;
+}
+
+void *erpc_allocation_stats_freeing(void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return NULL;
+    }
+
+    BlockHeader *header = reinterpret_cast<BlockHeader *>(static_cast<uint8_t *>(ptr) - kHeaderSize);
+
+    ++t_counters.m_frees;
+    t_counters.m_freedBytes += header->m_size;
+
+    if (header->m_method != 0U)
+    {
+        MethodCounters *counters = s_methods.find(header->m_method, false);
+        if (counters != NULL)
+        {
+            counters->m_frees.fetch_add(1U, std::memory_order_relaxed);
+            counters->m_freedBytes.fetch_add(header->m_size, std::memory_order_relaxed);
+        }
+    }
+
+    return header;
+}
+
+erpc_allocation_failure_t erpc_allocation_stats_set_failure_hook(erpc_allocation_failure_t hook)
+{
+    return s_failureHook.exchange(hook);
+}
+
+void erpc_allocation_stats_fail(const char *statement, const char *file, uint32_t line, uint64_t allocations)
+{
+    erpc_allocation_failure_t hook = s_failureHook.load();
+
+    if (hook != NULL)
+    {
+        hook(statement, file, line, allocations);
+        return;
+    }
+
+    (void)fprintf(stderr, "%s:%u: %s allocated %llu blocks\n", file, static_cast<unsigned>(line), statement,
+                  static_cast<unsigned long long>(allocations));
+    abort();
+}
+
+#endif // ERPC_ALLOCATION_STATS
@@ -0,0 +1,283 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__ALLOCATION_STATS_H_
+#define _EMBEDDED_RPC__ALLOCATION_STATS_H_
+
+#include "erpc_config_internal.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * @addtogroup port_mem
+ * @{
+ * @file
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Heap allocation counters of a thread or of a method.
+ *
+ * Live counts of a thread are its allocations minus the blocks it freed, so they go negative
+ * on a thread which frees blocks of another one. Live counts of a method are exact, the block
+ * remembers the method it was allocated for.
+ */
+typedef struct erpc_allocation_stats
+{
+    uint32_t method;      //!< Method hash, 0 for the counters of a thread.
+    uint64_t allocations; //!< Blocks allocated by erpc_malloc() and operator new.
+    uint64_t bytes;       //!< Bytes requested by these allocations.
+    uint64_t frees;       //!< Blocks freed.
+    int64_t liveObjects;  //!< Blocks allocated and not freed yet.
+    int64_t liveBytes;    //!< Bytes of these blocks.
+} erpc_allocation_stats_t;
+
+/*!
+ * @brief Called when a statement checked by ERPC_ASSERT_NO_ALLOCATIONS() allocated memory.
+ *
+ * @param[in] statement Text of the statement.
+ * @param[in] file Source file of the check.
+ * @param[in] line Source line of the check.
+ * @param[in] allocations Count of blocks the statement allocated.
+ */
+typedef void (*erpc_allocation_failure_t)(const char *statement, const char *file, uint32_t line,
+                                          uint64_t allocations);
+
+#if ERPC_ALLOCATION_STATS
+
+////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @brief Tag following allocations of the calling thread with a method.
+ *
+ * Client stubs tag the whole call, Server tags the handler of a request, both by
+ * erpc::AllocationTag. Allocations tagged with 0 are counted for the thread only.
+ *
+ * @param[in] method Method hash, 0 to stop tagging.
+ *
+ * @return Previous tag, to be restored when the tagged region ends.
+ */
+uint32_t erpc_allocation_stats_set_method(uint32_t method);
+
+/*!
+ * @brief Read the counters of the calling thread.
+ *
+ * @param[out] stats Counters, method is 0.
+ */
+void erpc_allocation_stats_thread(erpc_allocation_stats_t *stats);
+
+/*!
+ * @brief Read the counters of a method.
+ *
+ * @param[in] method Method hash.
+ * @param[out] stats Counters.
+ *
+ * @retval true Counters were read.
+ * @retval false The method has no counters of its own.
+ */
+bool erpc_allocation_stats_method(uint32_t method, erpc_allocation_stats_t *stats);
+
+/*!
+ * @brief Read the counters of every method with allocations.
+ *
+ * @param[out] stats Array the counters are written to.
+ * @param[in] capacity Count of entries the array holds.
+ *
+ * @return Count of entries written.
+ */
+uint32_t erpc_allocation_stats_methods(erpc_allocation_stats_t *stats, uint32_t capacity);
+
+/*!
+ * @brief Clear the counters of all methods and of the calling thread.
+ *
+ * Blocks allocated before and freed after the reset make live counts negative.
+ */
+void erpc_allocation_stats_reset(void);
+
+/*!
+ * @brief Return size of the block a port allocates for @a size bytes.
+ *
+ * Used by erpc_malloc() of the ports, the block has room for a header in front of the data.
+ *
+ * @param[in] size Requested size.
+ *
+ * @return Size of the block, SIZE_MAX when it overflows.
+ */
+size_t erpc_allocation_stats_block_size(size_t size);
+
+/*!
+ * @brief Count an allocation and return the data of the block.
+ *
+ * Used by erpc_malloc() of the ports.
+ *
+ * @param[in] block Block allocated with erpc_allocation_stats_block_size(), or NULL.
+ * @param[in] size Requested size.
+ *
+ * @return Pointer to return to the caller, NULL when @a block is NULL.
+ */
+void *erpc_allocation_stats_allocated(void *block, size_t size);
+
+/*!
+ * @brief Count a free and return the block to free.
+ *
+ * Used by erpc_free() of the ports.
+ *
+ * @param[in] ptr Pointer returned by erpc_malloc(), or NULL.
+ *
+ * @return Block to pass to the allocator, NULL when @a ptr is NULL.
+ */
+void *erpc_allocation_stats_freeing(void *ptr);
+
+/*!
+ * @brief Set the function ERPC_ASSERT_NO_ALLOCATIONS() reports failures to.
+ *
+ * Test frameworks install a hook which fails the running test. Without a hook a failure is
+ * printed to stderr and aborts the program, with or without NDEBUG.
+ *
+ * @param[in] hook Failure hook, NULL for the default.
+ *
+ * @return Previous hook.
+ */
+erpc_allocation_failure_t erpc_allocation_stats_set_failure_hook(erpc_allocation_failure_t hook);
+
+/*!
+ * @brief Report a statement which allocated memory to the failure hook.
+ *
+ * Used by ERPC_ASSERT_NO_ALLOCATIONS().
+ *
+ * @param[in] statement Text of the statement.
+ * @param[in] file Source file of the check.
+ * @param[in] line Source line of the check.
+ * @param[in] allocations Count of blocks the statement allocated.
+ */
+void erpc_allocation_stats_fail(const char *statement, const char *file, uint32_t line, uint64_t allocations);
+
+#ifdef __cplusplus
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+namespace erpc {
+
+/*!
+ * @brief Tags allocations of the calling thread with a method while in scope.
+ *
+ * Client stubs and Server tag their calls by it, scopes nest.
+ */
+class AllocationTag
+{
+public:
+    /*!
+     * @brief Constructor, tags following allocations.
+     *
+     * @param[in] method Method hash.
+     */
+    explicit AllocationTag(uint32_t method)
+    : m_previous(erpc_allocation_stats_set_method(method))
+    {
+    }
+
+    /*!
+     * @brief Destructor, restores the previous tag.
+     */
+    ~AllocationTag(void) { (void)erpc_allocation_stats_set_method(m_previous); }
+
+protected:
+    uint32_t m_previous; /*!< Tag restored by the destructor. */
+
+private:
+    AllocationTag(const AllocationTag &other);            /*!< This is disabled. */
+    AllocationTag &operator=(const AllocationTag &other); /*!< This is disabled. */
+};
+
+/*!
+ * @brief Counts allocations of the calling thread from construction on.
+ *
+ * Used by tests to prove a steady-state path does not touch the heap:
+ * @code
+ * AllocationScope scope;
+ * client_call(...);
+ * EXPECT_EQ(scope.getAllocations(), 0U);
+ * @endcode
+ */
+class AllocationScope
+{
+public:
+    /*!
+     * @brief Constructor, starts counting.
+     */
+    AllocationScope(void) { erpc_allocation_stats_thread(&m_start); }
+
+    /*!
+     * @brief Return count of blocks allocated since construction.
+     */
+    uint64_t getAllocations(void) const
+    {
+        erpc_allocation_stats_t now;
+        erpc_allocation_stats_thread(&now);
+        return now.allocations - m_start.allocations;
+    }
+
+    /*!
+     * @brief Return count of bytes allocated since construction.
+     */
+    uint64_t getBytes(void) const
+    {
+        erpc_allocation_stats_t now;
+        erpc_allocation_stats_thread(&now);
+        return now.bytes - m_start.bytes;
+    }
+
+protected:
+    erpc_allocation_stats_t m_start; /*!< Counters at construction. */
+};
+
+} // namespace erpc
+
+/*!
+ * @brief Check that a statement makes no heap allocation on the calling thread.
+ *
+ * A statement which allocates is reported by erpc_allocation_stats_fail(), also in builds with
+ * NDEBUG. The statement may contain commas.
+ *
+ * @param[in] ... Statement to run.
+ */
+#define ERPC_ASSERT_NO_ALLOCATIONS(...)                                                                            \
+    do                                                                                                             \
+    {                                                                                                              \
+        erpc::AllocationScope erpcAllocationScope_;                                                                \
+        __VA_ARGS__;                                                                                               \
+        uint64_t erpcAllocations_ = erpcAllocationScope_.getAllocations();                                         \
+        if (erpcAllocations_ != 0U)                                                                                \
+        {                                                                                                          \
+            erpc_allocation_stats_fail(#__VA_ARGS__, __FILE__, static_cast<uint32_t>(__LINE__), erpcAllocations_); \
+        }                                                                                                          \
+    } while (0)
+
+#endif // __cplusplus
+
+#endif // ERPC_ALLOCATION_STATS
+
+/*! @} */
+
+#endif // _EMBEDDED_RPC__ALLOCATION_STATS_H_
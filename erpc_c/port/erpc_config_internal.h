@@ -136,6 +136,114 @@
     #define ERPC_DEFAULT_BUFFERS_COUNT (2U)
 #endif
 
+// Set default count of pending channels the server inspects when picking the next message.
+#if !defined(ERPC_PENDING_CHANNELS_COUNT)
+    //! @brief Count of pending channels SimpleServer compares by priority in poll().
+    #define ERPC_PENDING_CHANNELS_COUNT (8U)
+#endif
+
+// Set default count of channels a framed transport records as waiting to send.
+#if !defined(ERPC_WAITING_SENDERS_COUNT)
+    //! @brief Count of channels FramedTransport holds lower priorities back for.
+    #define ERPC_WAITING_SENDERS_COUNT (8U)
+#endif
+
+// Set default count of frames the queued transport can hold.
+#if !defined(ERPC_QUEUED_TRANSPORT_SLOTS_COUNT)
+    //! @brief Count of frames QueuedTransport can hold, must be a power of two.
+    #define ERPC_QUEUED_TRANSPORT_SLOTS_COUNT (8U)
+#endif
+
+// Set default count of calls one client batch can hold.
+#if !defined(ERPC_BATCH_MAX_CALLS)
+    //! @brief Count of calls collected between erpc_batch_begin() and erpc_batch_commit().
+    #define ERPC_BATCH_MAX_CALLS (16U)
+#endif
+
+// Set default codec of the setup code.
+#if !defined(ERPC_CODEC)
+    //! @brief Codec created by the client and server setup code.
+    #define ERPC_CODEC (ERPC_CODEC_BASIC)
+#endif
+
+// BasicCodec payload is in host byte order unless big-endian hosts opt in to swapping.
+#if !defined(ERPC_CODEC_BYTE_SWAP)
+    //! @brief Swap multi-byte values between host and wire byte order.
+    #define ERPC_CODEC_BYTE_SWAP (0U)
+#endif
+
+// Set default version of the message and frame headers.
+#if !defined(ERPC_HEADER_VERSION)
+    //! @brief Version of the headers new codecs and FramedTransport write.
+    #define ERPC_HEADER_VERSION (1U)
+#endif
+
+// Disable COBS framing by default.
+#if !defined(ERPC_COBS_FRAMING)
+    #define ERPC_COBS_FRAMING (ERPC_COBS_FRAMING_DISABLED)
+#endif
+
+// Enable the server arena by default.
+#if !defined(ERPC_SERVER_ARENA)
+    #define ERPC_SERVER_ARENA (ERPC_SERVER_ARENA_ENABLED)
+#endif
+
+// Set default size of the server arena.
+#if !defined(ERPC_SERVER_ARENA_SCALE)
+    //! @brief Size of the server arena as multiple of the received message length.
+    #define ERPC_SERVER_ARENA_SCALE (2U)
+#endif
+
+// Disable latency histograms by default.
+#if !defined(ERPC_LATENCY_STATS)
+    #define ERPC_LATENCY_STATS (ERPC_LATENCY_STATS_DISABLED)
+#endif
+
+// Set default count of methods with latency histograms.
+#if !defined(ERPC_LATENCY_STATS_METHODS)
+    //! @brief Count of methods the latency histograms are kept for.
+    #define ERPC_LATENCY_STATS_METHODS (16U)
+#endif
+
+// Disable event tracing by default.
+#if !defined(ERPC_TRACE)
+    #define ERPC_TRACE (ERPC_TRACE_DISABLED)
+#endif
+
+// Set default size of the trace ring buffers.
+#if !defined(ERPC_TRACE_EVENTS)
+    //! @brief Count of events each traced thread keeps, must be a power of two.
+    #define ERPC_TRACE_EVENTS (4096U)
+#endif
+
+// Set default count of traced threads.
+#if !defined(ERPC_TRACE_THREADS)
+    //! @brief Count of threads with a trace ring buffer.
+    #define ERPC_TRACE_THREADS (8U)
+#endif
+
+// Disable transport statistics by default.
+#if !defined(ERPC_TRANSPORT_STATS)
+    #define ERPC_TRANSPORT_STATS (ERPC_TRANSPORT_STATS_DISABLED)
+#endif
+
+// Set default count of channels with own transport statistics.
+#if !defined(ERPC_TRANSPORT_STATS_CHANNELS)
+    //! @brief Count of channels each transport keeps statistics for.
+    #define ERPC_TRANSPORT_STATS_CHANNELS (8U)
+#endif
+
+// Disable allocation accounting by default.
+#if !defined(ERPC_ALLOCATION_STATS)
+    #define ERPC_ALLOCATION_STATS (ERPC_ALLOCATION_STATS_DISABLED)
+#endif
+
+// Set default count of methods with own allocation counters.
+#if !defined(ERPC_ALLOCATION_STATS_METHODS)
+    //! @brief Count of methods the allocation counters are kept for.
+    #define ERPC_ALLOCATION_STATS_METHODS (16U)
+#endif
+
 // Disable/enable noexcept.
 #if !defined(ERPC_NOEXCEPT)
     #if ERPC_HAS_POSIX
@@ -175,6 +283,29 @@
     #define ERPC_MESSAGE_LOGGING (ERPC_MESSAGE_LOGGING_DISABLED)
 #endif
 
+// Log messages synchronously by default.
+#if !defined(ERPC_MESSAGE_LOGGING_ASYNC)
+    #define ERPC_MESSAGE_LOGGING_ASYNC (ERPC_MESSAGE_LOGGING_ASYNC_DISABLED)
+#endif
+
+// Set default count of messages queued for the logging thread.
+#if !defined(ERPC_MESSAGE_LOGGING_SLOTS)
+    //! @brief Count of messages queued for the logging thread, must be a power of two.
+    #define ERPC_MESSAGE_LOGGING_SLOTS (16U)
+#endif
+
+// Set default priority of the logging thread.
+#if !defined(ERPC_MESSAGE_LOGGING_THREAD_PRIORITY)
+    //! @brief Priority of the thread writing logged messages.
+    #define ERPC_MESSAGE_LOGGING_THREAD_PRIORITY (0U)
+#endif
+
+// Set default stack size of the logging thread.
+#if !defined(ERPC_MESSAGE_LOGGING_THREAD_STACK_SIZE)
+    //! @brief Stack size of the thread writing logged messages, ignored by pthreads.
+    #define ERPC_MESSAGE_LOGGING_THREAD_STACK_SIZE (1024U)
+#endif
+
 #if defined(__CC_ARM) || defined(__ARMCC_VERSION) /* Keil MDK */
 #define THROW_BADALLOC throw(std::bad_alloc)
 #define THROW throw()
@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include "erpc_allocation_stats.h"
 #include "erpc_port.h"
 
 #include <new>
@@ -58,13 +59,21 @@ void operator delete[](void *ptr) THROW
 
 void *erpc_malloc(size_t size)
 {
+#if ERPC_ALLOCATION_STATS
+    void *p = erpc_allocation_stats_allocated(MEM_BufferAllocForever(erpc_allocation_stats_block_size(size), 0), size);
+#else
     void *p = MEM_BufferAllocForever(size, 0);
+#endif
     return p;
 }
 
 void erpc_free(void *ptr)
 {
+#if ERPC_ALLOCATION_STATS
+    MEM_BufferFree(erpc_allocation_stats_freeing(ptr));
+#else
     MEM_BufferFree(ptr);
+#endif
 }
 
 /* Provide function for pure virtual call to avoid huge demangling code being linked in ARM GCC */
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include "erpc_allocation_stats.h"
 #include "erpc_port.h"
 
 #include <new>
@@ -56,13 +57,21 @@ void operator delete[](void *ptr) THROW
 
 void *erpc_malloc(size_t size)
 {
+#if ERPC_ALLOCATION_STATS
+    void *p = erpc_allocation_stats_allocated(_mem_alloc_system(erpc_allocation_stats_block_size(size)), size);
+#else
     void *p = _mem_alloc_system(size);
+#endif
     return p;
 }
 
 void erpc_free(void *ptr)
 {
+#if ERPC_ALLOCATION_STATS
+    _mem_free(erpc_allocation_stats_freeing(ptr));
+#else
     _mem_free(ptr);
+#endif
 }
 
 /* Provide function for pure virtual call to avoid huge demangling code being linked in ARM GCC */
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include "erpc_allocation_stats.h"
 #include "erpc_port.h"
 
 #include <new>
@@ -55,13 +56,21 @@ void operator delete[](void *ptr) THROW
 
 void *erpc_malloc(size_t size)
 {
+#if ERPC_ALLOCATION_STATS
+    void *p = erpc_allocation_stats_allocated(malloc(erpc_allocation_stats_block_size(size)), size);
+#else
     void *p = malloc(size);
+#endif
     return p;
 }
 
 void erpc_free(void *ptr)
 {
+#if ERPC_ALLOCATION_STATS
+    free(erpc_allocation_stats_freeing(ptr));
+#else
     free(ptr);
+#endif
 }
 
 /* Provide function for pure virtual call to avoid huge demangling code being linked in ARM GCC */
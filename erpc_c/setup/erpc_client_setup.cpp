@@ -10,7 +10,11 @@
 
 #include "erpc_client_setup.h"
 
+#if ERPC_CODEC == ERPC_CODEC_COMPACT
+#include "erpc_compact_codec.h"
+#else
 #include "erpc_basic_codec.h"
+#endif
 #include "erpc_client_manager.h"
 #include "erpc_crc16.h"
 #include "erpc_manually_constructed.h"
@@ -37,7 +41,11 @@ using namespace erpc;
 ERPC_MANUALLY_CONSTRUCTED_ARRAY(ClientManager, s_clients, ERPC_CLIENT_COUNT);
 ClientManager* g_clients[ERPC_CLIENT_COUNT] = { nullptr };
 // #pragma weak g_client0
+#if ERPC_CODEC == ERPC_CODEC_COMPACT
+ERPC_MANUALLY_CONSTRUCTED_ARRAY(CompactCodecFactory, s_codecFactorys, ERPC_CLIENT_COUNT);
+#else
 ERPC_MANUALLY_CONSTRUCTED_ARRAY(BasicCodecFactory, s_codecFactorys, ERPC_CLIENT_COUNT);
+#endif
 ERPC_MANUALLY_CONSTRUCTED_ARRAY(Crc16, s_crc16s, ERPC_CLIENT_COUNT);
 static size_t clientCounter = 0;
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +102,26 @@ void erpc_client_set_error_handler(size_t id, client_error_handler_t error_handl
 
 void erpc_client_set_crc(size_t id, uint32_t crcStart) { s_crc16s[id]->setCrcStart(crcStart); }
 
+void erpc_client_set_decode_storage(size_t id, void *buffer, uint32_t size) {
+    if (g_clients[id] != NULL) {
+        g_clients[id]->setDecodeStorage(buffer, size);
+    }
+}
+
+erpc_status_t erpc_batch_begin(size_t id) {
+    if (g_clients[id] == NULL) {
+        return kErpcStatus_InvalidArgument;
+    }
+    return g_clients[id]->beginBatch();
+}
+
+erpc_status_t erpc_batch_commit(size_t id) {
+    if (g_clients[id] == NULL) {
+        return kErpcStatus_InvalidArgument;
+    }
+    return g_clients[id]->commitBatch();
+}
+
 #if ERPC_NESTED_CALLS
 void erpc_client_set_server(erpc_server_t server) {
     if (g_client != NULL) {
@@ -109,17 +137,23 @@ void erpc_client_set_server_thread_id(void* serverThreadId) {
 #endif
 
 #if ERPC_MESSAGE_LOGGING
-bool erpc_client_add_message_logger(erpc_transport_t transport) {
+bool erpc_client_add_message_logger(size_t id, erpc_transport_t transport) {
     bool retVal;
 
-    if (g_client == NULL) {
+    if (g_clients[id] == NULL) {
         retVal = false;
     } else {
-        retVal = g_client->addMessageLogger(reinterpret_cast<Transport*>(transport));
+        retVal = g_clients[id]->addMessageLogger(reinterpret_cast<Transport*>(transport));
     }
 
     return retVal;
 }
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+uint32_t erpc_client_get_dropped_log_messages(size_t id) {
+    return (g_clients[id] != NULL) ? g_clients[id]->getDroppedLogMessages() : 0U;
+}
+#endif
 #endif
 
 #if ERPC_PRE_POST_ACTION
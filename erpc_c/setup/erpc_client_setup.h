@@ -76,6 +76,45 @@ void erpc_client_set_error_handler(size_t, client_error_handler_t error_handler)
  */
 void erpc_client_set_crc(size_t, uint32_t crcStart);
 
+/*!
+ * @brief Decode out data of replies into caller-provided storage instead of erpc_malloc().
+ *
+ * The storage is reused by every call of the client. It is reset once per call, when a call
+ * starts while no other call of the client is outstanding. Out data must therefore be used or
+ * copied before the next call and must not be freed. Overlapping calls, like the calls of a
+ * batch, share the storage until the last of them finished. A reply which doesn't fit fails
+ * with kErpcStatus_BufferOverrun.
+ *
+ * @param[in] id Client id.
+ * @param[in] buffer Storage, NULL goes back to erpc_malloc().
+ * @param[in] size Size of the storage in bytes.
+ */
+void erpc_client_set_decode_storage(size_t id, void *buffer, uint32_t size);
+
+/*!
+ * @brief Start collecting calls of the client into one batch request.
+ *
+ * Stubs called afterwards only append their request. Stubs with a reply keep returning
+ * invalid results until the batch is committed and its reply arrived, then each of them
+ * returns its own result on the next call.
+ *
+ * @param[in] id Client id.
+ *
+ * @return kErpcStatus_Success or reason why the batch could not be started.
+ */
+erpc_status_t erpc_batch_begin(size_t id);
+
+/*!
+ * @brief Send the batch request and receive the batched reply.
+ *
+ * Call repeatedly while it returns kErpcStatus_Pending.
+ *
+ * @param[in] id Client id.
+ *
+ * @return kErpcStatus_Success, kErpcStatus_Pending or error of the batch.
+ */
+erpc_status_t erpc_batch_commit(size_t id);
+
 #if ERPC_NESTED_CALLS
 /*!
  * @brief This function sets server object for handling nested eRPC calls.
@@ -96,12 +135,24 @@ void erpc_client_set_server_thread_id(void *serverThreadId);
 /*!
  * @brief This function adds transport object for logging send/receive messages.
  *
+ * @param[in] id Client id.
  * @param[in] transport Initiated transport.
  *
  * @retval True When transport was successfully added.
  * @retval False When transport wasn't added.
  */
-bool erpc_client_add_message_logger(erpc_transport_t transport);
+bool erpc_client_add_message_logger(size_t id, erpc_transport_t transport);
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+/*!
+ * @brief This function returns count of messages the loggers of a client missed.
+ *
+ * @param[in] id Client id.
+ *
+ * @return Count of messages dropped because the logging queue was full or a logger failed.
+ */
+uint32_t erpc_client_get_dropped_log_messages(size_t id);
+#endif
 #endif
 
 #if ERPC_PRE_POST_ACTION
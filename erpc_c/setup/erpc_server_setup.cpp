@@ -10,7 +10,11 @@
 
 #include "erpc_server_setup.h"
 
+#if ERPC_CODEC == ERPC_CODEC_COMPACT
+#include "erpc_compact_codec.h"
+#else
 #include "erpc_basic_codec.h"
+#endif
 #include "erpc_crc16.h"
 #include "erpc_manually_constructed.h"
 #include "erpc_message_buffer.h"
@@ -32,7 +36,11 @@ using namespace erpc;
 // SimpleServer *g_server = NULL;
 ERPC_MANUALLY_CONSTRUCTED_ARRAY(SimpleServer, s_servers, ERPC_SERVER_COUNT);
 SimpleServer* g_servers[ERPC_SERVER_COUNT] = {nullptr};
+#if ERPC_CODEC == ERPC_CODEC_COMPACT
+ERPC_MANUALLY_CONSTRUCTED_ARRAY(CompactCodecFactory, s_codecFactorys, ERPC_SERVER_COUNT);
+#else
 ERPC_MANUALLY_CONSTRUCTED_ARRAY(BasicCodecFactory, s_codecFactorys, ERPC_SERVER_COUNT);
+#endif
 ERPC_MANUALLY_CONSTRUCTED_ARRAY(Crc16, s_crc16s, ERPC_SERVER_COUNT);
 static size_t serverCount = 0;
 
@@ -202,21 +210,28 @@ void erpc_server_stop(size_t id)
 }
 
 #if ERPC_MESSAGE_LOGGING
-bool erpc_server_add_message_logger(erpc_transport_t transport)
+bool erpc_server_add_message_logger(size_t id, erpc_transport_t transport)
 {
     bool retVal;
 
-    if (g_server == NULL)
+    if (g_servers[id] == NULL)
     {
         retVal = false;
     }
     else
     {
-        retVal = g_server->addMessageLogger(reinterpret_cast<Transport *>(transport));
+        retVal = g_servers[id]->addMessageLogger(reinterpret_cast<Transport *>(transport));
     }
 
     return retVal;
 }
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+uint32_t erpc_server_get_dropped_log_messages(size_t id)
+{
+    return (g_servers[id] != NULL) ? g_servers[id]->getDroppedLogMessages() : 0U;
+}
+#endif
 #endif
 
 #if ERPC_PRE_POST_ACTION
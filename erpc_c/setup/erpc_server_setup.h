@@ -129,12 +129,24 @@ void erpc_server_stop(size_t);
 /*!
  * @brief This function adds transport object for logging send/receive messages.
  *
+ * @param[in] id Server id.
  * @param[in] transport Initiated transport.
  *
  * @retval True When transport was successfully added.
  * @retval False When transport wasn't added.
  */
-bool erpc_server_add_message_logger(erpc_transport_t transport);
+bool erpc_server_add_message_logger(size_t id, erpc_transport_t transport);
+
+#if ERPC_MESSAGE_LOGGING_ASYNC
+/*!
+ * @brief This function returns count of messages the loggers of a server missed.
+ *
+ * @param[in] id Server id.
+ *
+ * @return Count of messages dropped because the logging queue was full or a logger failed.
+ */
+uint32_t erpc_server_get_dropped_log_messages(size_t id);
+#endif
 #endif
 
 #if ERPC_PRE_POST_ACTION
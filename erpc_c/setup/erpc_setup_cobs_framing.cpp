@@ -0,0 +1,27 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_framed_transport.h"
+#include "erpc_transport_setup.h"
+
+#include <cassert>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+#if ERPC_COBS_FRAMING
+void erpc_transport_cobs_framing_enable(erpc_transport_t transport)
+{
+    assert(transport);
+
+    reinterpret_cast<FramedTransport *>(transport)->setFraming(FramedTransport::kFramingCobs);
+}
+#endif
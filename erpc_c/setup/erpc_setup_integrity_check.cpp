@@ -0,0 +1,69 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc32c.h"
+#include "erpc_manually_constructed.h"
+#include "erpc_transport.h"
+#include "erpc_transport_setup.h"
+
+#include <cassert>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+// Checks keep no state, all transports can share them.
+ERPC_MANUALLY_CONSTRUCTED(IntegrityNone, s_integrityNone);
+ERPC_MANUALLY_CONSTRUCTED(Crc16, s_crc16);
+ERPC_MANUALLY_CONSTRUCTED(Crc32c, s_crc32c);
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+erpc_status_t erpc_transport_set_integrity_check(erpc_transport_t transport, erpc_integrity_check_t check)
+{
+    assert(transport);
+
+    Transport *castedTransport = reinterpret_cast<Transport *>(transport);
+    IntegrityCheck *integrity;
+
+    switch (check)
+    {
+        case kErpcIntegrityCheckNone:
+            if (!s_integrityNone.isUsed())
+            {
+                s_integrityNone.construct();
+            }
+            integrity = s_integrityNone.get();
+            break;
+        case kErpcIntegrityCheckCrc32c:
+            if (!s_crc32c.isUsed())
+            {
+                s_crc32c.construct();
+            }
+            integrity = s_crc32c.get();
+            break;
+        default:
+            // Keep the transport's own Crc16, it may have a custom start value (erpc_client_set_crc()).
+            integrity = castedTransport->getCrc16();
+            if (integrity == NULL)
+            {
+                if (!s_crc16.isUsed())
+                {
+                    s_crc16.construct();
+                }
+                integrity = s_crc16.get();
+            }
+            break;
+    }
+
+    return castedTransport->setIntegrityCheck(integrity);
+}
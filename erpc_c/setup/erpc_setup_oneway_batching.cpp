@@ -0,0 +1,42 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_manually_constructed.h"
+#include "erpc_oneway_batching_transport.h"
+#include "erpc_transport_setup.h"
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+ERPC_MANUALLY_CONSTRUCTED(OnewayBatchingTransport, s_transport);
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+erpc_transport_t erpc_transport_oneway_batching_init(erpc_transport_t transport, uint16_t flushThreshold)
+{
+    erpc_transport_t batchingTransport = NULL;
+
+    if (transport != NULL)
+    {
+        s_transport.construct(reinterpret_cast<Transport *>(transport));
+        s_transport->setFlushThreshold(flushThreshold);
+        batchingTransport = reinterpret_cast<erpc_transport_t>(s_transport.get());
+    }
+
+    return batchingTransport;
+}
+
+void erpc_transport_oneway_batching_set_time_budget(uint32_t budget, uint32_t (*clock)(void))
+{
+    s_transport->setTimeBudget(budget, clock);
+}
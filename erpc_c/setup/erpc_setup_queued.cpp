@@ -0,0 +1,36 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_manually_constructed.h"
+#include "erpc_queued_transport.h"
+#include "erpc_transport_setup.h"
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+ERPC_MANUALLY_CONSTRUCTED(QueuedTransport, s_transport);
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+erpc_transport_t erpc_transport_queued_init(erpc_transport_t transport)
+{
+    erpc_transport_t queuedTransport = NULL;
+
+    if (transport != NULL)
+    {
+        s_transport.construct(reinterpret_cast<Transport *>(transport));
+        queuedTransport = reinterpret_cast<erpc_transport_t>(s_transport.get());
+    }
+
+    return queuedTransport;
+}
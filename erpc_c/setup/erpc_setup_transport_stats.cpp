@@ -0,0 +1,43 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_transport.h"
+#include "erpc_transport_setup.h"
+
+#include <cassert>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+#if ERPC_TRANSPORT_STATS
+bool erpc_transport_get_stats(erpc_transport_t transport, uint32_t channel, erpc_transport_stats_t *stats)
+{
+    assert(transport);
+    assert(stats);
+
+    return reinterpret_cast<Transport *>(transport)->getStats().read(channel, stats);
+}
+
+uint32_t erpc_transport_get_channel_stats(erpc_transport_t transport, erpc_transport_stats_t *stats,
+                                          uint32_t capacity)
+{
+    assert(transport);
+
+    return reinterpret_cast<Transport *>(transport)->getStats().readChannels(stats, capacity);
+}
+
+void erpc_transport_reset_stats(erpc_transport_t transport)
+{
+    assert(transport);
+
+    reinterpret_cast<Transport *>(transport)->getStats().reset();
+}
+#endif
@@ -11,6 +11,9 @@
 #ifndef _ERPC_TRANSPORT_SETUP_H_
 #define _ERPC_TRANSPORT_SETUP_H_
 
+#include "erpc_common.h"
+#include "erpc_transport_stats.h"
+
 /*!
  * @addtogroup transport_setup
  * @{
@@ -25,6 +28,13 @@
 typedef struct ErpcTransport *erpc_transport_t;
 //! @brief Ready callback object type for RPMsg-Lite transport.
 typedef void (*rpmsg_ready_cb)(void);
+//! @brief Integrity check of frames, see erpc_transport_set_integrity_check().
+typedef enum erpc_integrity_check_t
+{
+    kErpcIntegrityCheckCrc16,  /*!< CRC-16 CCITT, the default. */
+    kErpcIntegrityCheckCrc32c, /*!< CRC-32C, hardware accelerated where available. */
+    kErpcIntegrityCheckNone,   /*!< No check, for reliable links like TCP on loopback. */
+} erpc_integrity_check_t;
 
 ////////////////////////////////////////////////////////////////////////////////
 // API
@@ -332,6 +342,125 @@ erpc_transport_t erpc_transport_tcp_init(const char *host, uint16_t port, bool i
 void erpc_transport_tcp_close(void);
 //@}
 
+//! @name Oneway batching transport setup
+//@{
+
+/*!
+ * @brief Wrap a transport so oneway messages are coalesced into one frame.
+ *
+ * Oneway messages are collected in a batch which is sent when it reaches
+ * @a flushThreshold bytes, when any other message is sent or on flush.
+ *
+ * @param[in] transport Transport which sends the batches.
+ * @param[in] flushThreshold Batch size in bytes which triggers sending.
+ *
+ * @return Return NULL or erpc_transport_t instance pointer.
+ */
+erpc_transport_t erpc_transport_oneway_batching_init(erpc_transport_t transport, uint16_t flushThreshold);
+
+/*!
+ * @brief Limit how long oneway messages may wait in a batch.
+ *
+ * @param[in] budget Time budget in ticks of @a clock.
+ * @param[in] clock Function returning current time, NULL disables the time budget.
+ */
+void erpc_transport_oneway_batching_set_time_budget(uint32_t budget, uint32_t (*clock)(void));
+//@}
+
+//! @name Queued transport setup
+//@{
+
+/*!
+ * @brief Wrap a transport with a lock-free send queue.
+ *
+ * Threads sending through the returned transport only copy their frame into the queue.
+ * One of them at a time writes all queued frames into @a transport.
+ *
+ * @param[in] transport Transport which is written by the queue writer.
+ *
+ * @return Return NULL or erpc_transport_t instance pointer.
+ */
+erpc_transport_t erpc_transport_queued_init(erpc_transport_t transport);
+//@}
+
+//! @name COBS framing setup
+//@{
+
+/*!
+ * @brief Switch a framed transport (serial, TCP, UART, SPI, ...) to COBS framing.
+ *
+ * Requires ERPC_COBS_FRAMING enabled. Both sides have to switch before the first message.
+ *
+ * @param[in] transport Transport derived from FramedTransport.
+ */
+void erpc_transport_cobs_framing_enable(erpc_transport_t transport);
+//@}
+
+//! @name Integrity check setup
+//@{
+
+/*!
+ * @brief Select the integrity check computed over each frame of a framed transport.
+ *
+ * erpc_client_init() and erpc_server_init() set CRC-16, call this afterwards. Both sides
+ * have to select the same check, frames with another one are rejected. Selecting CRC-16
+ * goes back to the Crc16 set up by the init function, with the start value of
+ * erpc_client_set_crc() or erpc_server_set_crc(). The legacy frame header (ERPC_HEADER_VERSION 1)
+ * carries only 16 bits and no check id, CRC-32C needs ERPC_HEADER_VERSION 2 or COBS framing.
+ *
+ * @param[in] transport Transport derived from FramedTransport, or a wrapper of it.
+ * @param[in] check Integrity check to use.
+ *
+ * @retval kErpcStatus_Success The check is used.
+ * @retval kErpcStatus_InvalidArgument The frames cannot carry the check, the previous one is kept.
+ */
+erpc_status_t erpc_transport_set_integrity_check(erpc_transport_t transport, erpc_integrity_check_t check);
+//@}
+
+//! @name Transport statistics
+//@{
+
+/*!
+ * @brief Read counters of a transport.
+ *
+ * Requires ERPC_TRANSPORT_STATS enabled. Framed transports (TCP, serial, ...) and
+ * FastTransport count, wrappers like the queued or batching transport don't, pass the
+ * transport they wrap instead.
+ *
+ * @param[in] transport Transport to read.
+ * @param[in] channel Channel hash, 0 for the totals of all channels.
+ * @param[out] stats Counters.
+ *
+ * @retval true Counters were read.
+ * @retval false The channel has not been counted separately, e.g. because the table of
+ *  ERPC_TRANSPORT_STATS_CHANNELS channels is full.
+ */
+bool erpc_transport_get_stats(erpc_transport_t transport, uint32_t channel, erpc_transport_stats_t *stats);
+
+/*!
+ * @brief Read counters of every channel a transport counts separately.
+ *
+ * Requires ERPC_TRANSPORT_STATS enabled.
+ *
+ * @param[in] transport Transport to read.
+ * @param[out] stats Array the counters are written to.
+ * @param[in] capacity Count of entries the array holds.
+ *
+ * @return Count of entries written.
+ */
+uint32_t erpc_transport_get_channel_stats(erpc_transport_t transport, erpc_transport_stats_t *stats,
+                                          uint32_t capacity);
+
+/*!
+ * @brief Clear all counters of a transport.
+ *
+ * Requires ERPC_TRANSPORT_STATS enabled.
+ *
+ * @param[in] transport Transport to clear.
+ */
+void erpc_transport_reset_stats(erpc_transport_t transport);
+//@}
+
 //! @name USB CDC transport setup
 //@{
 
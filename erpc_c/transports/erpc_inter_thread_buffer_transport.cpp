@@ -39,9 +39,10 @@ void InterThreadBufferTransport::linkWithPeer(InterThreadBufferTransport *peer)
     }
 }
 
-erpc_status_t InterThreadBufferTransport::receive(MessageBuffer *message)
+erpc_status_t InterThreadBufferTransport::receive(const Hash &channel, MessageBuffer *message)
 {
     assert(m_state && m_peer);
+    (void)channel;
 
     m_inSem.get();
 
@@ -58,9 +59,10 @@ erpc_status_t InterThreadBufferTransport::receive(MessageBuffer *message)
     return kErpcStatus_Success;
 }
 
-erpc_status_t InterThreadBufferTransport::send(MessageBuffer *message)
+erpc_status_t InterThreadBufferTransport::send(const Hash &channel, MessageBuffer *message)
 {
     assert(m_state && m_peer);
+    (void)channel;
 
     m_peer->m_outSem.get();
 
@@ -72,5 +74,9 @@ erpc_status_t InterThreadBufferTransport::send(MessageBuffer *message)
 
     m_state->m_mutex.unlock();
 
+    // The peer copies the message, wait for it so the caller may dispose of the buffer.
+    m_peer->m_outSem.get();
+    m_peer->m_outSem.put();
+
     return kErpcStatus_Success;
 }
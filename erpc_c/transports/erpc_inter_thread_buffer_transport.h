@@ -37,7 +37,8 @@ namespace erpc {
  *
  * Only a single message may be pending for each of the two threads. If a message is
  * pending for a thread and another is sent, then the sender will block until the
- * currently pending message is received.
+ * currently pending message is received. send() returns once the message was received, then
+ * the buffer may be reused or disposed of.
  *
  * @ingroup itbp_transport
  */
@@ -57,8 +58,9 @@ public:
 
     void linkWithPeer(InterThreadBufferTransport *peer);
 
-    virtual erpc_status_t receive(MessageBuffer *message);
-    virtual erpc_status_t send(MessageBuffer *message);
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override;
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override;
+    virtual void flush(void) override {}
 
     virtual int32_t getAvailable(void) const { return 0; }
 
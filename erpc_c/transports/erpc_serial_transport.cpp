@@ -35,6 +35,7 @@ SerialTransport::SerialTransport(const char *portName, speed_t baudRate)
 , m_portName(portName)
 , m_baudRate(baudRate)
 {
+    setReceiveChunkSize(kStreamReceiveChunkSize);
 }
 
 SerialTransport::~SerialTransport(void)
@@ -14,6 +14,7 @@
 #include <err.h>
 #endif
 #include <errno.h>
+#include <limits>
 #include <netdb.h>
 #include <netinet/tcp.h>
 #include <signal.h>
@@ -48,6 +49,7 @@ TCPTransport::TCPTransport(bool isServer)
 , m_serverThread(serverThreadStub)
 , m_runServer(true)
 {
+    setReceiveChunkSize(kStreamReceiveChunkSize);
 }
 
 TCPTransport::TCPTransport(const char *host, uint16_t port, bool isServer)
@@ -58,6 +60,7 @@ TCPTransport::TCPTransport(const char *host, uint16_t port, bool isServer)
 , m_serverThread(serverThreadStub)
 , m_runServer(true)
 {
+    setReceiveChunkSize(kStreamReceiveChunkSize);
 }
 
 TCPTransport::~TCPTransport(void) {}
@@ -221,8 +224,9 @@ erpc_status_t TCPTransport::close(bool stopServer)
     return kErpcStatus_Success;
 }
 
-erpc_status_t TCPTransport::underlyingReceive(uint8_t *data, uint32_t size)
+erpc_status_t TCPTransport::underlyingReceive(const erpc::Hash &channel, uint8_t *data, uint32_t size)
 {
+    (void)channel;
     ssize_t length;
     erpc_status_t status = kErpcStatus_Success;
 
@@ -263,11 +267,50 @@ erpc_status_t TCPTransport::underlyingReceive(uint8_t *data, uint32_t size)
     return status;
 }
 
-erpc_status_t TCPTransport::underlyingSend(const uint8_t *data, uint32_t size)
+#if ERPC_COBS_FRAMING
+erpc_status_t TCPTransport::underlyingReceiveSome(const erpc::Hash &channel, uint8_t *data, uint32_t size,
+                                                  uint32_t *received)
 {
+    (void)channel;
+    ssize_t length;
     erpc_status_t status = kErpcStatus_Success;
+
+    // Block until we have a valid connection.
+    while (m_socket <= 0)
+    {
+        // Sleep 10 ms.
+        Thread::sleep(10000);
+    }
+
+    // A single read returns what has arrived so far.
+    length = read(m_socket, data, size);
+    if (length > 0)
+    {
+        *received = static_cast<uint32_t>(length);
+    }
+    else if (length == 0)
+    {
+        // close socket, not server
+        close(false);
+        status = kErpcStatus_ConnectionClosed;
+    }
+    else
+    {
+        status = kErpcStatus_ReceiveFailed;
+    }
+
+    return status;
+}
+#endif
+
+uint32_t TCPTransport::underlyingSend(const erpc::Hash &channel, const uint8_t *data, uint32_t size)
+{
+    erpc_status_t status = kErpcStatus_Success;
+    uint32_t length = size;
     ssize_t result;
 
+    (void)channel;
+
     if (m_socket <= 0)
     {
         // we should not pretend to have a succesful Send or we create a deadlock
@@ -301,7 +344,7 @@ erpc_status_t TCPTransport::underlyingSend(const uint8_t *data, uint32_t size)
         }
     }
 
-    return status;
+    return (status == kErpcStatus_Success) ? length : std::numeric_limits<uint32_t>::max();
 }
 
 void TCPTransport::serverThread(void)
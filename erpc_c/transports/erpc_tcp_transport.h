@@ -81,6 +81,11 @@ public:
      */
     virtual erpc_status_t close(bool stopServer = true);
 
+    /*!
+     * @brief Nothing to flush, underlyingSend() writes everything to the socket.
+     */
+    virtual void flush(void) override {}
+
 protected:
     bool m_isServer;       /*!< If true then server is using transport, else client. */
     const char *m_host;    /*!< Specify the host name or IP address of the computer. */
@@ -100,6 +105,7 @@ protected:
     /*!
      * @brief This function read data.
      *
+     * @param[in] channel Channel of the message, one socket carries all channels.
      * @param[inout] data Preallocated buffer for receiving data.
      * @param[in] size Size of data to read.
      *
@@ -107,19 +113,36 @@ protected:
      * @retval #kErpcStatus_ReceiveFailed When reading data ends with error.
      * @retval #kErpcStatus_ConnectionClosed Peer closed the connection.
      */
-    virtual erpc_status_t underlyingReceive(uint8_t *data, uint32_t size);
+    virtual erpc_status_t underlyingReceive(const erpc::Hash &channel, uint8_t *data, uint32_t size) override;
+
+#if ERPC_COBS_FRAMING
+    /*!
+     * @brief This function reads the data the socket has, at least one byte.
+     *
+     * @param[in] channel Channel of the message, one socket carries all channels.
+     * @param[inout] data Preallocated buffer for receiving data.
+     * @param[in] size Capacity of @a data.
+     * @param[out] received Count of bytes read.
+     *
+     * @retval #kErpcStatus_Success When data was read successfully.
+     * @retval #kErpcStatus_ReceiveFailed When reading data ends with error.
+     * @retval #kErpcStatus_ConnectionClosed Peer closed the connection.
+     */
+    virtual erpc_status_t underlyingReceiveSome(const erpc::Hash &channel, uint8_t *data, uint32_t size,
+                                                uint32_t *received) override;
+#endif
 
     /*!
      * @brief This function writes data.
      *
+     * @param[in] channel Channel of the message, one socket carries all channels.
      * @param[in] data Buffer to send.
      * @param[in] size Size of data to send.
      *
-     * @retval #kErpcStatus_Success When data was written successfully.
-     * @retval #kErpcStatus_SendFailed When writing data ends with error.
-     * @retval #kErpcStatus_ConnectionClosed Peer closed the connection.
+     * @return @a size when all data was written, std::numeric_limits<uint32_t>::max() on error or
+     *  when the peer closed the connection.
      */
-    virtual erpc_status_t underlyingSend(const uint8_t *data, uint32_t size);
+    virtual uint32_t underlyingSend(const erpc::Hash &channel, const uint8_t *data, uint32_t size) override;
 
     /*!
      * @brief Server thread function.
@@ -16,6 +16,7 @@
 #include "crc24.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <set>
 #include <sstream>
 
@@ -42,6 +43,15 @@ extern const char *const kCCrc;
 // number which makes list temporary variables unique.
 static uint8_t listCounter = 0;
 
+/*! @brief Longest message header: version, type, service, 32-bit id, varint sequence and deadline. */
+static const uint64_t kMaxMessageHeaderSize = 3U + 4U + 5U + 5U;
+
+/*! @brief Header of fast messages, only the service id. */
+static const uint64_t kFastMessageHeaderSize = 1U;
+
+/*! @brief Size of a shared pointer, its length byte and 64-bit address. */
+static const uint64_t kMaxSharedPointerSize = 1U + 8U;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -77,6 +87,8 @@ void CGenerator::generateOutputFiles(const string &fileName)
     generateServerSourceFile(fileName);
 
     generateCommonHeaderFiles(fileName);
+
+    generateSizesReportFile(fileName);
 }
 
 void CGenerator::generateTypesHeaderFile()
@@ -500,6 +512,7 @@ void CGenerator::generate()
         groupTemplate["includes"] = makeGroupIncludesTemplateData(group);
         groupTemplate["symbolsMap"] = makeGroupSymbolsTemplateData(group);
         groupTemplate["interfaces"] = makeGroupInterfacesTemplateData(group);
+        makeMessageSizesTemplateData(group, groupTemplate);
         groupTemplate["callbacks"] = makeGroupCallbacksTemplateData(group);
         group->setTemplate(groupTemplate);
 
@@ -1113,6 +1126,21 @@ data_map CGenerator::getStructDefinitionTemplateData(Group *group, StructType *s
     structInfo["genStructWrapperF"] = !isBinaryStruct(structType);
     structInfo["noSharedMem"] = (findAnnotation(structType, NO_SHARED_ANNOTATION) != nullptr);
 
+    // Structs laid out in memory as on the wire are copied in one shot.
+    uint32_t podSize = 0;
+    uint32_t podAlignment = 0;
+    uint32_t podOffset = 0;
+    string podReason;
+    bool isPodLayout = getPodLayout(structType, podSize, podAlignment, podReason);
+    if (!isPodLayout && findAnnotation(structType, PACKED_ANNOTATION))
+    {
+        throw semantic_error(format_string("line %d: Struct '%s' annotated @%s can't be copied in one shot, %s.",
+                                           structType->getFirstLine(), getOutputName(structType).c_str(),
+                                           PACKED_ANNOTATION, podReason.c_str()));
+    }
+    structInfo["isPod"] = isPodLayout && (m_def->getCodecType() == InterfaceDefinition::kBasicCodec);
+    structInfo["podSize"] = format_string("%uU", podSize);
+
     setTemplateComments(structType, structInfo);
 
     // set struct members template data
@@ -1164,6 +1192,14 @@ data_map CGenerator::getStructDefinitionTemplateData(Group *group, StructType *s
         member_info["structElements"] = "";
         member_info["structElementsCount"] = "";
         member_info["noSharedMem"] = (findAnnotation(member, NO_SHARED_ANNOTATION) != nullptr);
+        if (isPodLayout)
+        {
+            uint32_t memberSize;
+            uint32_t memberAlignment;
+            getPodLayout(dataType, memberSize, memberAlignment, podReason);
+            member_info["podOffset"] = format_string("%uU", podOffset);
+            podOffset += memberSize;
+        }
 
         if (isNullable)
         {
@@ -1391,6 +1427,7 @@ data_map CGenerator::getFunctionBaseTemplateData(Group *group, FunctionBase *fn)
     info["needTempVariableServer"] = false;
     info["needTempVariableClient"] = false;
     info["needNullVariableOnServer"] = false;
+    info["hasRetainedData"] = false;
 
     /* Is function declared as external? */
     info["isNonExternalFunction"] = !findAnnotation(fnSymbol, EXTERNAL_ANNOTATION);
@@ -1579,6 +1616,16 @@ data_map CGenerator::getFunctionBaseTemplateData(Group *group, FunctionBase *fn)
             }
         }
 
+        // Borrowed binary points into the received message, so it is neither allocated nor freed.
+        bool isBorrowed = (findAnnotation(param, BORROW_ANNOTATION) != nullptr);
+        if (isBorrowed && ((param->getDirection() != kInDirection) || !paramTrueType->isList() ||
+                           !isBinaryList(dynamic_cast<ListType *>(paramTrueType))))
+        {
+            throw semantic_error(format_string("line %d: Annotation @%s can be applied only for 'in' binary "
+                                               "parameter with @%s annotation.",
+                                               param->getFirstLine(), BORROW_ANNOTATION, LENGTH_ANNOTATION));
+        }
+
         paramInfo["mallocServer"] = firstAllocOnServerWhenIsNeed(name, param);
         setCallingFreeFunctions(param, paramInfo, false);
 
@@ -1622,8 +1669,16 @@ data_map CGenerator::getFunctionBaseTemplateData(Group *group, FunctionBase *fn)
         }
         params.push_back(paramInfo);
 
+        // Retained data outlives the call, so it can't be allocated from the server arena.
+        set<DataType *> retainDataTypes;
+        if (!generateServerFreeFunctions(param) || containsRetainedMember(paramType, retainDataTypes))
+        {
+            info["hasRetainedData"] = true;
+        }
+
         // Generating top of freeing functions in generated output.
-        bool l_generateServerFunctionParamFreeFunctions = (!isShared && generateServerFreeFunctions(param));
+        bool l_generateServerFunctionParamFreeFunctions =
+            (!isShared && !isBorrowed && generateServerFreeFunctions(param));
         if (l_generateServerFunctionParamFreeFunctions &&
             (isNeedCallFree(paramType) || paramInfo["firstFreeingCall1"]->getmap()["freeName"]->getvalue() != ""))
         {
@@ -1703,8 +1758,10 @@ data_map CGenerator::getFunctionTemplateData(Group *group, Function *fn)
     info["prototype2WithNamespace"] = getFunctionPrototypeWithClient(group, fn, getOutputName(fn), "remote::");
     info["name"] = getOutputName(fn);
     std::string specialProto = getFunctionPrototype(group, fn, "", true);
-    std::string hash = std::to_string(crc24_decode(specialProto));
+    uint32_t priority = getFunctionPriority(fn);
+    std::string hash = std::to_string(static_cast<uint32_t>(crc24_decode(specialProto)) | (priority << 24));
     info["id"] = hash;
+    info["priority"] = priority;
     info["ret"] = getFunctionDataType(group, fn);
     info["genericRetStruct"] = getOutputName(fn) + "Return";
 
@@ -2736,6 +2793,7 @@ void CGenerator::getEncodeDecodeBuiltin(Group *group, BuiltinType *t, data_map &
     if (t->isString())
     {
         templateData["checkStringNull"] = false;
+        templateData["stringCapacity"] = "";
         templateData["withoutAlloc"] = ((structMember->getDirection() == kInoutDirection) ||
                                         (structType && group->getSymbolDirections(structType).count(kInoutDirection))) ?
                                            true :
@@ -2760,6 +2818,8 @@ void CGenerator::getEncodeDecodeBuiltin(Group *group, BuiltinType *t, data_map &
                 if (structMember->getDirection() == kInoutDirection || structMember->getDirection() == kOutDirection)
                 {
                     templateData["withoutAlloc"] = true;
+                    // Client decodes into the caller's buffer, which holds max_length characters.
+                    templateData["stringCapacity"] = templateData["stringAllocSize"]->getvalue();
                 }
 
                 if (templateData["stringAllocSize"]->getvalue() == "")
@@ -2910,11 +2970,13 @@ data_map CGenerator::getEncodeDecodeCall(const string &name, Group *group, DataT
             templateData["decode"] = m_templateData["decodeArrayType"];
             templateData["encode"] = m_templateData["encodeArrayType"];
 
-            // To improve code serialization/deserialization for scalar types when BasicCodec is used.
-            templateData["builtinTypeName"] =
-                ((m_def->getCodecType() != InterfaceDefinition::kBasicCodec) || trueElementType->isBool()) ?
-                    "" :
-                    getScalarTypename(elementType);
+            // Arrays of fixed width scalars are coded by one codec call.
+            templateData["builtinTypeName"] = trueElementType->isBool() ? "" : getScalarTypename(elementType);
+            // Arrays of structs laid out as on the wire are copied in one shot.
+            templateData["podTypeName"] =
+                (trueElementType->isStruct() && isPodStruct(dynamic_cast<StructType *>(trueElementType))) ?
+                    getOutputName(trueElementType) :
+                    "";
 
             giveBracesToArrays(arrayName);
             templateData["forLoopCount"] = format_string("arrayCount%d", arrayCounter);
@@ -2996,11 +3058,13 @@ data_map CGenerator::getEncodeDecodeCall(const string &name, Group *group, DataT
             templateData["needFreeingCall"] =
                 (generateServerFreeFunctions(structMember) && isNeedCallFree(elementType));
 
-            // To improve code serialization/deserialization for scalar types when BasicCodec is used.
-            templateData["builtinTypeName"] =
-                ((m_def->getCodecType() != InterfaceDefinition::kBasicCodec) || trueElementType->isBool()) ?
-                    "" :
-                    getScalarTypename(elementType);
+            // Arrays of fixed width scalars are coded by one codec call.
+            templateData["builtinTypeName"] = trueElementType->isBool() ? "" : getScalarTypename(elementType);
+            // Arrays of structs laid out as on the wire are copied in one shot.
+            templateData["podTypeName"] =
+                (trueElementType->isStruct() && isPodStruct(dynamic_cast<StructType *>(trueElementType))) ?
+                    getOutputName(trueElementType) :
+                    "";
 
             if (generateServerFreeFunctions(structMember))
             {
@@ -3116,6 +3180,7 @@ data_map CGenerator::getEncodeDecodeCall(const string &name, Group *group, DataT
             }
             templateData["size"] = size;
             templateData["useBinaryCoder"] = isBinaryList(listType);
+            templateData["borrow"] = (isTopDataType && (findAnnotation(structMember, BORROW_ANNOTATION) != nullptr));
             templateData["protoNext"] = getEncodeDecodeCall(nextName, group, elementType, structType, true,
                                                             structMember, needTempVariable, isFunctionParam);
             break;
@@ -3655,6 +3720,39 @@ bool CGenerator::containsByrefParamToFree(DataType *dataType, set<DataType *> &d
     return false;
 }
 
+bool CGenerator::containsRetainedMember(DataType *dataType, set<DataType *> &dataTypes)
+{
+    // For loops from forward declaration detection.
+    if (dataTypes.insert(dataType).second)
+    {
+        DataType *trueDataType = dataType->getTrueContainerDataType();
+        StructType *members = nullptr;
+        if (trueDataType->isStruct())
+        {
+            members = dynamic_cast<StructType *>(trueDataType);
+        }
+        else if (trueDataType->isUnion())
+        {
+            UnionType *unionType = dynamic_cast<UnionType *>(trueDataType);
+            assert(unionType != nullptr);
+            members = &unionType->getUnionMembers();
+        }
+
+        if (members != nullptr)
+        {
+            for (StructMember *structMember : members->getMembers())
+            {
+                if (!generateServerFreeFunctions(structMember) ||
+                    containsRetainedMember(structMember->getDataType(), dataTypes))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 bool CGenerator::isListStruct(StructType *structType)
 {
     // if structure is transformed list<> to struct{list<>}
@@ -3668,6 +3766,574 @@ bool CGenerator::isListStruct(StructType *structType)
     return false;
 }
 
+bool CGenerator::getPodLayout(DataType *dataType, uint32_t &size, uint32_t &alignment, string &reason)
+{
+    DataType *trueDataType = dataType->getTrueDataType();
+
+    switch (trueDataType->getDataType())
+    {
+        case DataType::kBuiltinType: {
+            BuiltinType *builtinType = dynamic_cast<BuiltinType *>(trueDataType);
+            assert(builtinType);
+            switch (builtinType->getBuiltinType())
+            {
+                case BuiltinType::kInt8Type:
+                case BuiltinType::kUInt8Type:
+                    size = 1;
+                    break;
+                case BuiltinType::kInt16Type:
+                case BuiltinType::kUInt16Type:
+                    size = 2;
+                    break;
+                case BuiltinType::kInt32Type:
+                case BuiltinType::kUInt32Type:
+                case BuiltinType::kFloatType:
+                    size = 4;
+                    break;
+                case BuiltinType::kInt64Type:
+                case BuiltinType::kUInt64Type:
+                case BuiltinType::kDoubleType:
+                    size = 8;
+                    break;
+                default:
+                    reason = format_string("type '%s' has no fixed wire size", trueDataType->getName().c_str());
+                    return false;
+            }
+            alignment = size;
+            return true;
+        }
+        case DataType::kArrayType: {
+            ArrayType *arrayType = dynamic_cast<ArrayType *>(trueDataType);
+            assert(arrayType);
+            if (!getPodLayout(arrayType->getElementType(), size, alignment, reason))
+            {
+                return false;
+            }
+            size *= arrayType->getElementCount();
+            return true;
+        }
+        case DataType::kStructType: {
+            StructType *structType = dynamic_cast<StructType *>(trueDataType);
+            assert(structType);
+            if (isListStruct(structType) || isBinaryStruct(structType) ||
+                findAnnotation(structType, SHARED_ANNOTATION) || findAnnotation(structType, NO_SHARED_ANNOTATION))
+            {
+                reason = format_string("struct '%s' is not stored inline", getOutputName(structType).c_str());
+                return false;
+            }
+
+            size = 0;
+            alignment = 1;
+            for (StructMember *member : structType->getMembers())
+            {
+                uint32_t memberSize;
+                uint32_t memberAlignment;
+
+                if (member->isByref() || findAnnotation(member, NULLABLE_ANNOTATION) ||
+                    findAnnotation(member, SHARED_ANNOTATION) || findAnnotation(member, NO_SHARED_ANNOTATION))
+                {
+                    reason = format_string("member '%s' is not stored inline", member->getName().c_str());
+                    return false;
+                }
+                if (!getPodLayout(member->getDataType(), memberSize, memberAlignment, reason))
+                {
+                    reason = format_string("member '%s': %s", member->getName().c_str(), reason.c_str());
+                    return false;
+                }
+                if ((size % memberAlignment) != 0)
+                {
+                    reason = format_string("member '%s' is preceded by padding", member->getName().c_str());
+                    return false;
+                }
+                size += memberSize;
+                alignment = max(alignment, memberAlignment);
+            }
+
+            if ((size == 0) || ((size % alignment) != 0))
+            {
+                reason = format_string("struct '%s' ends with padding", getOutputName(structType).c_str());
+                return false;
+            }
+            return true;
+        }
+        default: {
+            reason = format_string("type '%s' has no fixed wire size", trueDataType->getName().c_str());
+            return false;
+        }
+    }
+}
+
+bool CGenerator::isPodStruct(StructType *structType)
+{
+    uint32_t size;
+    uint32_t alignment;
+    string reason;
+
+    return ((m_def->getCodecType() == InterfaceDefinition::kBasicCodec) &&
+            getPodLayout(structType, size, alignment, reason));
+}
+
+bool CGenerator::getAnnConstantValue(StructMember *structMember, StructType *structType, const string &name,
+                                     uint64_t &value)
+{
+    Annotation *ann = (structMember != nullptr) ? findAnnotation(structMember, name) : nullptr;
+    if (ann == nullptr || !ann->hasValue())
+    {
+        return false;
+    }
+
+    Value *annValue = ann->getValueObject();
+    if (annValue->getType() != kIntegerValue)
+    {
+        string annName = annValue->toString();
+
+        // Members and parameters hold run-time values.
+        if (structType != nullptr && structType->getScope().getSymbol(annName, false) != nullptr)
+        {
+            return false;
+        }
+
+        ConstType *constVar = dynamic_cast<ConstType *>(m_globals->getSymbol(annName));
+        if (constVar == nullptr || constVar->getValue() == nullptr ||
+            constVar->getValue()->getType() != kIntegerValue)
+        {
+            return false;
+        }
+        annValue = constVar->getValue();
+    }
+
+    IntegerValue *intValue = dynamic_cast<IntegerValue *>(annValue);
+    assert(intValue);
+    value = intValue->getValue();
+    return true;
+}
+
+bool CGenerator::getMaxEncodedSize(DataType *dataType, StructMember *structMember, StructType *structType,
+                                   bool isClientParam, set<DataType *> &dataTypes, uint64_t &size, string &reason)
+{
+    bool isCompact = (m_def->getCodecType() == InterfaceDefinition::kCompactCodec);
+    uint64_t lengthSize = isCompact ? 5U : 4U;
+    DataType *trueDataType = dataType->getTrueDataType();
+    string name = (structMember != nullptr) ? structMember->getName() : trueDataType->getName();
+
+    size = 0;
+
+    // Shared data are sent as an address, followed by members which are not shared.
+    if ((structMember && findAnnotation(structMember, SHARED_ANNOTATION)) ||
+        ((trueDataType->isStruct() || trueDataType->isUnion()) && findAnnotation(trueDataType, SHARED_ANNOTATION)))
+    {
+        size = kMaxSharedPointerSize;
+        if (trueDataType->isStruct())
+        {
+            StructType *sharedStruct = dynamic_cast<StructType *>(trueDataType);
+            assert(sharedStruct);
+            for (StructMember *member : sharedStruct->getMembers())
+            {
+                uint64_t memberSize;
+                if (findAnnotation(member, NO_SHARED_ANNOTATION) == nullptr)
+                {
+                    continue;
+                }
+                if (!getMaxEncodedSize(member->getDataType(), member, sharedStruct, false, dataTypes, memberSize,
+                                       reason))
+                {
+                    return false;
+                }
+                size += memberSize;
+            }
+        }
+        return true;
+    }
+
+    switch (trueDataType->getDataType())
+    {
+        case DataType::kBuiltinType: {
+            BuiltinType *builtinType = dynamic_cast<BuiltinType *>(trueDataType);
+            assert(builtinType);
+            switch (builtinType->getBuiltinType())
+            {
+                case BuiltinType::kBoolType:
+                case BuiltinType::kInt8Type:
+                case BuiltinType::kUInt8Type:
+                    size = 1U;
+                    break;
+                case BuiltinType::kInt16Type:
+                case BuiltinType::kUInt16Type:
+                    size = isCompact ? 3U : 2U;
+                    break;
+                case BuiltinType::kInt32Type:
+                case BuiltinType::kUInt32Type:
+                    size = isCompact ? 5U : 4U;
+                    break;
+                case BuiltinType::kFloatType:
+                    size = 4U;
+                    break;
+                case BuiltinType::kInt64Type:
+                case BuiltinType::kUInt64Type:
+                    size = isCompact ? 10U : 8U;
+                    break;
+                case BuiltinType::kDoubleType:
+                    size = 8U;
+                    break;
+                case BuiltinType::kStringType:
+                case BuiltinType::kUStringType: {
+                    uint64_t maxLength;
+                    if (!getAnnConstantValue(structMember, structType, MAX_LENGTH_ANNOTATION, maxLength))
+                    {
+                        reason = format_string("string '%s' has no constant @max_length", name.c_str());
+                        return false;
+                    }
+                    size = lengthSize + maxLength;
+                    break;
+                }
+                default:
+                    reason = format_string("type '%s' has no known wire size", trueDataType->getName().c_str());
+                    return false;
+            }
+            break;
+        }
+        case DataType::kEnumType: {
+            // Enum inout parameters are written through an int32 temporary by the client.
+            size = isClientParam ? lengthSize : 1U;
+            break;
+        }
+        case DataType::kArrayType: {
+            ArrayType *arrayType = dynamic_cast<ArrayType *>(trueDataType);
+            assert(arrayType);
+            DataType *elementType = arrayType->getElementType();
+            bool isStringElement = elementType->getTrueDataType()->isString();
+            if (!getMaxEncodedSize(elementType, isStringElement ? structMember : nullptr, structType, false,
+                                   dataTypes, size, reason))
+            {
+                return false;
+            }
+            size *= arrayType->getElementCount();
+            break;
+        }
+        case DataType::kListType: {
+            ListType *listType = dynamic_cast<ListType *>(trueDataType);
+            assert(listType);
+            uint64_t count;
+            if (!getAnnConstantValue(structMember, structType, MAX_LENGTH_ANNOTATION, count) &&
+                !getAnnConstantValue(structMember, structType, LENGTH_ANNOTATION, count))
+            {
+                reason = format_string("list '%s' has no constant @max_length", name.c_str());
+                return false;
+            }
+            DataType *elementType = listType->getElementType();
+            bool isStringElement = elementType->getTrueDataType()->isString();
+            uint64_t elementSize;
+            if (!getMaxEncodedSize(elementType, isStringElement ? structMember : nullptr, structType, false,
+                                   dataTypes, elementSize, reason))
+            {
+                return false;
+            }
+            size = lengthSize + count * elementSize;
+            break;
+        }
+        case DataType::kStructType: {
+            StructType *currentStruct = dynamic_cast<StructType *>(trueDataType);
+            assert(currentStruct);
+
+            // Wrapped list is bounded by annotations of the member holding the wrapper.
+            if (isListStruct(currentStruct) || isBinaryStruct(currentStruct))
+            {
+                return getMaxEncodedSize(currentStruct->getMembers()[0]->getDataType(), structMember, structType,
+                                         false, dataTypes, size, reason);
+            }
+
+            if (!dataTypes.insert(currentStruct).second)
+            {
+                reason = format_string("struct '%s' is recursive", getOutputName(currentStruct).c_str());
+                return false;
+            }
+            for (StructMember *member : currentStruct->getMembers())
+            {
+                // Length and discriminator members are serialized with the list or union using them.
+                if (findParamReferencedFrom(currentStruct->getMembers(), member->getName()) &&
+                    !findAnnotation(member, SHARED_ANNOTATION))
+                {
+                    continue;
+                }
+
+                uint64_t memberSize;
+                if (!getMaxEncodedSize(member->getDataType(), member, currentStruct, false, dataTypes, memberSize,
+                                       reason))
+                {
+                    reason = format_string("in struct '%s', %s", getOutputName(currentStruct).c_str(),
+                                           reason.c_str());
+                    return false;
+                }
+
+                // Nullable members are preceded by a null flag.
+                DataType *memberTrueType = member->getDataType()->getTrueDataType();
+                StructType *memberStruct = dynamic_cast<StructType *>(memberTrueType);
+                if (findAnnotation(member, NULLABLE_ANNOTATION) &&
+                    (member->isByref() || memberTrueType->isBinary() || memberTrueType->isString() ||
+                     memberTrueType->isList() || memberTrueType->isFunction() ||
+                     (memberStruct && (isListStruct(memberStruct) || isBinaryStruct(memberStruct)))))
+                {
+                    memberSize += 1U;
+                }
+                size += memberSize;
+            }
+            dataTypes.erase(currentStruct);
+            break;
+        }
+        case DataType::kUnionType: {
+            UnionType *unionType = dynamic_cast<UnionType *>(trueDataType);
+            assert(unionType);
+
+            if (!dataTypes.insert(unionType).second)
+            {
+                reason = format_string("union '%s' is recursive", getOutputName(unionType).c_str());
+                return false;
+            }
+            uint64_t largestCase = 0;
+            for (UnionCase *unionCase : unionType->getCases())
+            {
+                uint64_t caseSize = 0;
+                if (!unionCase->caseMemberIsVoid())
+                {
+                    for (const string &caseMemberName : unionCase->getMemberDeclarationNames())
+                    {
+                        StructMember *caseMember = unionCase->getUnionMemberDeclaration(caseMemberName);
+                        uint64_t memberSize;
+                        if (!getMaxEncodedSize(caseMember->getDataType(), caseMember, &unionType->getUnionMembers(),
+                                               false, dataTypes, memberSize, reason))
+                        {
+                            reason = format_string("in union '%s', %s", getOutputName(unionType).c_str(),
+                                                   reason.c_str());
+                            return false;
+                        }
+                        caseSize += memberSize;
+                    }
+                }
+                largestCase = max(largestCase, caseSize);
+            }
+            dataTypes.erase(unionType);
+
+            // Discriminator is written as int32.
+            size = lengthSize + largestCase;
+            break;
+        }
+        case DataType::kFunctionType: {
+            FunctionType *funType = dynamic_cast<FunctionType *>(trueDataType);
+            assert(funType);
+            // Callback index is sent only when there is a choice.
+            size = (funType->getCallbackFuns().size() > 1) ? 1U : 0U;
+            break;
+        }
+        case DataType::kVoidType: {
+            size = 0;
+            break;
+        }
+        default: {
+            reason = format_string("type '%s' has no known wire size", trueDataType->getName().c_str());
+            return false;
+        }
+    }
+
+    if (size > UINT32_MAX)
+    {
+        reason = format_string("'%s' may take more than 4 GiB", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CGenerator::getMessageMaxSize(Function *fn, bool isReply, uint64_t &size, string &reason)
+{
+    set<DataType *> dataTypes;
+    StructType &params = fn->getParameters();
+    auto fnParams = params.getMembers();
+
+    size = 0;
+
+    // Oneway and fast functions are not answered.
+    if (isReply && (fn->isOneway() || fn->isFast()))
+    {
+        return true;
+    }
+
+    size = fn->isFast() ? kFastMessageHeaderSize : kMaxMessageHeaderSize;
+
+    for (StructMember *param : fnParams)
+    {
+        _param_direction direction = param->getDirection();
+        bool isNullable = isNullableParam(param);
+
+        // Follows serializedDirection and referencedName of getFunctionBaseTemplateData().
+        StructMember *referencedFrom = findParamReferencedFrom(fnParams, param->getName());
+        if (referencedFrom != nullptr && findAnnotation(referencedFrom, SHARED_ANNOTATION) == nullptr &&
+            !isNullableParam(referencedFrom))
+        {
+            _param_direction serializedDirection =
+                (referencedFrom->getDirection() == direction) ? kInoutDirection : referencedFrom->getDirection();
+            if (serializedDirection == (isReply ? kInDirection : kOutDirection))
+            {
+                continue;
+            }
+        }
+
+        uint64_t paramSize = 0;
+        if (!isReply)
+        {
+            if (direction != kOutDirection &&
+                !getMaxEncodedSize(param->getDataType(), param, &params, (direction == kInoutDirection),
+                                   dataTypes, paramSize, reason))
+            {
+                reason = format_string("parameter '%s': %s", param->getName().c_str(), reason.c_str());
+                return false;
+            }
+
+            // Null flag, the only data of nullable out parameter.
+            if (isNullable)
+            {
+                paramSize += 1U;
+            }
+        }
+        else if (direction != kInDirection)
+        {
+            if (!getMaxEncodedSize(param->getDataType(), param, &params, false, dataTypes, paramSize, reason))
+            {
+                reason = format_string("parameter '%s': %s", param->getName().c_str(), reason.c_str());
+                return false;
+            }
+        }
+        size += paramSize;
+    }
+
+    DataType *returnType = fn->getReturnType();
+    if (isReply && !returnType->getTrueDataType()->isVoid())
+    {
+        StructMember *returnMember = fn->getReturnStructMemberType();
+        uint64_t returnSize;
+        if (!getMaxEncodedSize(returnType, returnMember, nullptr, false, dataTypes, returnSize, reason))
+        {
+            reason = format_string("return value: %s", reason.c_str());
+            return false;
+        }
+        if (returnMember != nullptr && findAnnotation(returnMember, NULLABLE_ANNOTATION))
+        {
+            returnSize += 1U;
+        }
+        size += returnSize;
+    }
+
+    if (size > UINT32_MAX)
+    {
+        reason = "message may take more than 4 GiB";
+        return false;
+    }
+    return true;
+}
+
+void CGenerator::makeMessageSizesTemplateData(Group *group, data_map &groupTemplate)
+{
+    data_list &interfaces = groupTemplate["interfaces"]->getlist();
+    ostringstream report;
+    uint64_t largestMessage = 0;
+    string largestMessageName;
+    size_t ifaceIndex = 0;
+
+    report << "Worst-case message sizes" << (group->getName().empty() ? "" : " of group " + group->getName())
+           << ", in bytes, message headers included.\n";
+    report << "Codec: " << ((m_def->getCodecType() == InterfaceDefinition::kCompactCodec) ? "compact" : "basic")
+           << "\n";
+
+    for (Interface *iface : group->getInterfaces())
+    {
+        assert(ifaceIndex < interfaces.size());
+        data_map &ifaceInfo = interfaces[ifaceIndex++]->getmap();
+        data_list &functions = ifaceInfo["functions"]->getlist();
+        uint64_t ifaceMax = 0;
+        string firstUnbounded;
+        size_t fnIndex = 0;
+
+        report << "\n" << getOutputName(iface) << ":\n";
+
+        for (Function *fn : iface->getFunctions())
+        {
+            assert(fnIndex < functions.size());
+            data_map &fnInfo = functions[fnIndex++]->getmap();
+
+            for (bool isReply : { false, true })
+            {
+                const char *kind = isReply ? "reply" : "request";
+                uint64_t size;
+                string reason;
+                string message = format_string("%s.%s %s", getOutputName(iface).c_str(),
+                                               getOutputName(fn).c_str(), kind);
+
+                if (getMessageMaxSize(fn, isReply, size, reason))
+                {
+                    fnInfo[isReply ? "replyMaxSize" : "requestMaxSize"] = format_string("%" PRIu64 "U", size);
+                    fnInfo[isReply ? "replySizeNote" : "requestSizeNote"] = "";
+                    report << format_string("  %-40s %10" PRIu64 "\n", (getOutputName(fn) + " " + kind).c_str(),
+                                            size);
+                    ifaceMax = max(ifaceMax, size);
+                    if (size > largestMessage)
+                    {
+                        largestMessage = size;
+                        largestMessageName = message;
+                    }
+                }
+                else
+                {
+                    fnInfo[isReply ? "replyMaxSize" : "requestMaxSize"] = "UINT32_MAX";
+                    fnInfo[isReply ? "replySizeNote" : "requestSizeNote"] = " // unbounded: " + reason;
+                    if (firstUnbounded.empty())
+                    {
+                        firstUnbounded = message;
+                    }
+                    report << format_string("  %-40s  unbounded (%s)\n", (getOutputName(fn) + " " + kind).c_str(),
+                                            reason.c_str());
+                    Log::info("%s has no worst-case size: %s\n", message.c_str(), reason.c_str());
+                }
+            }
+        }
+
+        // A single unbounded message makes the interface unbounded, the bounded ones get their own maximum.
+        ifaceInfo["maxBoundedMessageSize"] = format_string("%" PRIu64 "U", ifaceMax);
+        if (firstUnbounded.empty())
+        {
+            ifaceInfo["maxMessageSize"] = format_string("%" PRIu64 "U", ifaceMax);
+            ifaceInfo["maxMessageSizeNote"] = "";
+            ifaceInfo["maxBoundedMessageSizeNote"] = "";
+        }
+        else
+        {
+            ifaceInfo["maxMessageSize"] = "UINT32_MAX";
+            ifaceInfo["maxMessageSizeNote"] = " // unbounded: " + firstUnbounded;
+            ifaceInfo["maxBoundedMessageSizeNote"] = " // unbounded messages are not included";
+        }
+    }
+
+    report << "\nLargest bounded message: ";
+    if (largestMessageName.empty())
+    {
+        report << "none\n";
+    }
+    else
+    {
+        report << largestMessageName << ", " << largestMessage << " bytes.\n"
+               << "ERPC_DEFAULT_BUFFER_SIZE must be at least " << largestMessage
+               << " when transport framing is not part of the buffer.\n";
+    }
+
+    groupTemplate["sizesReport"] = report.str();
+}
+
+void CGenerator::generateSizesReportFile(const string &fileName)
+{
+    ofstream fileOutputStream;
+
+    openFile(fileOutputStream, fileName + "_sizes.txt");
+    fileOutputStream << m_templateData["group"]->getmap()["sizesReport"]->getvalue();
+    fileOutputStream.close();
+}
+
 bool CGenerator::isBinaryStruct(StructType *structType)
 {
     // if structure contains one member list<>
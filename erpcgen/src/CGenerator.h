@@ -654,6 +654,16 @@ private:
      */
     bool containsByrefParamToFree(DataType *dataType, std::set<DataType *> &dataTypes);
 
+    /*!
+     * @brief This function check, if data type contains struct or union member with retain annotation.
+     *
+     * @param[in] dataType Given data type.
+     * @param[in] dataTypes For loops from forward declaration detection.
+     *
+     * @retval True if data type contains member which server shim doesn't free, else false.
+     */
+    bool containsRetainedMember(DataType *dataType, std::set<DataType *> &dataTypes);
+
     /*!
      * @brief This function returns true when structure is used as a wrapper for binary type.
      *
@@ -688,6 +698,97 @@ private:
      */
     bool isListStruct(StructType *structType);
 
+    /*!
+     * @brief This function computes the memory layout of a type which BasicCodec can copy in one shot.
+     *
+     * Such type is a fixed width scalar (not bool or enum), an array of them, or a struct of them
+     * stored inline whose members are naturally aligned without any padding. Its C layout then equals
+     * the little-endian wire layout of BasicCodec.
+     *
+     * @param[in] dataType Given data type.
+     * @param[out] size Size of the type in bytes.
+     * @param[out] alignment Natural alignment of the type in bytes.
+     * @param[out] reason Why the type can't be copied, when false is returned.
+     *
+     * @retval true When data type layout equals its wire layout.
+     * @retval false When data type needs to be coded member by member.
+     */
+    bool getPodLayout(DataType *dataType, uint32_t &size, uint32_t &alignment, std::string &reason);
+
+    /*!
+     * @brief This function returns true when structure is coded by one copy.
+     *
+     * @param[in] structType Given structure.
+     *
+     * @retval true When BasicCodec is used and structure layout equals its wire layout.
+     * @retval false Otherwise.
+     */
+    bool isPodStruct(StructType *structType);
+
+    /*!
+     * @brief This function computes the worst-case encoded size of a data type.
+     *
+     * Sizes follow the codec selected by -c. Lists and strings are bounded by a max_length annotation, or by
+     * a length annotation, when it names a number or a constant. Shared pointers are counted with 8 bytes.
+     *
+     * @param[in] dataType Given data type.
+     * @param[in] structMember Member or parameter holding the data, used for its annotations, or nullptr.
+     * @param[in] structType Structure or parameters containing the member, or nullptr.
+     * @param[in] isClientParam True for inout parameter encoded by the client, which writes enums as int32.
+     * @param[in] dataTypes For loops from recursive structures detection.
+     * @param[out] size Worst-case size in bytes.
+     * @param[out] reason Why the size is unbounded, when false is returned.
+     *
+     * @retval true When the size is bounded.
+     * @retval false When the size depends on run-time data without a constant bound.
+     */
+    bool getMaxEncodedSize(DataType *dataType, StructMember *structMember, StructType *structType, bool isClientParam,
+                           std::set<DataType *> &dataTypes, uint64_t &size, std::string &reason);
+
+    /*!
+     * @brief This function computes the worst-case encoded size of a request or reply message of a function.
+     *
+     * @param[in] fn Given function.
+     * @param[in] isReply False for the request written by the client, true for the reply written by the server.
+     * @param[out] size Worst-case size in bytes, message header included, 0 for the reply of oneway function.
+     * @param[out] reason Why the size is unbounded, when false is returned.
+     *
+     * @retval true When the size is bounded.
+     * @retval false When the size depends on run-time data without a constant bound.
+     */
+    bool getMessageMaxSize(Function *fn, bool isReply, uint64_t &size, std::string &reason);
+
+    /*!
+     * @brief This function returns value of a length or max_length annotation, when it is a constant.
+     *
+     * @param[in] structMember Member or parameter with the annotation.
+     * @param[in] structType Structure or parameters containing the member, or nullptr.
+     * @param[in] name Annotation name.
+     * @param[out] value Annotation value.
+     *
+     * @retval true When the annotation is a number or names a constant.
+     * @retval false When the annotation is missing or names a member or parameter.
+     */
+    bool getAnnConstantValue(StructMember *structMember, StructType *structType, const std::string &name,
+                             uint64_t &value);
+
+    /*!
+     * @brief This function sets worst-case message sizes to the group interfaces template data.
+     *
+     * It also builds the text of the size report of the group.
+     *
+     * @param[in] group Group with interfaces.
+     * @param[in,out] groupTemplate Group template data with the interfaces already set.
+     */
+    void makeMessageSizesTemplateData(Group *group, cpptempl::data_map &groupTemplate);
+
+    /*!
+     * @brief This function writes the size report of the current group.
+     *
+     * @param[in] fileName Output file name without extension.
+     */
+    void generateSizesReportFile(const std::string &fileName);
+
     /*!
      * @brief This function returns true when "retain" annotation wasn't set.
      *
@@ -136,6 +136,11 @@ Generator::Generator(InterfaceDefinition *def, generator_type_t generatorType)
             m_templateData["codecHeader"] = "erpc_basic_codec.h";
             break;
         }
+        case InterfaceDefinition::kCompactCodec: {
+            m_templateData["codecClass"] = "CompactCodec";
+            m_templateData["codecHeader"] = "erpc_compact_codec.h";
+            break;
+        }
         default: {
             m_templateData["codecClass"] = "Codec";
             m_templateData["codecHeader"] = "erpc_codec.h";
@@ -596,6 +601,33 @@ string Generator::getAnnStringValue(Symbol *symbol, string name)
     return symbol->getAnnStringValue(name, getAnnotationLang());
 }
 
+uint32_t Generator::getFunctionPriority(Function *fn)
+{
+    Annotation *ann = findAnnotation(fn, PRIORITY_ANNOTATION);
+    if (ann == nullptr)
+    {
+        return 0;
+    }
+
+    Value *val = ann->getValueObject();
+    if ((val == nullptr) || (val->getType() != kIntegerValue))
+    {
+        throw semantic_error(format_string("line %d: @%s annotation of function '%s' requires an integer value",
+                                           ann->getLocation().m_firstLine, PRIORITY_ANNOTATION,
+                                           fn->getName().c_str()));
+    }
+
+    uint64_t priority = dynamic_cast<IntegerValue *>(val)->getValue();
+    if (priority > 31U)
+    {
+        throw semantic_error(format_string("line %d: @%s value of function '%s' must be in range 0..31",
+                                           ann->getLocation().m_firstLine, PRIORITY_ANNOTATION,
+                                           fn->getName().c_str()));
+    }
+
+    return static_cast<uint32_t>(priority);
+}
+
 data_list Generator::getFunctionsTemplateData(Group *group, Interface *iface)
 {
     data_list fns;
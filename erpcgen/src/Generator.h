@@ -334,6 +334,18 @@ protected:
      */
     std::string getAnnStringValue(Symbol *symbol, std::string name);
 
+    /*!
+     * @brief This function returns the scheduling priority of a function.
+     *
+     * The priority is taken from the @priority annotation and is folded into bits 24..28 of the
+     * function id, above the 24-bit prototype hash.
+     *
+     * @param[in] fn Function from which is annotation extracted.
+     *
+     * @return Priority in range 0..31, 0 if annotation is not present.
+     */
+    uint32_t getFunctionPriority(Function *fn);
+
 private:
     /*!
      * @brief This function return interface functions list.
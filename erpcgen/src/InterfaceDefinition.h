@@ -35,6 +35,7 @@ public:
     {
         kNotSpecified,
         kBasicCodec,
+        kCompactCodec,
     }; /*!< Used codec type. */
 
     /*!
@@ -149,6 +150,7 @@ public:
      *
      * @retval kNotSpecified No optimization.
      * @retval kBasicCodec BasicCodec type optimization.
+     * @retval kCompactCodec CompactCodec type optimization.
      */
     codec_t getCodecType() { return m_codec; }
 
@@ -176,7 +176,7 @@ data_map PythonGenerator::getFunctionTemplateData(Group *group, Function *fn)
 
     info["name"] = getOutputName(fn);
     info["prototype"] = proto;
-    info["id"] = std::to_string(crc24_decode(proto));
+    info["id"] = std::to_string(static_cast<uint32_t>(crc24_decode(proto)) | (getFunctionPriority(fn) << 24));
     info["isOneway"] = fn->isOneway();
     info["skipCrcCheck"] = fn->getSkipCrcCheck();
     info["isReturnValue"] = !fn->isOneway();
@@ -10,6 +10,9 @@
 #ifndef _EMBEDDED_RPC__ANNOTATIONS_H_
 #define _EMBEDDED_RPC__ANNOTATIONS_H_
 
+//! Server receives an in binary parameter as pointer into the received message, without copy.
+#define BORROW_ANNOTATION "borrow"
+
 //! Define union discriminator name for non-encapsulated unions.
 #define CRC_ANNOTATION "crc"
 
@@ -60,6 +63,12 @@
 //! Sets the path to write output files into.
 #define OUTPUT_DIR_ANNOTATION "output_dir"
 
+//! Require a struct whose memory layout equals its wire layout, so it is coded with one copy.
+#define PACKED_ANNOTATION "packed"
+
+//! Scheduling priority (0..31) of a function, folded into the upper bits of its id.
+#define PRIORITY_ANNOTATION "priority"
+
 //! Strip the specified string from type names in Python output.
 #define PY_TYPES_NAME_STRIP_SUFFIX_ANNOTATION "py_types_name_strip_suffix"
 
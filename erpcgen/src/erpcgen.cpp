@@ -70,6 +70,7 @@ Available languages (use with -g option):\n\
 \n\
 Available codecs (use with --c option):\n\
   basic   BasicCodec\n\
+  compact CompactCodec (varint integers)\n\
 \n";
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -217,6 +218,10 @@ public:
                     {
                         m_codec = InterfaceDefinition::kBasicCodec;
                     }
+                    else if (codec.compare("compact") == 0)
+                    {
+                        m_codec = InterfaceDefinition::kCompactCodec;
+                    }
                     else
                     {
                         Log::error(format_string("error: unknown codec type %s", codec.c_str()).c_str());
@@ -0,0 +1,624 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "LoadGenerator.h"
+
+#include "erpc_c/infra/erpc_message_buffer.h"
+
+#include "Logging.h"
+#include "Pcapng.h"
+#include "annotations.h"
+#include "format_string.h"
+#include "types/AliasType.h"
+#include "types/ArrayType.h"
+#include "types/BuiltinType.h"
+#include "types/EnumType.h"
+#include "types/Function.h"
+#include "types/FunctionType.h"
+#include "types/Interface.h"
+#include "types/ListType.h"
+#include "types/StructType.h"
+#include "types/UnionType.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace erpcgen;
+using namespace erpcload;
+using namespace erpc;
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+/*!
+ * @brief Return time of the steady clock in nanoseconds.
+ */
+uint64_t nowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*!
+ * @brief Return percentile of sorted latencies, by nearest rank.
+ *
+ * @param[in] sorted Sorted latencies, not empty.
+ * @param[in] permille Percentile in 1/1000.
+ */
+uint32_t percentile(const vector<uint32_t> &sorted, uint32_t permille)
+{
+    size_t rank = (sorted.size() * permille + 999U) / 1000U;
+    return sorted[(rank == 0U) ? 0U : (rank - 1U)];
+}
+
+/*!
+ * @brief Return time from @a from to @a to in nanoseconds, 0 when @a to is earlier, saturated to 32 bits.
+ */
+uint32_t elapsedNs(uint64_t from, uint64_t to)
+{
+    return static_cast<uint32_t>((to > from) ? min<uint64_t>(to - from, UINT32_MAX) : 0U);
+}
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+size_t LoadGenerator::loadCapture(const char *filePath)
+{
+    erpcsniffer::PcapngReader reader(filePath);
+    erpcsniffer::CapturedMessage captured;
+    uint64_t first = 0;
+
+    while (reader.read(captured))
+    {
+        MessageBuffer message(captured.m_data.data(), captured.m_data.size());
+        message.setUsed(captured.m_data.size());
+        m_codec.setBuffer(message);
+
+        message_type_t type;
+        uint32_t serviceId;
+        Hash methodId;
+        uint32_t sequence;
+        m_codec.startReadMessage(&type, &serviceId, &methodId, &sequence);
+        if (!m_codec.isStatusOk() || (type != kInvocationMessage && type != kOnewayMessage))
+        {
+            continue;
+        }
+
+        if (m_calls.empty())
+        {
+            first = captured.m_timestamp;
+        }
+
+        LoadCall call;
+        call.m_channel = captured.m_channel;
+        call.m_serviceId = serviceId;
+        call.m_methodId = methodId;
+        call.m_isOneway = (type == kOnewayMessage);
+        call.m_offset = captured.m_timestamp - first;
+        call.m_data.swap(captured.m_data);
+        m_calls.push_back(move(call));
+    }
+
+    // The next pass starts one mean gap after the last request.
+    if (m_calls.size() > 1)
+    {
+        m_period = m_calls.back().m_offset + m_calls.back().m_offset / (m_calls.size() - 1);
+    }
+
+    return m_calls.size();
+}
+
+size_t LoadGenerator::synthesise(uint32_t elementCount, double rate)
+{
+    // MessageBuffer holds up to 64 KB.
+    vector<uint8_t> buffer(UINT16_MAX);
+
+    for (Symbol *interfaceSymbol : m_def->getGlobals().getSymbolsOfType(Symbol::kInterfaceSymbol))
+    {
+        Interface *interface = dynamic_cast<Interface *>(interfaceSymbol);
+        assert(interface);
+
+        for (Function *function : interface->getFunctions())
+        {
+            BasicCodec codec;
+            MessageBuffer message(buffer.data(), buffer.size());
+            codec.setBuffer(message);
+            codec.startWriteMessage(function->isOneway() ? kOnewayMessage : kInvocationMessage,
+                                    interface->getUniqueId(), function->getUniqueId(), 0);
+
+            StructType &params = function->getParameters();
+            for (StructMember *param : params.getMembers())
+            {
+                if (param->getDirection() == _param_direction::kInDirection ||
+                    param->getDirection() == _param_direction::kInoutDirection)
+                {
+                    writeMemberType(codec, &params, param, elementCount);
+                }
+            }
+
+            if (!codec.isStatusOk())
+            {
+                Log::warning("skipping %s::%s, its request does not fit into 64 KB\n", interface->getName().c_str(),
+                             function->getName().c_str());
+                continue;
+            }
+
+            LoadCall call;
+            // Generated client shims send on the channel of the function id.
+            call.m_channel = function->getUniqueId();
+            call.m_serviceId = interface->getUniqueId();
+            call.m_methodId = function->getUniqueId();
+            call.m_isOneway = function->isOneway();
+            call.m_offset = (rate > 0) ? static_cast<uint64_t>(m_calls.size() * 1e9 / rate) : 0;
+            call.m_data.assign(buffer.data(), buffer.data() + codec.getBuffer()->getUsed());
+            m_calls.push_back(move(call));
+        }
+    }
+
+    m_period = (rate > 0) ? static_cast<uint64_t>(m_calls.size() * 1e9 / rate) : 0;
+
+    return m_calls.size();
+}
+
+erpc_status_t LoadGenerator::run(uint64_t quantity, uint32_t concurrency, double speed)
+{
+    vector<Transport *> transports;
+    erpc_status_t err = kErpcStatus_Success;
+
+    if (m_calls.empty())
+    {
+        throw runtime_error("no requests to send");
+    }
+
+    for (uint32_t i = 0; i < concurrency; ++i)
+    {
+        Transport *transport = m_transportFactory();
+        if (!transport)
+        {
+            err = kErpcStatus_ConnectionFailure;
+            break;
+        }
+        transports.push_back(transport);
+    }
+
+    if (!err)
+    {
+        vector<result_map_t> results(transports.size());
+        vector<thread> workers;
+        atomic<uint64_t> next(0);
+        uint64_t start = nowNs();
+
+        m_speed = speed;
+        for (size_t i = 0; i < transports.size(); ++i)
+        {
+            workers.emplace_back(&LoadGenerator::work, this, transports[i], ref(next), quantity, speed, start,
+                                 ref(results[i]));
+        }
+        for (thread &worker : workers)
+        {
+            worker.join();
+        }
+        m_seconds = (nowNs() - start) / 1e9;
+
+        m_results.clear();
+        for (result_map_t &workerResults : results)
+        {
+            for (auto &it : workerResults)
+            {
+                MethodResult &result = m_results[it.first];
+                result.m_calls += it.second.m_calls;
+                result.m_errors += it.second.m_errors;
+                result.m_latency.insert(result.m_latency.end(), it.second.m_latency.begin(),
+                                        it.second.m_latency.end());
+                result.m_lag.insert(result.m_lag.end(), it.second.m_lag.begin(), it.second.m_lag.end());
+            }
+        }
+    }
+
+    for (Transport *transport : transports)
+    {
+        delete transport;
+    }
+
+    return err;
+}
+
+void LoadGenerator::work(Transport *transport, atomic<uint64_t> &next, uint64_t quantity, double speed,
+                         uint64_t start, result_map_t &results)
+{
+    vector<uint8_t> request;
+    vector<uint8_t> reply(UINT16_MAX);
+    BasicCodec codec;
+
+    for (uint64_t i = next.fetch_add(1); i < quantity; i = next.fetch_add(1))
+    {
+        const LoadCall &call = m_calls[i % m_calls.size()];
+        MethodResult &result = results[make_pair(call.m_serviceId, call.m_methodId)];
+
+        // Without a schedule a call starts when it is sent.
+        uint64_t scheduled = 0;
+        if (speed > 0)
+        {
+            uint64_t offset = (i / m_calls.size()) * m_period + call.m_offset;
+            scheduled = start + static_cast<uint64_t>(offset / speed);
+            this_thread::sleep_until(chrono::steady_clock::time_point(chrono::nanoseconds(scheduled)));
+        }
+
+        // The transport may write into the buffer while framing, so each send gets a fresh copy.
+        request = call.m_data;
+        MessageBuffer message(request.data(), request.size());
+        message.setUsed(request.size());
+
+        ++result.m_calls;
+        uint64_t sent = nowNs();
+        if (speed > 0)
+        {
+            // A call which could not go out on time because the worker waited for an earlier
+            // reply is measured from its scheduled time, the wait is part of its latency.
+            result.m_lag.push_back(elapsedNs(scheduled, sent));
+            sent = scheduled;
+        }
+        erpc_status_t err;
+        do
+        {
+            err = transport->send(call.m_channel, &message);
+        } while (err == kErpcStatus_Pending);
+
+        if (!err && !call.m_isOneway)
+        {
+            MessageBuffer response(reply.data(), reply.size());
+            do
+            {
+                err = transport->receive(call.m_channel, &response);
+            } while (err == kErpcStatus_Pending);
+
+            if (!err)
+            {
+                message_type_t type;
+                uint32_t serviceId;
+                Hash methodId;
+                uint32_t sequence;
+                codec.setBuffer(response);
+                codec.startReadMessage(&type, &serviceId, &methodId, &sequence);
+                if (!codec.isStatusOk() || type != kReplyMessage || methodId != call.m_methodId)
+                {
+                    ++result.m_errors;
+                    continue;
+                }
+            }
+        }
+
+        if (err)
+        {
+            // The connection is unusable now, the other workers carry on.
+            Log::error("call %s failed with error %d, worker stops\n",
+                       getMethodName(call.m_serviceId, call.m_methodId).c_str(), err);
+            ++result.m_errors;
+            break;
+        }
+
+        result.m_latency.push_back(elapsedNs(sent, nowNs()));
+    }
+}
+
+void LoadGenerator::report(const char *jsonFilePath)
+{
+    // Runs with a schedule measure latency from the scheduled send time and report the send lag.
+    bool scheduled = (m_speed > 0);
+    ofstream json;
+    if (jsonFilePath)
+    {
+        json.open(jsonFilePath, ofstream::out);
+        if (!json.is_open())
+        {
+            throw runtime_error(format_string("could not open report file '%s'", jsonFilePath));
+        }
+        json << format_string("{\"seconds\":%.3f,\"latency_from\":\"%s\",\"methods\":[", m_seconds,
+                              scheduled ? "schedule" : "send");
+    }
+
+    if (scheduled)
+    {
+        printf("latency is measured from the scheduled send time, lag is how late the request was sent\n");
+    }
+    printf("%-40s %10s %8s %10s %10s %10s %10s %10s %10s", "method", "calls", "errors", "calls/s", "p50 us",
+           "p90 us", "p99 us", "p99.9 us", "max us");
+    if (scheduled)
+    {
+        printf(" %10s %10s %10s", "lag p50 us", "lag p99 us", "lag max us");
+    }
+    printf("\n");
+
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    bool first = true;
+    for (auto &it : m_results)
+    {
+        MethodResult &result = it.second;
+        string name = getMethodName(it.first.first, it.first.second);
+        double rate = (m_seconds > 0) ? (result.m_calls - result.m_errors) / m_seconds : 0;
+        uint32_t p[5] = { 0, 0, 0, 0, 0 };
+        uint32_t lag[3] = { 0, 0, 0 };
+
+        if (!result.m_latency.empty())
+        {
+            sort(result.m_latency.begin(), result.m_latency.end());
+            p[0] = percentile(result.m_latency, 500);
+            p[1] = percentile(result.m_latency, 900);
+            p[2] = percentile(result.m_latency, 990);
+            p[3] = percentile(result.m_latency, 999);
+            p[4] = result.m_latency.back();
+        }
+        if (!result.m_lag.empty())
+        {
+            sort(result.m_lag.begin(), result.m_lag.end());
+            lag[0] = percentile(result.m_lag, 500);
+            lag[1] = percentile(result.m_lag, 990);
+            lag[2] = result.m_lag.back();
+        }
+
+        printf("%-40s %10" PRIu64 " %8" PRIu64 " %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f", name.c_str(),
+               result.m_calls, result.m_errors, rate, p[0] / 1e3, p[1] / 1e3, p[2] / 1e3, p[3] / 1e3, p[4] / 1e3);
+        if (scheduled)
+        {
+            printf(" %10.1f %10.1f %10.1f", lag[0] / 1e3, lag[1] / 1e3, lag[2] / 1e3);
+        }
+        printf("\n");
+        if (json.is_open())
+        {
+            json << format_string("%s{\"method\":\"%s\",\"calls\":%" PRIu64 ",\"errors\":%" PRIu64
+                                  ",\"rate\":%.1f,\"p50_ns\":%u,\"p90_ns\":%u,\"p99_ns\":%u,\"p999_ns\":%u,"
+                                  "\"max_ns\":%u",
+                                  first ? "" : ",", name.c_str(), result.m_calls, result.m_errors, rate, p[0], p[1],
+                                  p[2], p[3], p[4]);
+            if (scheduled)
+            {
+                json << format_string(",\"lag_p50_ns\":%u,\"lag_p99_ns\":%u,\"lag_max_ns\":%u", lag[0], lag[1],
+                                      lag[2]);
+            }
+            json << "}";
+        }
+
+        first = false;
+        calls += result.m_calls;
+        errors += result.m_errors;
+    }
+
+    printf("%" PRIu64 " calls, %" PRIu64 " errors in %.3f s, %.1f calls/s\n", calls, errors, m_seconds,
+           (m_seconds > 0) ? (calls - errors) / m_seconds : 0);
+    if (json.is_open())
+    {
+        json << "]}\n";
+    }
+}
+
+void LoadGenerator::writeDataType(Codec &codec, DataType *dataType, uint32_t elementCount)
+{
+    switch (dataType->getDataType())
+    {
+        case DataType::_data_type::kAliasType: {
+            AliasType *aliasType = dynamic_cast<AliasType *>(dataType);
+            assert(aliasType);
+            writeDataType(codec, aliasType->getElementType(), elementCount);
+            break;
+        }
+        case DataType::_data_type::kArrayType: {
+            ArrayType *arrayType = dynamic_cast<ArrayType *>(dataType);
+            assert(arrayType);
+            for (uint32_t i = 0; i < arrayType->getElementCount(); ++i)
+            {
+                writeDataType(codec, arrayType->getElementType(), elementCount);
+            }
+            break;
+        }
+        case DataType::_data_type::kBuiltinType: {
+            BuiltinType *builtinType = dynamic_cast<BuiltinType *>(dataType);
+            assert(builtinType);
+            switch (builtinType->getBuiltinType())
+            {
+                case BuiltinType::_builtin_type::kBoolType:
+                    codec.write(false);
+                    break;
+                case BuiltinType::_builtin_type::kInt8Type:
+                    codec.write(static_cast<int8_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kInt16Type:
+                    codec.write(static_cast<int16_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kInt32Type:
+                    codec.write(static_cast<int32_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kInt64Type:
+                    codec.write(static_cast<int64_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kUInt8Type:
+                    codec.write(static_cast<uint8_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kUInt16Type:
+                    codec.write(static_cast<uint16_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kUInt32Type:
+                    codec.write(static_cast<uint32_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kUInt64Type:
+                    codec.write(static_cast<uint64_t>(0));
+                    break;
+                case BuiltinType::_builtin_type::kFloatType:
+                    codec.write(0.0f);
+                    break;
+                case BuiltinType::_builtin_type::kDoubleType:
+                    codec.write(0.0);
+                    break;
+                case BuiltinType::_builtin_type::kStringType:
+                case BuiltinType::_builtin_type::kUStringType: {
+                    string value(elementCount, 'a');
+                    codec.writeString(elementCount, value.c_str());
+                    break;
+                }
+                case BuiltinType::_builtin_type::kBinaryType: {
+                    vector<uint8_t> value(elementCount);
+                    codec.writeBinary(elementCount, value.data());
+                    break;
+                }
+                default: {
+                    throw runtime_error("Unrecognized builtin type.\n");
+                }
+            }
+            break;
+        }
+        case DataType::_data_type::kEnumType: {
+            EnumType *e = dynamic_cast<EnumType *>(dataType);
+            assert(e);
+            codec.write(static_cast<int32_t>(e->getMembers().empty() ? 0 : e->getMembers()[0]->getValue()));
+            break;
+        }
+        case DataType::_data_type::kFunctionType: {
+            codec.write(static_cast<int32_t>(0));
+            break;
+        }
+        case DataType::_data_type::kListType: {
+            ListType *listType = dynamic_cast<ListType *>(dataType);
+            assert(listType);
+            codec.startWriteList(elementCount);
+            for (uint32_t i = 0; i < elementCount; ++i)
+            {
+                writeDataType(codec, listType->getElementType(), elementCount);
+            }
+            break;
+        }
+        case DataType::_data_type::kStructType: {
+            StructType *structType = dynamic_cast<StructType *>(dataType);
+            assert(structType);
+            for (StructMember *member : structType->getMembers())
+            {
+                writeMemberType(codec, structType, member, elementCount);
+            }
+            break;
+        }
+        case DataType::_data_type::kUnionType: {
+            UnionType *unionType = dynamic_cast<UnionType *>(dataType);
+            assert(unionType);
+            if (unionType->getCases().empty())
+            {
+                codec.startWriteUnion(0);
+                break;
+            }
+
+            // The first case is sent, a default case (-1) gets discriminator 0.
+            UnionCase *unionCase = unionType->getCases()[0];
+            codec.startWriteUnion((unionCase->getCaseValue() == -1) ? 0 : unionCase->getCaseValue());
+            for (string name : unionCase->getMemberDeclarationNames())
+            {
+                StructMember *structMember = unionCase->getUnionMemberDeclaration(name);
+                writeMemberType(codec, &unionType->getUnionMembers(), structMember, elementCount);
+            }
+            break;
+        }
+        case DataType::_data_type::kVoidType: {
+            break;
+        }
+        default: {
+            throw runtime_error("Unrecognized data type.\n");
+        }
+    }
+}
+
+void LoadGenerator::writeMemberType(Codec &codec, StructType *structType, StructMember *structMember,
+                                    uint32_t elementCount)
+{
+    if (structType)
+    {
+        // Members referenced as length or discriminator are serialized via the other member.
+        for (StructMember *referenced : structType->getMembers())
+        {
+            Annotation *ann;
+            string referencedName;
+            if ((ann = referenced->findAnnotation(LENGTH_ANNOTATION, Annotation::kC)) ||
+                (ann = referenced->findAnnotation(DISCRIMINATOR_ANNOTATION, Annotation::kC)))
+            {
+                if (Value *val = ann->getValueObject())
+                {
+                    referencedName = val->toString();
+                }
+            }
+            DataType *referencedDataType = referenced->getDataType()->getTrueDataType();
+            if (referencedName.empty() && referencedDataType->isUnion())
+            {
+                UnionType *unionType = dynamic_cast<UnionType *>(referencedDataType);
+                assert(unionType);
+                referencedName = unionType->getDiscriminatorName();
+            }
+            if (!referencedName.empty() && structMember->getName().compare(referencedName) == 0)
+            {
+                return;
+            }
+        }
+
+        // Null flag of a nullable length or discriminator reference.
+        Annotation *ann;
+        if ((ann = structMember->findAnnotation(LENGTH_ANNOTATION, Annotation::kC)) ||
+            (ann = structMember->findAnnotation(DISCRIMINATOR_ANNOTATION, Annotation::kC)))
+        {
+            if (Value *val = ann->getValueObject())
+            {
+                StructMember *reference =
+                    dynamic_cast<StructMember *>(structType->getScope().getSymbol(val->toString(), false));
+                if (reference && reference->findAnnotation(NULLABLE_ANNOTATION, Annotation::kC) != nullptr)
+                {
+                    codec.writeNullFlag(false);
+                }
+            }
+        }
+    }
+
+    if (structMember->findAnnotation(NULLABLE_ANNOTATION, Annotation::kC) != nullptr)
+    {
+        codec.writeNullFlag(false);
+    }
+
+    if (structMember->findAnnotation(SHARED_ANNOTATION, Annotation::kC) != nullptr)
+    {
+        codec.writePtr(0);
+        return;
+    }
+
+    writeDataType(codec, structMember->getDataType(), elementCount);
+}
+
+string LoadGenerator::getMethodName(uint32_t serviceId, uint32_t methodId)
+{
+    for (Symbol *interfaceSymbol : m_def->getGlobals().getSymbolsOfType(Symbol::kInterfaceSymbol))
+    {
+        Interface *interface = dynamic_cast<Interface *>(interfaceSymbol);
+        assert(interface);
+        if (interface->getUniqueId() != serviceId)
+        {
+            continue;
+        }
+
+        for (Function *function : interface->getFunctions())
+        {
+            if (function->getUniqueId() == methodId)
+            {
+                return interface->getName() + "::" + function->getName();
+            }
+        }
+    }
+
+    return format_string("%u::%u", serviceId, methodId);
+}
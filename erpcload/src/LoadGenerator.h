@@ -0,0 +1,184 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__LOAD_GENERATOR_H_
+#define _EMBEDDED_RPC__LOAD_GENERATOR_H_
+
+#include "erpc_c/infra/erpc_basic_codec.h"
+#include "erpc_c/infra/erpc_transport.h"
+
+#include "InterfaceDefinition.h"
+#include "types/StructType.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpcload {
+/*!
+ * @brief One request sent by the load generator.
+ */
+struct LoadCall
+{
+    uint32_t m_channel;          /*!< Channel hash the request is sent on. */
+    uint32_t m_serviceId;        /*!< Interface id. */
+    uint32_t m_methodId;         /*!< Function id. */
+    bool m_isOneway;             /*!< No reply is awaited. */
+    uint64_t m_offset;           /*!< Send time relative to the first call at speed 1, in nanoseconds. */
+    std::vector<uint8_t> m_data; /*!< Encoded request without framing. */
+};
+
+/*!
+ * @brief Latencies and errors of one method.
+ */
+struct MethodResult
+{
+    uint64_t m_calls;                /*!< Count of sent requests. */
+    uint64_t m_errors;               /*!< Count of failed sends, receives and mismatched replies. */
+    std::vector<uint32_t> m_latency; /*!< Time from send to reply of each successful call, in nanoseconds. */
+    std::vector<uint32_t> m_lag;     /*!< Time each request was sent after its scheduled time, in nanoseconds. */
+};
+
+/*!
+ * @brief Replays or synthesises eRPC requests through a transport and measures the replies.
+ */
+class LoadGenerator
+{
+public:
+    //! @brief Creates a connected transport for one worker, NULL on failure.
+    typedef std::function<erpc::Transport *(void)> transport_factory_t;
+
+    /*!
+     * @brief This function is constructor of LoadGenerator class.
+     *
+     * @param[in] def Contains information parsed from IDL, used for method names and synthesised calls.
+     * @param[in] transportFactory Creates the transport of each worker.
+     */
+    LoadGenerator(erpcgen::InterfaceDefinition *def, const transport_factory_t &transportFactory)
+    : m_def(def)
+    , m_transportFactory(transportFactory)
+    , m_codec()
+    , m_period(0)
+    , m_seconds(0)
+    , m_speed(0)
+    {
+    }
+
+    /*!
+     * @brief This function loads the requests of a pcapng file written by erpcsniffer.
+     *
+     * Replies and other messages in the capture are skipped.
+     *
+     * @param[in] filePath Path to the capture file.
+     *
+     * @return Count of loaded requests.
+     */
+    size_t loadCapture(const char *filePath);
+
+    /*!
+     * @brief This function synthesises one request of every function of every interface in the IDL.
+     *
+     * Parameters get zero values, lists, strings and binaries get @a elementCount elements.
+     *
+     * @param[in] elementCount Count of elements of lists, strings and binaries.
+     * @param[in] rate Calls per second used for the send times, 0 sends them all at once.
+     *
+     * @return Count of synthesised requests.
+     */
+    size_t synthesise(uint32_t elementCount, double rate);
+
+    /*!
+     * @brief This function sends the loaded requests and waits for the replies.
+     *
+     * Requests are sent in a loop until @a quantity calls are done. Each worker sends on its
+     * own transport and waits for the reply before it takes the next request.
+     *
+     * With @a speed above 0 latencies are measured from the scheduled send time rather than from
+     * the actual send, so requests held back by a slow reply count their wait too (no coordinated
+     * omission). How late the sends were is reported as schedule lag.
+     *
+     * @param[in] quantity Count of calls to send.
+     * @param[in] concurrency Count of workers.
+     * @param[in] speed Factor of the send rate relative to the loaded send times, 0 for maximum rate.
+     *
+     * @retval kErpcStatus_Success when all workers had their transport.
+     */
+    erpc_status_t run(uint64_t quantity, uint32_t concurrency, double speed);
+
+    /*!
+     * @brief This function prints throughput and latency percentiles per method.
+     *
+     * @param[in] jsonFilePath Path to a file the report is written to as JSON as well, or NULL.
+     */
+    void report(const char *jsonFilePath);
+
+protected:
+    typedef std::map<std::pair<uint32_t, uint32_t>, MethodResult> result_map_t; /*!< Results by method ids. */
+
+    erpcgen::InterfaceDefinition *m_def;    /*!< Parsed IDL. */
+    transport_factory_t m_transportFactory; /*!< Creates worker transports. */
+    erpc::BasicCodec m_codec;               /*!< Codec used for parsing captured headers. */
+    std::vector<LoadCall> m_calls;          /*!< Requests to send. */
+    uint64_t m_period;                      /*!< Duration of one pass over all calls at speed 1, in nanoseconds. */
+    result_map_t m_results;                 /*!< Results of the last run by interface and function id. */
+    double m_seconds;                       /*!< Duration of the last run. */
+    double m_speed;                         /*!< Speed factor of the last run. */
+
+    /*!
+     * @brief This function sends requests from the shared call index, run by each worker.
+     *
+     * @param[in] transport Transport of the worker.
+     * @param[in,out] next Index of the next call, shared by all workers.
+     * @param[in] quantity Count of calls to send.
+     * @param[in] speed Speed factor, 0 for maximum rate.
+     * @param[in] start Start time of the run, in nanoseconds of the steady clock.
+     * @param[out] results Results of this worker.
+     */
+    void work(erpc::Transport *transport, std::atomic<uint64_t> &next, uint64_t quantity, double speed,
+              uint64_t start, result_map_t &results);
+
+    /*!
+     * @brief This function encodes zero value of a data type.
+     *
+     * @param[in] codec Codec the value is written to.
+     * @param[in] dataType Data type to encode.
+     * @param[in] elementCount Count of elements of lists, strings and binaries.
+     */
+    void writeDataType(erpc::Codec &codec, erpcgen::DataType *dataType, uint32_t elementCount);
+
+    /*!
+     * @brief This function encodes zero value of a struct member or parameter.
+     *
+     * @param[in] codec Codec the value is written to.
+     * @param[in] structType Struct containing the member, needed for handling annotations, or NULL.
+     * @param[in] structMember Member to encode.
+     * @param[in] elementCount Count of elements of lists, strings and binaries.
+     */
+    void writeMemberType(erpc::Codec &codec, erpcgen::StructType *structType, erpcgen::StructMember *structMember,
+                         uint32_t elementCount);
+
+    /*!
+     * @brief This function returns name of a method for the report.
+     *
+     * @param[in] serviceId Interface id.
+     * @param[in] methodId Function id.
+     *
+     * @return "Interface::function", or the ids when the IDL does not know them.
+     */
+    std::string getMethodName(uint32_t serviceId, uint32_t methodId);
+};
+} // namespace erpcload
+
+#endif // _EMBEDDED_RPC__LOAD_GENERATOR_H_
@@ -0,0 +1,526 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc16.h"
+#include "erpc_tcp_transport.h"
+#include "erpc_transport.h"
+#include "erpc_transport_setup.h"
+#include "erpc_version.h"
+
+#include "InterfaceDefinition.h"
+#include "LoadGenerator.h"
+#include "Logging.h"
+#include "SearchPath.h"
+#include "UniqueIdChecker.h"
+#include "annotations.h"
+#include "format_string.h"
+#include "options.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+/*!
+ * @brief Entry point for the tool.
+ */
+int main(int argc, char *argv[], char *envp[]);
+
+using namespace erpc;
+using namespace erpcgen;
+using namespace std;
+namespace erpcload {
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+/*! The tool's name. */
+const char k_toolName[] = "erpcload";
+
+/*! Current version number for the tool. */
+const char k_version[] = ERPC_VERSION;
+
+/*! Copyright string. */
+const char k_copyright[] = "Copyright 2021 ACRIOS Systems s.r.o. All rights reserved.";
+
+static const char *k_optionsDefinition[] = { "?|help",
+                                             "V|version",
+                                             "o:output <filePath>",
+                                             "v|verbose",
+                                             "I:path <filePath>",
+                                             "t:transport <transport>",
+                                             "b:baudrate <baudrate>",
+                                             "p:port <port>",
+                                             "h:host <host>",
+                                             "r:read <filePath>",
+                                             "s:speed <factor>",
+                                             "R:rate <rate>",
+                                             "S:size <count>",
+                                             "c:concurrency <count>",
+                                             "q:quantity <quantity>",
+                                             NULL };
+
+/*! Help string. */
+const char k_usageText[] =
+    "\nOptions:\n\
+  -?/--help                    Show this help\n\
+  -V/--version                 Display tool version\n\
+  -o/--output <filePath>       Write the report as JSON to a file as well\n\
+  -v/--verbose                 Print extra detailed log information\n\
+  -I/--path <filePath>         Add search path for imports\n\
+  -t/--transport <transport>   Type of transport.\n\
+  -b/--baudrate <baudrate>     Baud rate.\n\
+  -p/--port <port>             Port name or port number.\n\
+  -h/--host <host>             Host definition.\n\
+  -r/--read <filePath>         Replay requests from pcapng file written by erpcsniffer\n\
+  -s/--speed <factor>          Replay speed relative to the capture or rate (0 - maximum, default 1)\n\
+  -R/--rate <rate>             Calls per second of synthesised requests (0 - maximum, default 0)\n\
+  -S/--size <count>            Elements of synthesised lists, strings and binaries (default 1)\n\
+  -c/--concurrency <count>     Count of connections sending in parallel (default 1)\n\
+  -q/--quantity <quantity>     Count of calls to send (default: each loaded request once)\n\
+\n\
+Without -r one request of every function in the IDL is synthesised.\n\
+\n\
+Available transports (use with -t option):\n\
+  tcp      Tcp transport type (host, port number).\n\
+  serial   Serial transport type (port name, baud rate).\n\
+\n";
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Class that encapsulates the erpcload tool.
+ *
+ * A single global logger instance is created during object construction. It is
+ * never freed because we need it up to the last possible minute, when an
+ * exception could be thrown.
+ */
+class erpcloadTool
+{
+protected:
+    enum verbose_type_t
+    {
+        kWarning,
+        kInfo,
+        kDebug,
+        kExtraDebug
+    }; /*!< Types of verbose outputs from erpcload application. */
+
+    enum transports_t
+    {
+        kNoneTransport,
+        kTcpTransport,
+        kSerialTransport
+    }; /*!< Type of transport to use. */
+
+    typedef vector<string> string_vector_t;
+
+    int m_argc;                   /*!< Number of command line arguments. */
+    char **m_argv;                /*!< String value for each command line argument. */
+    StdoutLogger *m_logger;       /*!< Singleton logger instance. */
+    verbose_type_t m_verboseType; /*!< Which type of log is need to set (warning, info, debug). */
+    const char *m_outputFilePath; /*!< Path to the JSON report. */
+    const char *m_ErpcFile;       /*!< ERPC file. */
+    string_vector_t m_positionalArgs;
+    transports_t m_transport;     /*!< Transport used for sending requests. */
+    uint32_t m_baudrate;          /*!< Baudrate rate speed. */
+    const char *m_port;           /*!< Name or number of port. Based on used transport. */
+    const char *m_host;           /*!< Host name */
+    const char *m_replayFilePath; /*!< Path to the pcapng file to replay. */
+    double m_speed;               /*!< Replay speed factor, 0 for maximum. */
+    double m_rate;                /*!< Calls per second of synthesised requests, 0 for maximum. */
+    uint32_t m_size;              /*!< Elements of synthesised lists, strings and binaries. */
+    uint32_t m_concurrency;       /*!< Count of parallel connections. */
+    uint64_t m_quantity;          /*!< Count of calls to send, 0 for each loaded request once. */
+
+public:
+    /*!
+     * @brief Constructor.
+     *
+     * @param[in] argc Count of arguments in argv variable.
+     * @param[in] argv Pointer to array of arguments.
+     *
+     * Creates the singleton logger instance.
+     */
+    erpcloadTool(int argc, char *argv[])
+    : m_argc(argc)
+    , m_argv(argv)
+    , m_logger(0)
+    , m_verboseType(kWarning)
+    , m_outputFilePath(NULL)
+    , m_ErpcFile(NULL)
+    , m_transport(kNoneTransport)
+    , m_baudrate(115200)
+    , m_port(NULL)
+    , m_host(NULL)
+    , m_replayFilePath(NULL)
+    , m_speed(1)
+    , m_rate(0)
+    , m_size(1)
+    , m_concurrency(1)
+    , m_quantity(0)
+    {
+        // create logger instance
+        m_logger = new StdoutLogger();
+        m_logger->setFilterLevel(Logger::kWarning);
+        Log::setLogger(m_logger);
+    }
+
+    /*!
+     * @brief Destructor.
+     */
+    ~erpcloadTool() {}
+
+    /*!
+     * @brief Reads the command line options passed into the constructor.
+     *
+     * @retval -1 The options were processed successfully. Let the tool run normally.
+     * @return A zero or positive result is a return code value that should be
+     *      returned from the tool as it exits immediately.
+     */
+    int processOptions()
+    {
+        Options options(*m_argv, k_optionsDefinition);
+        OptArgvIter iter(--m_argc, ++m_argv);
+
+        // process command line options
+        int optchar;
+        const char *optarg;
+        while ((optchar = options(iter, optarg)))
+        {
+            switch (optchar)
+            {
+                case '?': {
+                    printUsage(options);
+                    return 0;
+                }
+
+                case 'V': {
+                    printf("%s %s\n%s\n", k_toolName, k_version, k_copyright);
+                    return 0;
+                }
+
+                case 'o': {
+                    m_outputFilePath = optarg;
+                    break;
+                }
+
+                case 'v': {
+                    if (m_verboseType != kExtraDebug)
+                    {
+                        m_verboseType = (verbose_type_t)(((int)m_verboseType) + 1);
+                    }
+                    break;
+                }
+
+                case 'I': {
+                    PathSearcher::getGlobalSearcher().addSearchPath(optarg);
+                    break;
+                }
+
+                case 't': {
+                    string transport = optarg;
+                    if (transport == "tcp")
+                    {
+                        m_transport = kTcpTransport;
+                    }
+                    else if (transport == "serial")
+                    {
+                        m_transport = kSerialTransport;
+                    }
+                    else
+                    {
+                        Log::error(format_string("error: unknown transport type %s", transport.c_str()).c_str());
+                        return 1;
+                    }
+                    break;
+                }
+
+                case 'b': {
+                    m_baudrate = strtoul(optarg, NULL, 10);
+                    break;
+                }
+
+                case 'p': {
+                    m_port = optarg;
+                    break;
+                }
+
+                case 'h': {
+                    m_host = optarg;
+                    break;
+                }
+
+                case 'r': {
+                    m_replayFilePath = optarg;
+                    break;
+                }
+
+                case 's': {
+                    m_speed = strtod(optarg, NULL);
+                    break;
+                }
+
+                case 'R': {
+                    m_rate = strtod(optarg, NULL);
+                    break;
+                }
+
+                case 'S': {
+                    m_size = strtoul(optarg, NULL, 10);
+                    break;
+                }
+
+                case 'c': {
+                    m_concurrency = strtoul(optarg, NULL, 10);
+                    break;
+                }
+
+                case 'q': {
+                    m_quantity = strtoull(optarg, NULL, 10);
+                    break;
+                }
+
+                default: {
+                    Log::error("error: unrecognized option\n\n");
+                    printUsage(options);
+                    return 0;
+                }
+            }
+        }
+
+        // handle positional args
+        if (iter.index() < m_argc)
+        {
+            int i;
+            for (i = iter.index(); i < m_argc; ++i)
+            {
+                m_positionalArgs.push_back(m_argv[i]);
+            }
+        }
+
+        // all is well
+        return -1;
+    }
+
+    /*!
+     * @brief Prints help for the tool.
+     *
+     * @param[in] options Options, which can be used.
+     */
+    void printUsage(Options &options)
+    {
+        options.usage(cout, "files...");
+        printf(k_usageText);
+    }
+
+    /*!
+     * @brief Creates and connects the transport of one worker.
+     *
+     * @param[in] crc Crc16 shared by all transports.
+     *
+     * @return Connected transport, NULL on failure.
+     */
+    Transport *createTransport(Crc16 *crc)
+    {
+        Transport *transport = NULL;
+
+        switch (m_transport)
+        {
+            case kTcpTransport: {
+                uint16_t portNumber = strtoul(m_port, NULL, 10);
+                TCPTransport *tcpTransport = new TCPTransport(m_host, portNumber, false);
+                if (tcpTransport->open() != kErpcStatus_Success)
+                {
+                    Log::error("error: cannot connect to %s:%u\n", m_host, portNumber);
+                    delete tcpTransport;
+                    return NULL;
+                }
+                transport = tcpTransport;
+                break;
+            }
+
+            case kSerialTransport: {
+                transport = reinterpret_cast<Transport *>(erpc_transport_serial_init(m_port, m_baudrate));
+                break;
+            }
+
+            default: {
+                break;
+            }
+        }
+
+        if (transport)
+        {
+            transport->setCrc16(crc);
+        }
+
+        return transport;
+    }
+
+    /*!
+     * @brief Core of the tool.
+     *
+     * Calls processOptions() to handle command line options before performing the
+     * real work the tool does.
+     *
+     * @retval 1 The functions wasn't processed successfully.
+     * @retval 0 The function was processed successfully.
+     */
+    int run()
+    {
+        try
+        {
+            // read command line options
+            int result;
+            if ((result = processOptions()) != -1)
+            {
+                return result;
+            }
+
+            // set verbose logging
+            setVerboseLogging();
+
+            // check argument values
+            checkArguments();
+            if (!m_positionalArgs.size())
+            {
+                throw runtime_error("no input file provided");
+            }
+
+            m_ErpcFile = m_positionalArgs[0].c_str();
+
+            // Parse and build definition model.
+            InterfaceDefinition def;
+            def.parse(m_ErpcFile);
+
+            // Check for duplicate function IDs
+            UniqueIdChecker uniqueIdCheck;
+            uniqueIdCheck.makeIdsUnique(def);
+
+            Crc16 crc;
+            if (def.hasProgramSymbol())
+            {
+                Program *program = def.getProgramSymbol();
+                if (program->findAnnotation(CRC_ANNOTATION, Annotation::kC) != nullptr)
+                {
+                    crc.setCrcStart(def.getIdlCrc16());
+                }
+            }
+
+            LoadGenerator generator(&def, [this, &crc]() { return createTransport(&crc); });
+            size_t count = m_replayFilePath ? generator.loadCapture(m_replayFilePath) :
+                                              generator.synthesise(m_size, m_rate);
+            if (count == 0)
+            {
+                throw runtime_error("no requests to send");
+            }
+            Log::info("%u requests loaded\n", static_cast<uint32_t>(count));
+
+            if (generator.run(m_quantity ? m_quantity : count, m_concurrency, m_speed) != kErpcStatus_Success)
+            {
+                return 1;
+            }
+            generator.report(m_outputFilePath);
+            return 0;
+        }
+        catch (exception &e)
+        {
+            Log::error("error: %s\n", e.what());
+            return 1;
+        }
+        catch (...)
+        {
+            Log::error("error: unexpected exception\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /*!
+     * @brief Validate arguments that can be checked.
+     *
+     * @exception runtime_error Thrown if an argument value fails to pass validation.
+     */
+    void checkArguments()
+    {
+        if (m_transport == kNoneTransport)
+        {
+            throw runtime_error("no transport selected");
+        }
+        if ((m_transport == kTcpTransport) && (!m_host || !m_port))
+        {
+            throw runtime_error("tcp transport needs host and port");
+        }
+        if ((m_transport == kSerialTransport) && !m_port)
+        {
+            throw runtime_error("serial transport needs port");
+        }
+        if (m_concurrency == 0)
+        {
+            throw runtime_error("concurrency must not be zero");
+        }
+        if ((m_transport == kSerialTransport) && (m_concurrency != 1))
+        {
+            throw runtime_error("serial transport supports concurrency 1 only");
+        }
+        if ((m_speed < 0) || (m_rate < 0))
+        {
+            throw runtime_error("speed and rate must not be negative");
+        }
+    }
+
+    /*!
+     * @brief Turns on verbose logging.
+     */
+    void setVerboseLogging()
+    {
+        switch (m_verboseType)
+        {
+            case kWarning:
+                Log::getLogger()->setFilterLevel(Logger::kWarning);
+                break;
+            case kInfo:
+                Log::getLogger()->setFilterLevel(Logger::kInfo);
+                break;
+            case kDebug:
+                Log::getLogger()->setFilterLevel(Logger::kDebug);
+                break;
+            case kExtraDebug:
+                Log::getLogger()->setFilterLevel(Logger::kDebug2);
+                break;
+        }
+    }
+};
+
+} // namespace erpcload
+
+/*!
+ * @brief Main application entry point.
+ *
+ * Creates a tool instance and lets it take over.
+ */
+int main(int argc, char *argv[], char *envp[])
+{
+    (void)envp;
+    try
+    {
+        return erpcload::erpcloadTool(argc, argv).run();
+    }
+    catch (...)
+    {
+        Log::error("error: unexpected exception\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__CAPTURE_RING_H_
+#define _EMBEDDED_RPC__CAPTURE_RING_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpcsniffer {
+/*!
+ * @brief One captured eRPC message.
+ */
+struct CapturedMessage
+{
+    uint64_t m_timestamp;        /*!< Receive time in nanoseconds since the Unix epoch. */
+    uint32_t m_channel;          /*!< Channel hash the message was received on. */
+    std::vector<uint8_t> m_data; /*!< Message without framing. */
+};
+
+/*!
+ * @brief Single-producer single-consumer ring of captured messages.
+ *
+ * The capture thread pushes, one consumer (pcapng writer or decoder) pops. Slots keep their
+ * storage, so once every slot has seen a message of the largest size no more allocation
+ * happens. When the consumer falls behind, new messages are dropped and counted instead of
+ * blocking the capture thread.
+ */
+class CaptureRing
+{
+public:
+    /*!
+     * @brief Constructor.
+     *
+     * @param[in] slotCount Count of messages the ring holds.
+     */
+    explicit CaptureRing(uint32_t slotCount)
+    : m_slots(slotCount)
+    , m_head(0)
+    , m_tail(0)
+    , m_dropped(0)
+    , m_closed(false)
+    {
+    }
+
+    /*!
+     * @brief Copy a message into the ring. Called by the producer only.
+     *
+     * @param[in] timestamp Receive time in nanoseconds since the Unix epoch.
+     * @param[in] channel Channel hash.
+     * @param[in] data Message data.
+     * @param[in] length Message length.
+     *
+     * @retval true The message was stored.
+     * @retval false The ring is full, the message was dropped.
+     */
+    bool push(uint64_t timestamp, uint32_t channel, const uint8_t *data, uint32_t length)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= m_slots.size())
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        CapturedMessage &slot = m_slots[head % m_slots.size()];
+        slot.m_timestamp = timestamp;
+        slot.m_channel = channel;
+        slot.m_data.assign(data, data + length);
+        m_head.store(head + 1, std::memory_order_release);
+        m_wake.notify_one();
+        return true;
+    }
+
+    /*!
+     * @brief Mark the end of the capture, the consumer drains the ring and stops.
+     */
+    void close()
+    {
+        m_closed.store(true, std::memory_order_release);
+        m_wake.notify_one();
+    }
+
+    /*!
+     * @brief Wait for the oldest message. Called by the consumer only.
+     *
+     * @return Oldest message, NULL when the ring is closed and empty.
+     */
+    CapturedMessage *waitFront()
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+
+        while (m_head.load(std::memory_order_acquire) == tail)
+        {
+            if (m_closed.load(std::memory_order_acquire))
+            {
+                // Messages pushed right before closing are still consumed.
+                if (m_head.load(std::memory_order_acquire) == tail)
+                {
+                    return NULL;
+                }
+                break;
+            }
+
+            // The producer never takes the lock, so a wakeup may be missed, the timeout bounds it.
+            std::unique_lock<std::mutex> lock(m_wakeLock);
+            m_wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+
+        return &m_slots[tail % m_slots.size()];
+    }
+
+    /*!
+     * @brief Release the message returned by waitFront(). Called by the consumer only.
+     */
+    void pop() { m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /*!
+     * @brief Return count of messages dropped because the ring was full.
+     */
+    uint64_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+protected:
+    std::vector<CapturedMessage> m_slots; /*!< Message slots. */
+    std::atomic<uint64_t> m_head;         /*!< Count of messages pushed. */
+    std::atomic<uint64_t> m_tail;         /*!< Count of messages popped. */
+    std::atomic<uint64_t> m_dropped;      /*!< Count of messages dropped. */
+    std::atomic<bool> m_closed;           /*!< Producer finished. */
+    std::mutex m_wakeLock;                /*!< Lock for waiting on m_wake. */
+    std::condition_variable m_wake;       /*!< Signalled on push and close. */
+};
+} // namespace erpcsniffer
+
+#endif // _EMBEDDED_RPC__CAPTURE_RING_H_
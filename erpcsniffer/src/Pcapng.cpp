@@ -0,0 +1,218 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "Pcapng.h"
+
+#include "format_string.h"
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace erpcsniffer;
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+const uint32_t kSectionHeaderBlock = 0x0A0D0D0AU;     /*!< Section Header Block type. */
+const uint32_t kInterfaceBlock = 0x00000001U;         /*!< Interface Description Block type. */
+const uint32_t kEnhancedPacketBlock = 0x00000006U;    /*!< Enhanced Packet Block type. */
+const uint32_t kByteOrderMagic = 0x1A2B3C4DU;         /*!< Byte order magic in host order. */
+const uint16_t kOptionEnd = 0;                        /*!< opt_endofopt. */
+const uint16_t kOptionTsResol = 9;                    /*!< if_tsresol. */
+const uint32_t kMaxBlockLength = 16U * 1024U * 1024U; /*!< Longer blocks are treated as damage. */
+
+/*!
+ * @brief Append a value in host byte order.
+ */
+template <typename T>
+void append(string &body, T value)
+{
+    body.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/*!
+ * @brief Read a value in host byte order.
+ */
+template <typename T>
+T extract(const string &body, size_t offset)
+{
+    T value;
+    memcpy(&value, body.data() + offset, sizeof(value));
+    return value;
+}
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+PcapngWriter::PcapngWriter(const char *filePath)
+: m_file(filePath, ofstream::out | ofstream::binary)
+{
+    if (!m_file.is_open())
+    {
+        throw runtime_error(format_string("could not open capture file '%s'", filePath));
+    }
+
+    string section;
+    append<uint32_t>(section, kByteOrderMagic);
+    append<uint16_t>(section, 1); // major version
+    append<uint16_t>(section, 0); // minor version
+    append<int64_t>(section, -1); // section length not known
+    writeBlock(kSectionHeaderBlock, section);
+
+    string interface;
+    append<uint16_t>(interface, kPcapngLinkType);
+    append<uint16_t>(interface, 0); // reserved
+    append<uint32_t>(interface, 0); // no snap length
+    append<uint16_t>(interface, kOptionTsResol);
+    append<uint16_t>(interface, 1);
+    append<uint8_t>(interface, 9); // 10^-9 s
+    interface.append(3, '\0');     // option padding
+    append<uint16_t>(interface, kOptionEnd);
+    append<uint16_t>(interface, 0);
+    writeBlock(kInterfaceBlock, interface);
+}
+
+void PcapngWriter::write(const CapturedMessage &message)
+{
+    uint32_t length = sizeof(uint32_t) + message.m_data.size();
+    uint8_t channel[sizeof(uint32_t)] = { static_cast<uint8_t>(message.m_channel),
+                                          static_cast<uint8_t>(message.m_channel >> 8),
+                                          static_cast<uint8_t>(message.m_channel >> 16),
+                                          static_cast<uint8_t>(message.m_channel >> 24) };
+
+    string packet;
+    packet.reserve(20 + length + 3);
+    append<uint32_t>(packet, 0); // interface
+    append<uint32_t>(packet, static_cast<uint32_t>(message.m_timestamp >> 32));
+    append<uint32_t>(packet, static_cast<uint32_t>(message.m_timestamp));
+    append<uint32_t>(packet, length); // captured length
+    append<uint32_t>(packet, length); // original length
+    packet.append(reinterpret_cast<const char *>(channel), sizeof(channel));
+    packet.append(reinterpret_cast<const char *>(message.m_data.data()), message.m_data.size());
+    writeBlock(kEnhancedPacketBlock, packet);
+}
+
+void PcapngWriter::writeBlock(uint32_t type, const string &body)
+{
+    static const char padding[3] = { 0, 0, 0 };
+    uint32_t paddingSize = (4U - (body.size() % 4U)) % 4U;
+    uint32_t totalLength = 12U + body.size() + paddingSize;
+
+    m_file.write(reinterpret_cast<const char *>(&type), sizeof(type));
+    m_file.write(reinterpret_cast<const char *>(&totalLength), sizeof(totalLength));
+    m_file.write(body.data(), body.size());
+    m_file.write(padding, paddingSize);
+    m_file.write(reinterpret_cast<const char *>(&totalLength), sizeof(totalLength));
+}
+
+PcapngReader::PcapngReader(const char *filePath)
+: m_file(filePath, ifstream::in | ifstream::binary)
+{
+    if (!m_file.is_open())
+    {
+        throw runtime_error(format_string("could not open capture file '%s'", filePath));
+    }
+
+    uint32_t type = 0;
+    m_file.read(reinterpret_cast<char *>(&type), sizeof(type));
+    if (!m_file || (type != kSectionHeaderBlock))
+    {
+        throw runtime_error(format_string("'%s' is not a pcapng file", filePath));
+    }
+    m_file.seekg(0);
+}
+
+bool PcapngReader::read(CapturedMessage &message)
+{
+    string body;
+
+    while (true)
+    {
+        uint32_t header[2];
+        if (!m_file.read(reinterpret_cast<char *>(header), sizeof(header)))
+        {
+            return false;
+        }
+
+        uint32_t type = header[0];
+        uint32_t totalLength = header[1];
+        if ((totalLength < 12U) || (totalLength > kMaxBlockLength) || ((totalLength % 4U) != 0U))
+        {
+            throw runtime_error("damaged pcapng block");
+        }
+
+        // Body and trailing length.
+        body.resize(totalLength - 8U);
+        if (!m_file.read(&body[0], body.size()))
+        {
+            throw runtime_error("truncated pcapng block");
+        }
+        body.resize(totalLength - 12U);
+
+        if (type == kSectionHeaderBlock)
+        {
+            if ((body.size() < 16U) || (extract<uint32_t>(body, 0) != kByteOrderMagic))
+            {
+                throw runtime_error("pcapng section in foreign byte order is not supported");
+            }
+            m_linkTypes.clear();
+            m_ticksPerSecond.clear();
+        }
+        else if ((type == kInterfaceBlock) && (body.size() >= 8U))
+        {
+            uint64_t ticksPerSecond = 1000000U;
+            for (size_t offset = 8U; offset + 4U <= body.size();)
+            {
+                uint16_t code = extract<uint16_t>(body, offset);
+                uint16_t length = extract<uint16_t>(body, offset + 2U);
+                if ((code == kOptionEnd) || (offset + 4U + length > body.size()))
+                {
+                    break;
+                }
+                if ((code == kOptionTsResol) && (length == 1U))
+                {
+                    uint8_t resolution = static_cast<uint8_t>(body[offset + 4U]);
+                    ticksPerSecond = 1U;
+                    for (uint8_t i = 0; i < (resolution & 0x7FU); ++i)
+                    {
+                        ticksPerSecond *= (resolution & 0x80U) ? 2U : 10U;
+                    }
+                }
+                offset += 4U + ((length + 3U) & ~3U);
+            }
+            m_linkTypes.push_back(extract<uint16_t>(body, 0));
+            m_ticksPerSecond.push_back(ticksPerSecond);
+        }
+        else if ((type == kEnhancedPacketBlock) && (body.size() >= 20U))
+        {
+            uint32_t interface = extract<uint32_t>(body, 0);
+            uint32_t capturedLength = extract<uint32_t>(body, 12);
+            if ((interface >= m_linkTypes.size()) || (m_linkTypes[interface] != kPcapngLinkType) ||
+                (capturedLength < sizeof(uint32_t)) || (20U + capturedLength > body.size()))
+            {
+                continue;
+            }
+
+            uint64_t ticks = (static_cast<uint64_t>(extract<uint32_t>(body, 4)) << 32) | extract<uint32_t>(body, 8);
+            uint64_t ticksPerSecond = m_ticksPerSecond[interface];
+            message.m_timestamp = (ticks / ticksPerSecond) * 1000000000U +
+                                  (ticks % ticksPerSecond) * 1000000000U / ticksPerSecond;
+
+            const uint8_t *data = reinterpret_cast<const uint8_t *>(body.data()) + 20U;
+            message.m_channel = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                                (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+            message.m_data.assign(data + sizeof(uint32_t), data + capturedLength);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__PCAPNG_H_
+#define _EMBEDDED_RPC__PCAPNG_H_
+
+#include "CaptureRing.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace erpcsniffer {
+/*!
+ * @brief Link type of captured eRPC messages, LINKTYPE_USER0.
+ *
+ * Each packet holds the channel hash as 32-bit little-endian value followed by the eRPC
+ * message without framing. Wireshark shows it as "DLT_USER0", a Lua dissector can decode it.
+ */
+const uint16_t kPcapngLinkType = 147;
+
+////////////////////////////////////////////////////////////////////////////////
+// Classes
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Writes captured messages as pcapng file.
+ *
+ * The file has one section with one interface of #kPcapngLinkType and nanosecond
+ * timestamps, each message is an Enhanced Packet Block.
+ */
+class PcapngWriter
+{
+public:
+    /*!
+     * @brief Create the file and write section and interface header.
+     *
+     * @param[in] filePath Path of the file to create.
+     *
+     * @exception runtime_error Thrown when the file cannot be created.
+     */
+    explicit PcapngWriter(const char *filePath);
+
+    /*!
+     * @brief Append a message.
+     *
+     * @param[in] message Captured message.
+     */
+    void write(const CapturedMessage &message);
+
+    /*!
+     * @brief Write buffered data to the file.
+     */
+    void flush() { m_file.flush(); }
+
+protected:
+    std::ofstream m_file; /*!< Output file. */
+
+    /*!
+     * @brief Write a block.
+     *
+     * @param[in] type Block type.
+     * @param[in] body Block body, padded to 32 bits here.
+     */
+    void writeBlock(uint32_t type, const std::string &body);
+};
+
+/*!
+ * @brief Reads messages from a pcapng file written by PcapngWriter.
+ *
+ * Blocks other than Enhanced Packet Blocks of #kPcapngLinkType interfaces are skipped,
+ * so files edited by other tools load as well. Only files in host byte order are read.
+ */
+class PcapngReader
+{
+public:
+    /*!
+     * @brief Open the file and check its section header.
+     *
+     * @param[in] filePath Path of the file to read.
+     *
+     * @exception runtime_error Thrown when the file cannot be opened or is not pcapng.
+     */
+    explicit PcapngReader(const char *filePath);
+
+    /*!
+     * @brief Read next message.
+     *
+     * @param[out] message Message read.
+     *
+     * @retval true A message was read.
+     * @retval false The end of the file was reached.
+     *
+     * @exception runtime_error Thrown when the file is damaged.
+     */
+    bool read(CapturedMessage &message);
+
+protected:
+    std::ifstream m_file;                   /*!< Input file. */
+    std::vector<uint16_t> m_linkTypes;      /*!< Link type of each interface of the section. */
+    std::vector<uint64_t> m_ticksPerSecond; /*!< Timestamp resolution of each interface. */
+};
+} // namespace erpcsniffer
+
+#endif // _EMBEDDED_RPC__PCAPNG_H_
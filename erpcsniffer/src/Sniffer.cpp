@@ -11,6 +11,7 @@
 #include "erpc_c/infra/erpc_message_buffer.h"
 
 #include "Logging.h"
+#include "Pcapng.h"
 #include "annotations.h"
 
 #include <boost/algorithm/string.hpp>
@@ -19,6 +20,8 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <thread>
 
 using namespace erpcgen;
 using namespace erpcsniffer;
@@ -30,14 +33,15 @@ using namespace std;
 // Variables
 ////////////////////////////////////////////////////////////////////////////////
 
+//! @brief Time the capture thread sleeps when the transport has no data yet.
+static const chrono::microseconds kCaptureIdleSleep(100);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Code
 ////////////////////////////////////////////////////////////////////////////////
 
 erpc_status_t Sniffer::run()
 {
-    Log::info("receiving messages\n");
-    uint64_t n = 0;
     ofstream outputFileStream;
 
     if (m_outputFilePath)
@@ -45,72 +49,145 @@ erpc_status_t Sniffer::run()
         openFile(outputFileStream);
     }
 
-    chrono::_V2::system_clock::time_point previousTime(chrono::nanoseconds(0));
+    uint64_t n = 0;
+    uint64_t previousTime = 0;
 
-    while (m_quantity == 0 || m_quantity > n)
+    // Offline decode of a capture file.
+    if (m_replayFilePath)
     {
-        ++n;
-
-        // Receive message.
-        uint8_t buf[1024];
-        MessageBuffer message(buf, 1024);
-        erpc_status_t result = m_transport->receive(&message);
-        chrono::_V2::system_clock::time_point currentTime = chrono::high_resolution_clock::now();
-        if (result)
+        PcapngReader reader(m_replayFilePath);
+        CapturedMessage captured;
+        while ((m_quantity == 0 || m_quantity > n) && reader.read(captured))
         {
-            Log::error("message error %d\n", result);
-            return result;
+            decodeMessage(captured, ++n, previousTime, outputFileStream);
         }
+        return kErpcStatus_Success;
+    }
 
-        Log::info("message received\n");
-        m_codec->setBuffer(message);
-
-        // Save time when message was received.
-        time_t now = chrono::system_clock::to_time_t(currentTime);
-        char buffer[80];
-        struct tm *timeinfo;
-        timeinfo = localtime(&now);
-        strftime(buffer, 80, "%T %D", timeinfo);
-
-        // Time difference between current and previous received message.
-        string timeDifference =
-            format_string("%d", (previousTime.time_since_epoch() == chrono::nanoseconds(0)) ?
-                                    0 :
-                                    chrono::duration_cast<chrono::nanoseconds>(currentTime - previousTime).count());
-        uint32_t timeDifferenceSize = timeDifference.size();
-        uint32_t diffCountSpaces = floor((timeDifferenceSize - 1) / 3);
-        for (uint32_t i = 1; i <= diffCountSpaces; ++i)
-        {
-            timeDifference = timeDifference.insert(timeDifferenceSize - i * 3, " ");
-        }
+    // The capture thread only receives and copies, so decoding or writing here cannot make it
+    // miss traffic. When this thread falls behind, the ring fills up and messages are dropped.
+    Log::info("receiving messages\n");
+    CaptureRing ring(m_ringSize);
+    erpc_status_t result = kErpcStatus_Success;
+    thread captureThread(&Sniffer::capture, this, ref(ring), ref(result));
 
-        previousTime = currentTime;
+    unique_ptr<PcapngWriter> writer;
+    if (m_captureFilePath)
+    {
+        writer.reset(new PcapngWriter(m_captureFilePath));
+    }
 
-        // Analyze message.
-        string analyzedMessage = format_string("%lu. ", n);
-        result = analyzeMessage(analyzedMessage, timeDifference.c_str(), buffer);
-        if (result)
+    while (CapturedMessage *captured = ring.waitFront())
+    {
+        ++n;
+        if (writer)
+        {
+            writer->write(*captured);
+        }
+        else
         {
-            Log::error("analyzed message error  %d\n", result);
-            return result;
+            decodeMessage(*captured, n, previousTime, outputFileStream);
         }
+        ring.pop();
+    }
+
+    captureThread.join();
+    if (writer)
+    {
+        writer->flush();
+    }
+
+    Log::info("%lu messages captured\n", n);
+    if (ring.getDropped() != 0)
+    {
+        Log::warning("%lu messages dropped, the capture ring was full\n", ring.getDropped());
+    }
+
+    return result;
+}
 
-        // Print analyzed message.
-        printf("%s", analyzedMessage.c_str());
+void Sniffer::capture(CaptureRing &ring, erpc_status_t &result)
+{
+    // MessageBuffer holds up to 64 KB, the largest frame the length header can announce.
+    vector<uint8_t> buffer(UINT16_MAX);
 
-        // Record message into file.
-        if (outputFileStream.is_open())
+    // Timestamps come from the monotonic clock, shifted once to the Unix epoch.
+    int64_t epochOffset =
+        chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count() -
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    uint64_t n = 0;
+
+    while (m_quantity == 0 || m_quantity > n)
+    {
+        MessageBuffer message(buffer.data(), buffer.size());
+        Hash channel = m_transport->hasMessage();
+        erpc_status_t status = m_transport->receive(channel, &message);
+        if (status == kErpcStatus_Pending)
+        {
+            // Nothing to read yet, leave the CPU to others instead of polling in a tight loop.
+            // Timestamps of messages arriving meanwhile are late by at most this sleep.
+            this_thread::sleep_for(kCaptureIdleSleep);
+            continue;
+        }
+        if (status)
         {
-            outputFileStream.write(analyzedMessage.c_str(), analyzedMessage.size());
+            Log::error("message error %d\n", status);
+            result = status;
+            break;
         }
+
+        uint64_t timestamp =
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count() +
+            epochOffset;
+        ++n;
+        ring.push(timestamp, channel, message.get(), message.getUsed());
     }
 
-    if (m_outputFilePath)
+    ring.close();
+}
+
+void Sniffer::decodeMessage(CapturedMessage &captured, uint64_t n, uint64_t &previousTime,
+                            ofstream &outputFileStream)
+{
+    MessageBuffer message(captured.m_data.data(), captured.m_data.size());
+    message.setUsed(captured.m_data.size());
+    m_codec->setBuffer(message);
+
+    // Time when message was received.
+    time_t seconds = captured.m_timestamp / 1000000000U;
+    char buffer[80];
+    struct tm *timeinfo;
+    timeinfo = localtime(&seconds);
+    strftime(buffer, 80, "%T %D", timeinfo);
+
+    // Time difference between current and previous received message.
+    string timeDifference = format_string("%lu", (previousTime == 0) ? 0 : captured.m_timestamp - previousTime);
+    uint32_t timeDifferenceSize = timeDifference.size();
+    uint32_t diffCountSpaces = floor((timeDifferenceSize - 1) / 3);
+    for (uint32_t i = 1; i <= diffCountSpaces; ++i)
     {
-        outputFileStream.close();
+        timeDifference = timeDifference.insert(timeDifferenceSize - i * 3, " ");
     }
 
-    return kErpcStatus_Success;
+    previousTime = captured.m_timestamp;
+
+    // Analyze message. A message which cannot be decoded does not stop the capture.
+    string analyzedMessage = format_string("%lu. ", n);
+    erpc_status_t result = analyzeMessage(analyzedMessage, timeDifference.c_str(), buffer);
+    if (result)
+    {
+        Log::error("analyzed message error  %d\n", result);
+        return;
+    }
+
+    // Print analyzed message.
+    printf("%s", analyzedMessage.c_str());
+
+    // Record message into file.
+    if (outputFileStream.is_open())
+    {
+        outputFileStream.write(analyzedMessage.c_str(), analyzedMessage.size());
+    }
 }
 
 void Sniffer::openFile(ofstream &outputFileStream)
@@ -13,6 +13,7 @@
 #include "erpc_c/infra/erpc_transport.h"
 
 #include "CGenerator.h"
+#include "CaptureRing.h"
 
 #include <chrono>
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,14 +36,21 @@ public:
      * @param[in] def Contains information parsed from IDL.
      * @param[in] outputFilePath Path to output file used for record output.
      * @param[in] quantity How much messages record.
+     * @param[in] captureFilePath Path to pcapng file the messages are written to instead of decoding them, or NULL.
+     * @param[in] replayFilePath Path to pcapng file decoded instead of receiving messages, or NULL.
+     * @param[in] ringSize Count of messages buffered between the capture thread and decoding.
      */
     Sniffer(erpc::Transport *transport, erpcgen::InterfaceDefinition *def, const char *outputFilePath,
-            uint64_t quantity)
+            uint64_t quantity, const char *captureFilePath = NULL, const char *replayFilePath = NULL,
+            uint32_t ringSize = 4096)
     : m_transport(transport)
     , m_interfaces(def->getGlobals().getSymbolsOfType(erpcgen::Symbol::kInterfaceSymbol))
     , m_outputFilePath(outputFilePath)
     , m_quantity(quantity)
-    , m_codec(new erpc::BasicCodec()){};
+    , m_codec(new erpc::BasicCodec())
+    , m_captureFilePath(captureFilePath)
+    , m_replayFilePath(replayFilePath)
+    , m_ringSize(ringSize){};
 
     /*!
      * @brief This function is destructor of Sniffer class.
@@ -52,8 +60,10 @@ public:
     /*!
      * @brief This function run sniffer tool.
      *
-     * Application will call receive function through set transport in loop.
-     * Each message is analyzed and stored in file of output file destination is set.
+     * A capture thread receives messages through set transport into a ring buffer, this thread
+     * takes them from the ring. Each message is either written to the capture file, or analyzed
+     * and stored in file of output file destination is set. With a replay file set, messages are
+     * read from it instead of the transport.
      */
     virtual erpc_status_t run();
 
@@ -63,6 +73,30 @@ protected:
     const char *m_outputFilePath;                       /*!< Path to the file for recording output. */
     uint64_t m_quantity;                                /*!< Number of messages to catch. */
     erpc::Codec *m_codec;                               /*!< Codec type used in eRPC applications */
+    const char *m_captureFilePath;                      /*!< Path to the pcapng file for recording messages. */
+    const char *m_replayFilePath;                       /*!< Path to the pcapng file for decoding offline. */
+    uint32_t m_ringSize;                                /*!< Count of messages the capture ring holds. */
+
+    /*!
+     * @brief This function receives messages into the ring buffer, run by the capture thread.
+     *
+     * It stops after the requested quantity of messages or on the first receive error.
+     *
+     * @param[in,out] ring Ring buffer the messages are copied into, closed on return.
+     * @param[out] result Receive error, left unchanged when there was none.
+     */
+    void capture(CaptureRing &ring, erpc_status_t &result);
+
+    /*!
+     * @brief This function analyzes captured message, prints it and records it into output file.
+     *
+     * @param[in] captured Captured message.
+     * @param[in] n Number of the message.
+     * @param[in,out] previousTime Receive time of the previous message, 0 for the first one.
+     * @param[in,out] outputFileStream Output stream used for recording outputs.
+     */
+    void decodeMessage(CapturedMessage &captured, uint64_t n, uint64_t &previousTime,
+                       std::ofstream &outputFileStream);
 
     /*!
      * @brief This function will create and open file for recording outputs.
@@ -59,6 +59,9 @@ static const char *k_optionsDefinition[] = { "?|help",
                                              "b:baudrate <baudrate>",
                                              "p:port <port>",
                                              "h:host <host>",
+                                             "w:write <filePath>",
+                                             "r:read <filePath>",
+                                             "B:buffers <count>",
                                              NULL };
 
 /*! Help string. */
@@ -74,6 +77,9 @@ const char k_usageText[] =
   -b/--baudrate <baudrate>     Baud rate.\n\
   -p/--port <port>             Port name or port number.\n\
   -h/--host <host>             Host definition.\n\
+  -w/--write <filePath>        Write captured messages to pcapng file instead of decoding them\n\
+  -r/--read <filePath>         Decode messages from pcapng file instead of a transport\n\
+  -B/--buffers <count>         Count of messages buffered for decoding (default 4096)\n\
 \n\
 Available transports (use with -t option):\n\
   tcp      Tcp transport type (host, port number).\n\
@@ -118,11 +124,14 @@ protected:
     const char *m_outputFilePath; /*!< Path to the output file. */
     const char *m_ErpcFile;       /*!< ERPC file. */
     string_vector_t m_positionalArgs;
-    transports_t m_transport; /*!< Transport used for receiving messages. */
-    uint64_t m_quantity;      /*!< Quantity of logs to store. */
-    uint32_t m_baudrate;      /*!< Baudrate rate speed. */
-    const char *m_port;       /*!< Name or number of port. Based on used transport. */
-    const char *m_host;       /*!< Host name */
+    transports_t m_transport;      /*!< Transport used for receiving messages. */
+    uint64_t m_quantity;           /*!< Quantity of logs to store. */
+    uint32_t m_baudrate;           /*!< Baudrate rate speed. */
+    const char *m_port;            /*!< Name or number of port. Based on used transport. */
+    const char *m_host;            /*!< Host name */
+    const char *m_captureFilePath; /*!< Path to the pcapng file to write. */
+    const char *m_replayFilePath;  /*!< Path to the pcapng file to decode. */
+    uint32_t m_ringSize;           /*!< Count of messages buffered between capture and decoding. */
 
 public:
     /*!
@@ -145,6 +154,9 @@ public:
     , m_baudrate(115200)
     , m_port(NULL)
     , m_host(NULL)
+    , m_captureFilePath(NULL)
+    , m_replayFilePath(NULL)
+    , m_ringSize(4096)
     {
         // create logger instance
         m_logger = new StdoutLogger();
@@ -251,6 +263,21 @@ public:
                     break;
                 }
 
+                case 'w': {
+                    m_captureFilePath = optarg;
+                    break;
+                }
+
+                case 'r': {
+                    m_replayFilePath = optarg;
+                    break;
+                }
+
+                case 'B': {
+                    m_ringSize = strtoul(optarg, NULL, 10);
+                    break;
+                }
+
                 default: {
                     Log::error("error: unrecognized option\n\n");
                     printUsage(options);
@@ -333,7 +360,7 @@ public:
             UniqueIdChecker uniqueIdCheck;
             uniqueIdCheck.makeIdsUnique(def);
 
-            Transport *_transport;
+            Transport *_transport = NULL;
             switch (m_transport)
             {
                 case kTcpTransport: {
@@ -368,8 +395,15 @@ public:
                     crc.setCrcStart(def.getIdlCrc16());
                 }
             }
-            _transport->setCrc16(&crc);
-            Sniffer s(_transport, &def, m_outputFilePath, m_quantity);
+            if (_transport)
+            {
+                _transport->setCrc16(&crc);
+            }
+            else if (!m_replayFilePath)
+            {
+                throw runtime_error("no transport selected");
+            }
+            Sniffer s(_transport, &def, m_outputFilePath, m_quantity, m_captureFilePath, m_replayFilePath, m_ringSize);
             return s.run();
         }
         catch (exception &e)
@@ -397,6 +431,14 @@ public:
         //      {
         //          throw runtime_error("no output file was specified");
         //      }
+        if (m_ringSize == 0)
+        {
+            throw runtime_error("buffers count must not be zero");
+        }
+        if (m_captureFilePath && m_replayFilePath)
+        {
+            throw runtime_error("cannot write and read a capture file at once");
+        }
     }
 
     /*!
@@ -0,0 +1,735 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_basic_codec.h"
+#include "erpc_client_manager.h"
+#include "erpc_compact_codec.h"
+#include "erpc_crc16.h"
+#include "erpc_crc32c.h"
+#include "erpc_fast_transport.h"
+#include "erpc_framed_transport.h"
+#include "erpc_inter_thread_buffer_transport.h"
+#include "erpc_mbf_setup.h"
+#include "erpc_simple_server.h"
+#include "erpc_tcp_transport.h"
+#include "erpc_threading.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Size of message buffers, large enough for the biggest end-to-end payload.
+static const uint32_t kBufferSize = 4096U;
+
+//! @brief Service and methods of the end-to-end benchmarks.
+static const uint32_t kBenchServiceId = 1U;
+static const Hash kEchoMethodId = 1U;
+static const Hash kStopMethodId = 2U;
+
+/*!
+ * @brief One benchmark result, printed as one JSON object.
+ */
+struct BenchResult
+{
+    std::string suite;    //!< Group of the benchmark (codec, crc, framing, ...).
+    std::string name;     //!< Benchmark name, unique within the suite.
+    uint64_t iterations;  //!< Measured operations.
+    double nsPerOp;       //!< Mean time of one operation.
+    double opsPerSec;     //!< Operations per second.
+    uint32_t bytesPerOp;  //!< Payload bytes processed by one operation, 0 if not applicable.
+};
+
+/*!
+ * @brief Message buffer factory of the benchmarks, allocates kBufferSize buffers.
+ */
+class BenchMessageBufferFactory : public MessageBufferFactory
+{
+public:
+    virtual MessageBuffer create(void) override
+    {
+        uint8_t *buf = new uint8_t[kBufferSize];
+        return MessageBuffer(buf, kBufferSize);
+    }
+
+    virtual void dispose(MessageBuffer *buf) override
+    {
+        if (buf->get() != NULL)
+        {
+            delete[] buf->get();
+        }
+    }
+};
+
+/*!
+ * @brief Byte queue shared by the loopback transports, the sent bytes are received back.
+ */
+class LoopbackPipe
+{
+public:
+    uint32_t write(const uint8_t *data, uint32_t size)
+    {
+        m_bytes.insert(m_bytes.end(), data, data + size);
+        return size;
+    }
+
+    erpc_status_t read(uint8_t *data, uint32_t size)
+    {
+        if (m_bytes.size() < size)
+        {
+            return kErpcStatus_ReceiveFailed;
+        }
+        std::copy(m_bytes.begin(), m_bytes.begin() + size, data);
+        m_bytes.erase(m_bytes.begin(), m_bytes.begin() + size);
+        return kErpcStatus_Success;
+    }
+
+private:
+    std::deque<uint8_t> m_bytes;
+};
+
+/*!
+ * @brief FramedTransport receiving what it sent, measures the framing without any I/O.
+ */
+class LoopbackFramedTransport : public FramedTransport
+{
+public:
+    virtual void flush(void) override {}
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &, const uint8_t *data, uint32_t size) override
+    {
+        return m_pipe.write(data, size);
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &, uint8_t *data, uint32_t size) override
+    {
+        return m_pipe.read(data, size);
+    }
+
+    LoopbackPipe m_pipe;
+};
+
+/*!
+ * @brief FastTransport receiving what it sent.
+ */
+class LoopbackFastTransport : public FastTransport
+{
+public:
+    virtual void flush(void) override {}
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &, const uint8_t *data, uint32_t size) override
+    {
+        return m_pipe.write(data, size);
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &, uint8_t *data, uint32_t size) override
+    {
+        return m_pipe.read(data, size);
+    }
+
+    LoopbackPipe m_pipe;
+};
+
+/*!
+ * @brief Service of the end-to-end benchmarks.
+ *
+ * Echo returns the received binary, stop stops the server after its reply was sent.
+ */
+class BenchService : public Service
+{
+public:
+    BenchService(Server *server)
+    : Service(kBenchServiceId)
+    , m_server(server)
+    , m_length(0)
+    {
+    }
+
+    virtual erpc_status_t handleInvocation(Hash methodId, uint32_t sequence, Codec *codec,
+                                           MessageBufferFactory *messageFactory) override
+    {
+        uint32_t length = 0;
+        uint8_t *data = NULL;
+        erpc_status_t err;
+
+        if (methodId == kEchoMethodId)
+        {
+            codec->readBinary(&length, &data);
+            if (codec->isStatusOk())
+            {
+                // The reply is written over the request, keep the payload.
+                memcpy(m_payload, data, length);
+                m_length = length;
+            }
+        }
+        else if (methodId == kStopMethodId)
+        {
+            m_server->stop();
+        }
+        else
+        {
+            return kErpcStatus_InvalidArgument;
+        }
+
+        err = codec->getStatus();
+        if (err == kErpcStatus_Success)
+        {
+            err = messageFactory->prepareServerBufferForSend(codec->getBuffer());
+        }
+        if (err == kErpcStatus_Success)
+        {
+            codec->reset();
+            codec->startWriteMessage(kReplyMessage, kBenchServiceId, methodId, sequence);
+            if (methodId == kEchoMethodId)
+            {
+                codec->writeBinary(m_length, m_payload);
+            }
+            err = codec->getStatus();
+        }
+
+        return err;
+    }
+
+private:
+    Server *m_server;
+    uint8_t m_payload[kBufferSize];
+    uint32_t m_length;
+};
+
+/*!
+ * @brief Client and server connected by a pair of transports, the server runs on its own thread.
+ */
+class EndToEnd
+{
+public:
+    EndToEnd(Transport *clientTransport, Transport *serverTransport)
+    : m_serverThread(serverThreadStub, 0, 0, "bench_server")
+    , m_service(&m_server)
+    , m_serverDone(0)
+    {
+        m_client.setMessageBufferFactory(&m_messageFactory);
+        m_client.setCodecFactory(&m_codecFactory);
+        m_client.setTransport(clientTransport);
+
+        m_server.setMessageBufferFactory(&m_messageFactory);
+        m_server.setCodecFactory(&m_codecFactory);
+        m_server.setTransport(serverTransport);
+        m_server.addService(&m_service);
+    }
+
+    void start(void) { m_serverThread.start(this); }
+
+    /*!
+     * @brief Perform one call and check the echoed payload.
+     *
+     * @return True when the call succeeded.
+     */
+    bool call(Hash methodId, const uint8_t *payload, uint32_t length)
+    {
+        RequestContext request = m_client.createRequest(methodId, false, methodId);
+        Codec *codec = request.getCodec();
+        bool ok = (codec != NULL);
+
+        if (ok)
+        {
+            codec->startWriteMessage(kInvocationMessage, kBenchServiceId, methodId, request.getSequence());
+            if (methodId == kEchoMethodId)
+            {
+                codec->writeBinary(length, payload);
+            }
+            request.setState(RequestContextState::SENDING);
+
+            // Stubs are called again while the request is pending, so is the client manager.
+            for (;;)
+            {
+                bool success = m_client.performRequest(request);
+                erpc_status_t err = codec->getStatus();
+                if ((success && (request.getState() == RequestContextState::DONE)) ||
+                    ((err != kErpcStatus_Success) && (err != kErpcStatus_Pending)))
+                {
+                    break;
+                }
+            }
+
+            if (methodId == kEchoMethodId)
+            {
+                uint32_t replyLength = 0;
+                uint8_t *reply = NULL;
+                codec->readBinary(&replyLength, &reply);
+                ok = codec->isStatusOk() && (replyLength == length) && (memcmp(reply, payload, length) == 0);
+            }
+            else
+            {
+                ok = codec->isStatusOk();
+            }
+            m_client.releaseRequest(request);
+        }
+
+        return ok;
+    }
+
+    /*!
+     * @brief Stop the server and wait until its thread returned.
+     */
+    void stop(void)
+    {
+        (void)call(kStopMethodId, NULL, 0);
+        m_serverDone.get();
+    }
+
+private:
+    static void serverThreadStub(void *arg)
+    {
+        EndToEnd *This = reinterpret_cast<EndToEnd *>(arg);
+        (void)This->m_server.run();
+        This->m_serverDone.put();
+    }
+
+    BenchMessageBufferFactory m_messageFactory;
+    BasicCodecFactory m_codecFactory;
+    ClientManager m_client;
+    SimpleServer m_server;
+    Thread m_serverThread;
+    BenchService m_service;
+    Semaphore m_serverDone;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<BenchResult> s_results;
+static double s_minTimeNs = 200e6;
+static const char *s_filter = NULL;
+static uint16_t s_tcpPort = 12345;
+
+//! @brief Keeps the compiler from optimizing the measured code away.
+static volatile uint32_t s_sink;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static double nowNs(void)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*!
+ * @brief Run @a op in growing batches until the batch lasts at least the minimum time.
+ *
+ * @param[in] suite Suite of the benchmark.
+ * @param[in] name Name of the benchmark.
+ * @param[in] bytesPerOp Payload bytes of one operation.
+ * @param[in] op Measured operation.
+ */
+template <typename Op>
+static void bench(const char *suite, const std::string &name, uint32_t bytesPerOp, Op op)
+{
+    std::string fullName = std::string(suite) + "/" + name;
+    uint64_t iterations = 1;
+    double elapsed = 0;
+
+    if ((s_filter != NULL) && (strstr(fullName.c_str(), s_filter) == NULL))
+    {
+        return;
+    }
+
+    // Warm up caches and lazily allocated state.
+    op();
+
+    for (;;)
+    {
+        double start = nowNs();
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            op();
+        }
+        elapsed = nowNs() - start;
+
+        if ((elapsed >= s_minTimeNs) || (iterations >= (1ULL << 40)))
+        {
+            break;
+        }
+
+        // Aim at the minimum time, at most ten times more iterations per round.
+        double scale = (elapsed > 0) ? (s_minTimeNs * 1.2 / elapsed) : 10.0;
+        iterations = static_cast<uint64_t>(iterations * ((scale > 10.0) ? 10.0 : ((scale < 2.0) ? 2.0 : scale)));
+    }
+
+    BenchResult result;
+    result.suite = suite;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = elapsed / iterations;
+    result.opsPerSec = 1e9 / result.nsPerOp;
+    result.bytesPerOp = bytesPerOp;
+    s_results.push_back(result);
+
+    fprintf(stderr, "%-40s %12.1f ns/op %14.0f op/s\n", fullName.c_str(), result.nsPerOp, result.opsPerSec);
+}
+
+/*!
+ * @brief Encode and decode benchmarks of one scalar type.
+ */
+template <typename C, typename T>
+static void benchScalar(const char *suite, const char *typeName, T value)
+{
+    C codec;
+    uint8_t storage[kBufferSize];
+    MessageBuffer buffer(storage, sizeof(storage));
+    const uint32_t count = 64;
+
+    codec.setBuffer(buffer);
+
+    bench(suite, std::string("encode_") + typeName, count * sizeof(T), [&]() {
+        codec.getBuffer()->setUsed(0);
+        codec.reset();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            codec.write(value);
+        }
+    });
+
+    bench(suite, std::string("decode_") + typeName, count * sizeof(T), [&]() {
+        T read;
+        codec.reset();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            codec.read(&read);
+        }
+        s_sink = static_cast<uint32_t>(read);
+    });
+}
+
+/*!
+ * @brief Encode and decode benchmarks of one codec.
+ */
+template <typename C>
+static void benchCodec(const char *suite)
+{
+    C codec;
+    uint8_t storage[kBufferSize];
+    MessageBuffer buffer(storage, sizeof(storage));
+    static const char text[] = "The quick brown fox jumps over the lazy dog";
+    uint8_t binary[1024];
+    uint32_t words[256];
+
+    benchScalar<C, bool>(suite, "bool", true);
+    benchScalar<C, int8_t>(suite, "int8", -5);
+    benchScalar<C, int16_t>(suite, "int16", -500);
+    benchScalar<C, int32_t>(suite, "int32", -500000);
+    benchScalar<C, int64_t>(suite, "int64", -5000000000LL);
+    benchScalar<C, uint8_t>(suite, "uint8", 5U);
+    benchScalar<C, uint16_t>(suite, "uint16", 500U);
+    benchScalar<C, uint32_t>(suite, "uint32", 500000U);
+    benchScalar<C, uint64_t>(suite, "uint64", 5000000000ULL);
+    benchScalar<C, float>(suite, "float", 1.5f);
+    benchScalar<C, double>(suite, "double", 1.5);
+
+    memset(binary, 0xA5, sizeof(binary));
+    for (uint32_t i = 0; i < 256U; ++i)
+    {
+        words[i] = i;
+    }
+    codec.setBuffer(buffer);
+
+    bench(suite, "encode_string", sizeof(text) - 1U, [&]() {
+        codec.getBuffer()->setUsed(0);
+        codec.reset();
+        codec.writeString(sizeof(text) - 1U, text);
+    });
+
+    bench(suite, "decode_string", sizeof(text) - 1U, [&]() {
+        uint32_t length;
+        char *value;
+        codec.reset();
+        codec.readString(&length, &value);
+        s_sink = length;
+    });
+
+    bench(suite, "encode_binary_1024", sizeof(binary), [&]() {
+        codec.getBuffer()->setUsed(0);
+        codec.reset();
+        codec.writeBinary(sizeof(binary), binary);
+    });
+
+    bench(suite, "decode_binary_1024", sizeof(binary), [&]() {
+        uint32_t length;
+        uint8_t *value;
+        codec.reset();
+        codec.readBinary(&length, &value);
+        s_sink = length;
+    });
+
+    bench(suite, "encode_array_uint32_256", sizeof(words), [&]() {
+        codec.getBuffer()->setUsed(0);
+        codec.reset();
+        codec.writeArray(words, 256U);
+    });
+
+    bench(suite, "decode_array_uint32_256", sizeof(words), [&]() {
+        codec.reset();
+        codec.readArray(words, 256U);
+        s_sink = words[255];
+    });
+}
+
+static void benchCrc(void)
+{
+    Crc16 crc16;
+    Crc32c crc32c;
+    static const uint32_t sizes[] = { 16U, 256U, 4096U };
+    uint8_t data[4096];
+
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7U);
+    }
+
+    for (uint32_t size : sizes)
+    {
+        bench("crc", "crc16_" + std::to_string(size), size, [&]() { s_sink = crc16.computeCRC16(data, size); });
+        bench("crc", "crc32c_" + std::to_string(size), size, [&]() { s_sink = crc32c.compute(data, size); });
+    }
+}
+
+static void benchFraming(void)
+{
+    static const uint32_t sizes[] = { 16U, 256U, 2048U };
+    BenchMessageBufferFactory factory;
+    Crc16 crc16;
+    LoopbackFramedTransport framed;
+    LoopbackFastTransport fast;
+    MessageBuffer tx = factory.create();
+    MessageBuffer rx = factory.create();
+
+    framed.setIntegrityCheck(&crc16);
+    memset(tx.get(), 0x5A, tx.getLength());
+
+    for (uint32_t size : sizes)
+    {
+        bench("framing", "framed_send_receive_" + std::to_string(size), size, [&]() {
+            tx.setUsed(size);
+            (void)framed.send(kEchoMethodId, &tx);
+            if (framed.receive(kEchoMethodId, &rx) != kErpcStatus_Success)
+            {
+                fprintf(stderr, "framed loopback failed\n");
+                exit(1);
+            }
+        });
+    }
+
+    bench("framing", "fast_send_receive", sizeof(FastFrame), [&]() {
+        tx.setUsed(sizeof(FastFrame));
+        (void)fast.send(kEchoMethodId, &tx);
+        if (fast.receive(kEchoMethodId, &rx) != kErpcStatus_Success)
+        {
+            fprintf(stderr, "fast loopback failed\n");
+            exit(1);
+        }
+    });
+
+    factory.dispose(&tx);
+    factory.dispose(&rx);
+}
+
+/*!
+ * @brief Create and dispose one buffer of a factory of erpc_setup_mbf_*.cpp per operation.
+ */
+static void benchSetupFactory(const char *name, erpc_mbf_t setupFactory)
+{
+    MessageBufferFactory *factory = reinterpret_cast<MessageBufferFactory *>(setupFactory);
+
+    bench("buffer", std::string(name) + "_create_dispose", 0, [&]() {
+        MessageBuffer buffer = factory->create();
+        if (buffer.get() == NULL)
+        {
+            fprintf(stderr, "%s factory has no buffer\n", name);
+            exit(1);
+        }
+        factory->dispose(&buffer);
+    });
+}
+
+static void benchBufferFactory(void)
+{
+    BasicCodecFactory codecFactory;
+
+    // Setup factories are constructed in place, each of them is initialized once.
+    benchSetupFactory("mbf_dynamic", erpc_mbf_dynamic_init());
+    benchSetupFactory("mbf_static", erpc_mbf_static_init());
+
+    bench("buffer", "codec_create_dispose", 0, [&]() {
+        Codec *codec = codecFactory.create();
+        codecFactory.dispose(codec);
+    });
+}
+
+/*!
+ * @brief Round-trip latency and echo throughput of one client/server pair.
+ */
+static void benchEndToEnd(const char *transportName, EndToEnd &e2e)
+{
+    static const uint32_t sizes[] = { 0U, 64U, 1024U, 3072U };
+    uint8_t payload[3072];
+
+    memset(payload, 0x3C, sizeof(payload));
+    e2e.start();
+
+    for (uint32_t size : sizes)
+    {
+        bench("e2e", std::string(transportName) + "_echo_" + std::to_string(size), size, [&]() {
+            if (!e2e.call(kEchoMethodId, payload, size))
+            {
+                fprintf(stderr, "%s echo failed\n", transportName);
+                exit(1);
+            }
+        });
+    }
+
+    e2e.stop();
+}
+
+static void benchInterThread(void)
+{
+    InterThreadBufferTransport clientTransport;
+    InterThreadBufferTransport serverTransport;
+
+    clientTransport.linkWithPeer(&serverTransport);
+
+    EndToEnd e2e(&clientTransport, &serverTransport);
+    benchEndToEnd("inter_thread", e2e);
+}
+
+static void benchTcp(void)
+{
+    Crc16 crc16;
+    TCPTransport serverTransport("localhost", s_tcpPort, true);
+    TCPTransport clientTransport("localhost", s_tcpPort, false);
+    erpc_status_t err;
+
+    clientTransport.setIntegrityCheck(&crc16);
+    serverTransport.setIntegrityCheck(&crc16);
+
+    (void)serverTransport.open();
+    // The server thread starts listening asynchronously.
+    for (uint32_t retry = 0;; ++retry)
+    {
+        err = clientTransport.open();
+        if ((err == kErpcStatus_Success) || (retry == 100U))
+        {
+            break;
+        }
+        Thread::sleep(10000);
+    }
+    if (err != kErpcStatus_Success)
+    {
+        fprintf(stderr, "tcp: cannot connect to port %u, skipped\n", s_tcpPort);
+        return;
+    }
+
+    EndToEnd e2e(&clientTransport, &serverTransport);
+    benchEndToEnd("tcp", e2e);
+
+    (void)clientTransport.close();
+}
+
+static void printJson(FILE *out)
+{
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < s_results.size(); ++i)
+    {
+        const BenchResult &r = s_results[i];
+        fprintf(out,
+                "    {\"suite\": \"%s\", \"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, "
+                "\"ops_per_sec\": %.1f, \"bytes_per_op\": %u, \"bytes_per_sec\": %.1f}%s\n",
+                r.suite.c_str(), r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.nsPerOp,
+                r.opsPerSec, r.bytesPerOp, r.opsPerSec * r.bytesPerOp, (i + 1U < s_results.size()) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-o results.json] [-t min_time_ms] [-f filter] [-p tcp_port]\n"
+            "  -o  write JSON results to the file instead of stdout\n"
+            "  -t  minimum measured time of each benchmark, default 200 ms\n"
+            "  -f  run only benchmarks whose suite/name contains the filter\n"
+            "  -p  port of the loopback TCP benchmarks, default 12345\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *outputPath = NULL;
+    FILE *out = stdout;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            outputPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            s_minTimeNs = atof(argv[++i]) * 1e6;
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc))
+        {
+            s_filter = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            s_tcpPort = static_cast<uint16_t>(atoi(argv[++i]));
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    benchCodec<BasicCodec>("codec");
+    benchCodec<CompactCodec>("compact_codec");
+    benchCrc();
+    benchFraming();
+    benchBufferFactory();
+    benchInterThread();
+    benchTcp();
+
+    if (outputPath != NULL)
+    {
+        out = fopen(outputPath, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", outputPath);
+            return 1;
+        }
+    }
+    printJson(out);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    return 0;
+}
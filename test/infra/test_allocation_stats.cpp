@@ -0,0 +1,108 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_allocation_stats.h"
+#include "erpc_basic_codec.h"
+#include "erpc_port.h"
+
+#include "gtest.h"
+
+#include <string>
+
+#if !ERPC_ALLOCATION_STATS
+#error "Allocation stats tests need ERPC_ALLOCATION_STATS enabled."
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+uint32_t s_failures;
+std::string s_statement;
+uint64_t s_allocations;
+
+void recordFailure(const char *statement, const char *file, uint32_t line, uint64_t allocations)
+{
+    (void)file;
+    (void)line;
+    ++s_failures;
+    s_statement = statement;
+    s_allocations = allocations;
+}
+
+void failTest(const char *statement, const char *file, uint32_t line, uint64_t allocations)
+{
+    ADD_FAILURE_AT(file, line) << statement << " allocated " << allocations << " blocks";
+}
+
+/*!
+ * @brief Routes failures of ERPC_ASSERT_NO_ALLOCATIONS() to a hook while in scope.
+ */
+class FailureHook
+{
+public:
+    explicit FailureHook(erpc_allocation_failure_t hook)
+    : m_previous(erpc_allocation_stats_set_failure_hook(hook))
+    {
+        s_failures = 0;
+        s_statement.clear();
+        s_allocations = 0;
+    }
+
+    ~FailureHook(void) { (void)erpc_allocation_stats_set_failure_hook(m_previous); }
+
+private:
+    erpc_allocation_failure_t m_previous;
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(AllocationStats, AllocatingStatementCallsFailureHook)
+{
+    FailureHook hook(recordFailure);
+
+    ERPC_ASSERT_NO_ALLOCATIONS(erpc_free(erpc_malloc(4U)), erpc_free(erpc_malloc(8U)));
+
+    EXPECT_EQ(1U, s_failures);
+    EXPECT_EQ(2U, s_allocations);
+    EXPECT_NE(std::string::npos, s_statement.find("erpc_malloc(8U)"));
+}
+
+TEST(AllocationStats, StatementWithoutAllocationPasses)
+{
+    FailureHook hook(recordFailure);
+    int value = 0;
+
+    ERPC_ASSERT_NO_ALLOCATIONS(value += 1);
+
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(0U, s_failures);
+}
+
+TEST(AllocationStats, CodecEncodesWithoutAllocation)
+{
+    FailureHook hook(failTest);
+    uint8_t data[64];
+    MessageBuffer message(data, sizeof(data));
+    BasicCodec codec;
+    const uint8_t payload[] = { 1U, 2U, 3U };
+
+    // Encoding into a caller buffer is on the path of every call, it must not touch the heap.
+    ERPC_ASSERT_NO_ALLOCATIONS(codec.setBuffer(message), codec.startWriteMessage(kInvocationMessage, 1U, 2U, 3U),
+                               codec.writeBinary(sizeof(payload), payload), codec.write(static_cast<uint32_t>(7U)));
+
+    EXPECT_TRUE(codec.isStatusOk());
+}
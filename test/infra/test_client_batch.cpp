@@ -0,0 +1,343 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_basic_codec.h"
+#include "erpc_client_manager.h"
+#include "erpc_crc16.h"
+#include "erpc_crc32c.h"
+#include "erpc_framed_transport.h"
+
+#include "gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Framed transport keeping sent and received bytes apart.
+ */
+class LinkTransport : public FramedTransport
+{
+public:
+    explicit LinkTransport(IntegrityCheck *check) { setIntegrityCheck(check); }
+
+    virtual void flush(void) override {}
+
+    std::vector<uint8_t> m_sent;
+    std::deque<uint8_t> m_received;
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &channel, const uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        m_sent.insert(m_sent.end(), data, data + size);
+        return size;
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &channel, uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        if (m_received.size() < size)
+        {
+            return kErpcStatus_Pending;
+        }
+        std::copy(m_received.begin(), m_received.begin() + size, data);
+        m_received.erase(m_received.begin(), m_received.begin() + size);
+        return kErpcStatus_Success;
+    }
+};
+
+/*!
+ * @brief Message buffers from the heap.
+ */
+class HeapBufferFactory : public MessageBufferFactory
+{
+public:
+    virtual MessageBuffer create(void) override { return MessageBuffer(new uint8_t[256], 256); }
+
+    virtual void dispose(MessageBuffer *buf) override { delete[] buf->get(); }
+};
+
+/*!
+ * @brief Encode a call with a single byte payload and hand it to the client.
+ */
+void performCall(ClientManager &client, RequestContext &request, uint8_t payload)
+{
+    Codec *codec = request.getCodec();
+
+    codec->startWriteMessage(kInvocationMessage, 1U, 2U, request.getSequence());
+    codec->write(payload);
+    request.setState(RequestContextState::SENDING);
+    (void)client.performRequest(request);
+}
+
+/*!
+ * @brief Batch two calls over a framed transport and receive the frame on the other end.
+ */
+void expectBatchPassesCheck(IntegrityCheck *check)
+{
+    LinkTransport link(check);
+    LinkTransport peer(check);
+    HeapBufferFactory buffers;
+    BasicCodecFactory codecs;
+    ClientManager client;
+
+    client.setMessageBufferFactory(&buffers);
+    client.setCodecFactory(&codecs);
+    client.setTransport(&link);
+
+    ASSERT_EQ(kErpcStatus_Success, client.beginBatch());
+    RequestContext first = client.createRequest(1U, false, 2U);
+    RequestContext second = client.createRequest(1U, false, 2U);
+    performCall(client, first, 10U);
+    performCall(client, second, 11U);
+    EXPECT_EQ(kErpcStatus_Pending, client.commitBatch());
+
+    // The count was patched after the calls were appended, the frame check has to cover it.
+    uint8_t data[256];
+    MessageBuffer message(data, sizeof(data));
+    peer.m_received.assign(link.m_sent.begin(), link.m_sent.end());
+    ASSERT_EQ(kErpcStatus_Success, peer.receive(1U, &message));
+
+    BasicCodec codec;
+    message_type_t type;
+    uint32_t service;
+    Hash request;
+    uint32_t sequence;
+    uint16_t count = 0;
+
+    codec.setBuffer(message);
+    codec.startReadMessage(&type, &service, &request, &sequence);
+    codec.read(&count);
+    codec.read(&sequence);
+    EXPECT_EQ(kBatchInvocationMessage, type);
+    ASSERT_EQ(2U, count);
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        uint32_t length = 0;
+        uint8_t *subData = NULL;
+        BasicCodec subCodec;
+        MessageBuffer subMessage;
+        uint8_t payload = 0;
+
+        codec.readBinary(&length, &subData);
+        ASSERT_TRUE(codec.isStatusOk());
+        subMessage = MessageBuffer(subData, static_cast<uint16_t>(length));
+        subMessage.setUsed(static_cast<uint16_t>(length));
+        subCodec.setBuffer(subMessage);
+        subCodec.startReadMessage(&type, &service, &request, &sequence);
+        subCodec.read(&payload);
+        ASSERT_TRUE(subCodec.isStatusOk());
+        EXPECT_EQ(kInvocationMessage, type);
+        EXPECT_EQ(10U + i, payload);
+    }
+
+    client.releaseRequest(first);
+    client.releaseRequest(second);
+}
+
+/*!
+ * @brief Frame a batch reply with two sub-replies into the received bytes of the client link.
+ */
+void sendBatchReply(LinkTransport &client, Hash channel, uint32_t sequence, IntegrityCheck *check)
+{
+    LinkTransport server(check);
+    uint8_t data[256];
+    uint8_t subData[32];
+    MessageBuffer message(data, sizeof(data));
+    BasicCodec codec;
+    uint16_t count = 2U;
+
+    codec.setBuffer(message);
+    codec.startWriteMessage(kBatchReplyMessage, 0, channel, 0);
+    codec.write(count);
+    codec.write(sequence);
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        MessageBuffer subMessage(subData, sizeof(subData));
+        BasicCodec subCodec;
+
+        subCodec.setBuffer(subMessage);
+        subCodec.startWriteMessage(kReplyMessage, 1U, 2U, i);
+        codec.writeBinary(subCodec.getBuffer()->getUsed(), subData);
+    }
+    ASSERT_EQ(kErpcStatus_Success, server.send(channel, codec.getBuffer()));
+    client.m_received.insert(client.m_received.end(), server.m_sent.begin(), server.m_sent.end());
+}
+
+/*!
+ * @brief Send a batch of two calls and return the batch sequence following the call count.
+ */
+uint32_t commitTwoCalls(ClientManager &client, LinkTransport &link, RequestContext &first, RequestContext &second,
+                        IntegrityCheck *check)
+{
+    LinkTransport peer(check);
+    uint8_t data[256];
+    MessageBuffer message(data, sizeof(data));
+    BasicCodec codec;
+    message_type_t type;
+    uint32_t service;
+    Hash request;
+    uint32_t sequence = 0;
+    uint16_t count = 0;
+
+    performCall(client, first, 10U);
+    performCall(client, second, 11U);
+    EXPECT_EQ(kErpcStatus_Pending, client.commitBatch());
+
+    peer.m_received.assign(link.m_sent.begin(), link.m_sent.end());
+    EXPECT_EQ(kErpcStatus_Success, peer.receive(1U, &message));
+    codec.setBuffer(message);
+    codec.startReadMessage(&type, &service, &request, &sequence);
+    codec.read(&count);
+    codec.read(&sequence);
+    EXPECT_TRUE(codec.isStatusOk());
+
+    return sequence;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(ClientBatch, BatchPassesCrc16OfFramedTransport)
+{
+    Crc16 crc;
+
+    expectBatchPassesCheck(&crc);
+}
+
+#if ERPC_HEADER_VERSION != 1U
+// The legacy frame header takes no 32-bit check.
+TEST(ClientBatch, BatchPassesCrc32cOfFramedTransport)
+{
+    Crc32c crc;
+
+    expectBatchPassesCheck(&crc);
+}
+#endif
+
+TEST(ClientBatch, PatchedBufferDropsRunningCheck)
+{
+    Crc16 crc;
+    uint8_t data[32];
+    MessageBuffer message(data, sizeof(data));
+    BasicCodec codec;
+    uint32_t value = 0;
+    uint16_t patch = 5U;
+
+    codec.setIntegrityCheck(&crc);
+    codec.setBuffer(message);
+    codec.write(static_cast<uint16_t>(0));
+    codec.write(static_cast<uint32_t>(7U));
+    ASSERT_TRUE(codec.getBuffer()->getCheckValue(&crc, &value));
+
+    // Patching bytes the check already covers drops it.
+    (void)codec.getBuffer()->write(0, &patch, sizeof(patch));
+    EXPECT_FALSE(codec.getBuffer()->getCheckValue(&crc, &value));
+}
+
+TEST(ClientBatch, StaleBatchReplyIsRejected)
+{
+    Crc16 crc;
+    LinkTransport link(&crc);
+    HeapBufferFactory buffers;
+    BasicCodecFactory codecs;
+    ClientManager client;
+
+    client.setMessageBufferFactory(&buffers);
+    client.setCodecFactory(&codecs);
+    client.setTransport(&link);
+
+    ASSERT_EQ(kErpcStatus_Success, client.beginBatch());
+    RequestContext first = client.createRequest(1U, false, 2U);
+    RequestContext second = client.createRequest(1U, false, 2U);
+    uint32_t sequence = commitTwoCalls(client, link, first, second, &crc);
+
+    // Same count of replies, but the sequence of an earlier batch.
+    sendBatchReply(link, 1U, sequence - 1U, &crc);
+    EXPECT_EQ(kErpcStatus_ExpectedReply, client.commitBatch());
+    (void)client.performRequest(first);
+    EXPECT_NE(RequestContextState::DONE, first.getState());
+    EXPECT_EQ(kErpcStatus_ExpectedReply, first.getCodec()->getStatus());
+
+    client.releaseRequest(first);
+    client.releaseRequest(second);
+}
+
+TEST(ClientBatch, BatchReplyWithItsSequenceIsAccepted)
+{
+    Crc16 crc;
+    LinkTransport link(&crc);
+    HeapBufferFactory buffers;
+    BasicCodecFactory codecs;
+    ClientManager client;
+
+    client.setMessageBufferFactory(&buffers);
+    client.setCodecFactory(&codecs);
+    client.setTransport(&link);
+
+    ASSERT_EQ(kErpcStatus_Success, client.beginBatch());
+    RequestContext first = client.createRequest(1U, false, 2U);
+    RequestContext second = client.createRequest(1U, false, 2U);
+    uint32_t sequence = commitTwoCalls(client, link, first, second, &crc);
+
+    sendBatchReply(link, 1U, sequence, &crc);
+    EXPECT_EQ(kErpcStatus_Success, client.commitBatch());
+    EXPECT_TRUE(client.performRequest(first));
+    EXPECT_EQ(RequestContextState::DONE, first.getState());
+
+    client.releaseRequest(first);
+    client.releaseRequest(second);
+}
+
+TEST(ClientDecodeStorage, StorageIsKeptWhileRequestsAreOutstanding)
+{
+    Crc16 crc;
+    LinkTransport link(&crc);
+    HeapBufferFactory buffers;
+    BasicCodecFactory codecs;
+    ClientManager client;
+    uint8_t storage[64];
+
+    client.setMessageBufferFactory(&buffers);
+    client.setCodecFactory(&codecs);
+    client.setTransport(&link);
+    client.setDecodeStorage(storage, sizeof(storage));
+
+    RequestContext first = client.createRequest(1U, false, 2U);
+    uint8_t *decoded = static_cast<uint8_t *>(first.getCodec()->allocate(8U));
+    ASSERT_TRUE(decoded != NULL);
+    memset(decoded, 0xA5, 8U);
+
+    // Starting a second call must not hand out the memory of the first one again.
+    RequestContext second = client.createRequest(1U, false, 2U);
+    uint8_t *other = static_cast<uint8_t *>(second.getCodec()->allocate(8U));
+    ASSERT_TRUE(other != NULL);
+    EXPECT_NE(decoded, other);
+
+    client.releaseRequest(first);
+    client.releaseRequest(second);
+
+    // Once no call is outstanding, the next one starts with the whole storage.
+    RequestContext third = client.createRequest(1U, false, 2U);
+    EXPECT_EQ(static_cast<void *>(decoded), third.getCodec()->allocate(8U));
+    client.releaseRequest(third);
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc16.h"
+#include "erpc_crc32c.h"
+#include "erpc_framed_transport.h"
+
+#include "gtest.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#if !ERPC_COBS_FRAMING
+#error "COBS tests need ERPC_COBS_FRAMING enabled."
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Framed transport over an in-memory byte stream, received in chunks of limited size.
+ */
+class LoopbackTransport : public FramedTransport
+{
+public:
+    explicit LoopbackTransport(IntegrityCheck *check)
+    {
+        // The legacy header takes no 32-bit check, COBS frames carry it whole.
+        setFraming(kFramingCobs);
+        (void)setIntegrityCheck(check);
+    }
+
+    virtual void flush(void) override {}
+
+    std::deque<uint8_t> m_link;
+    uint32_t m_maxChunk = 64U;
+    uint32_t m_receiveCalls = 0;
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &channel, const uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        m_link.insert(m_link.end(), data, data + size);
+        return size;
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &channel, uint8_t *data, uint32_t size) override
+    {
+        uint32_t received = 0;
+        erpc_status_t err = kErpcStatus_Success;
+
+        while ((err == kErpcStatus_Success) && (received < size))
+        {
+            uint32_t chunk = 0;
+            err = underlyingReceiveSome(channel, &data[received], size - received, &chunk);
+            received += chunk;
+        }
+        return err;
+    }
+
+    virtual erpc_status_t underlyingReceiveSome(const Hash &channel, uint8_t *data, uint32_t size,
+                                                uint32_t *received) override
+    {
+        (void)channel;
+        uint32_t count = std::min(std::min(size, m_maxChunk), static_cast<uint32_t>(m_link.size()));
+
+        ++m_receiveCalls;
+        if (count == 0U)
+        {
+            return kErpcStatus_Pending;
+        }
+        std::copy(m_link.begin(), m_link.begin() + count, data);
+        m_link.erase(m_link.begin(), m_link.begin() + count);
+        *received = count;
+        return kErpcStatus_Success;
+    }
+};
+
+/*!
+ * @brief Payload of given length, with zero bytes at various places.
+ */
+std::vector<uint8_t> makePayload(uint32_t length, uint32_t seed)
+{
+    std::vector<uint8_t> payload(length);
+
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        payload[i] = (((i + seed) % 7U) == 0U) ? 0U : static_cast<uint8_t>(i * 31U + seed);
+    }
+    return payload;
+}
+
+erpc_status_t sendPayload(Transport &transport, std::vector<uint8_t> payload)
+{
+    MessageBuffer message(payload.data(), static_cast<uint16_t>(payload.size()));
+
+    message.setUsed(static_cast<uint16_t>(payload.size()));
+    return transport.send(1U, &message);
+}
+
+erpc_status_t receivePayload(Transport &transport, std::vector<uint8_t> &payload)
+{
+    uint8_t data[1024];
+    MessageBuffer message(data, sizeof(data));
+    erpc_status_t err = transport.receive(1U, &message);
+
+    payload.assign(data, data + ((err == kErpcStatus_Success) ? message.getUsed() : 0U));
+    return err;
+}
+
+/*!
+ * @brief Receive until a frame arrives or the link runs dry, counting the dropped frames.
+ */
+erpc_status_t receiveNextGood(Transport &transport, std::vector<uint8_t> &payload, uint32_t *dropped)
+{
+    erpc_status_t err;
+
+    *dropped = 0;
+    while (((err = receivePayload(transport, payload)) != kErpcStatus_Success) && (err != kErpcStatus_Pending))
+    {
+        ++*dropped;
+    }
+    return err;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(CobsFraming, RoundTripOfEveryLength)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> received;
+
+    // Covers frames shorter and longer than one 254 byte block, and block ends on zero bytes.
+    for (uint32_t length = 1U; length <= 800U; ++length)
+    {
+        std::vector<uint8_t> payload = makePayload(length, length);
+
+        transport.m_maxChunk = 1U + (length % 70U);
+        ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, payload)) << "length " << length;
+        ASSERT_EQ(kErpcStatus_Success, receivePayload(transport, received)) << "length " << length;
+        ASSERT_EQ(payload, received) << "length " << length;
+        ASSERT_TRUE(transport.m_link.empty());
+    }
+}
+
+TEST(CobsFraming, RoundTripOfZeroAndFullBlocks)
+{
+    Crc32c crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> received;
+    static const uint32_t lengths[] = { 1U, 253U, 254U, 255U, 508U, 509U };
+
+    for (uint32_t length : lengths)
+    {
+        std::vector<uint8_t> zeros(length, 0U);
+        std::vector<uint8_t> ones(length, 0xFFU);
+
+        ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, zeros));
+        ASSERT_EQ(kErpcStatus_Success, receivePayload(transport, received));
+        EXPECT_EQ(zeros, received) << "length " << length;
+
+        ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, ones));
+        ASSERT_EQ(kErpcStatus_Success, receivePayload(transport, received));
+        EXPECT_EQ(ones, received) << "length " << length;
+    }
+}
+
+TEST(CobsFraming, FramesSharingAChunkAreKeptApart)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> received;
+
+    for (uint32_t i = 0; i < 5U; ++i)
+    {
+        ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, makePayload(10U + i, i)));
+    }
+
+    transport.m_maxChunk = 1024U;
+    for (uint32_t i = 0; i < 5U; ++i)
+    {
+        ASSERT_EQ(kErpcStatus_Success, receivePayload(transport, received));
+        EXPECT_EQ(makePayload(10U + i, i), received);
+    }
+    EXPECT_EQ(kErpcStatus_Pending, receivePayload(transport, received));
+}
+
+TEST(CobsFraming, ReceivesInChunksNotBytes)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> received;
+
+    ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, makePayload(600U, 3U)));
+    transport.m_maxChunk = 1024U;
+    ASSERT_EQ(kErpcStatus_Success, receivePayload(transport, received));
+
+    // 600 encoded bytes in staging buffer sized chunks, not one call per byte.
+    EXPECT_LE(transport.m_receiveCalls, 12U);
+}
+
+TEST(CobsFraming, PartialFrameIsPending)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> payload = makePayload(100U, 1U);
+
+    uint8_t data[256];
+    MessageBuffer message(data, sizeof(data));
+
+    ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, payload));
+    std::deque<uint8_t> rest(transport.m_link.begin() + 40, transport.m_link.end());
+    transport.m_link.erase(transport.m_link.begin() + 40, transport.m_link.end());
+
+    EXPECT_EQ(kErpcStatus_Pending, transport.receive(1U, &message));
+
+    Hash channel = 0;
+    EXPECT_EQ(1U, transport.pendingChannels(&channel, 1U));
+    EXPECT_EQ(1U, channel);
+
+    // The receive is resumed into the same buffer.
+    transport.m_link = rest;
+    ASSERT_EQ(kErpcStatus_Success, transport.receive(1U, &message));
+    EXPECT_EQ(payload, std::vector<uint8_t>(data, data + message.getUsed()));
+}
+
+TEST(CobsFraming, ResyncAfterCorruptedByte)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> received;
+    std::vector<uint8_t> first = makePayload(300U, 5U);
+    std::vector<uint8_t> second = makePayload(40U, 6U);
+
+    // Flip a byte at each position of the first frame in turn, into zero and into another value.
+    for (uint32_t corruptZero = 0; corruptZero < 2U; ++corruptZero)
+    {
+        ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, first));
+        size_t firstLength = transport.m_link.size();
+        ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, second));
+        std::deque<uint8_t> clean = transport.m_link;
+        transport.m_link.clear();
+
+        for (size_t position = 0; position < (firstLength - 1U); ++position)
+        {
+            uint32_t dropped = 0;
+
+            transport.m_link = clean;
+            transport.m_link[position] = (corruptZero != 0U) ? 0U : static_cast<uint8_t>(clean[position] ^ 0x5AU);
+            if ((transport.m_link[position] == 0U) && (corruptZero == 0U))
+            {
+                transport.m_link[position] = 0x01U;
+            }
+
+            ASSERT_EQ(kErpcStatus_Success, receiveNextGood(transport, received, &dropped)) << "position " << position;
+            EXPECT_GE(dropped, 1U) << "position " << position;
+            EXPECT_EQ(second, received) << "position " << position;
+            EXPECT_TRUE(transport.m_link.empty()) << "position " << position;
+        }
+    }
+}
+
+TEST(CobsFraming, ResyncAfterDroppedByte)
+{
+    Crc32c crc;
+    LoopbackTransport transport(&crc);
+    std::vector<uint8_t> received;
+    std::vector<uint8_t> second = makePayload(20U, 9U);
+    uint32_t dropped = 0;
+
+    ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, makePayload(50U, 8U)));
+    transport.m_link.erase(transport.m_link.begin() + 25);
+    ASSERT_EQ(kErpcStatus_Success, sendPayload(transport, second));
+
+    ASSERT_EQ(kErpcStatus_Success, receiveNextGood(transport, received, &dropped));
+    EXPECT_EQ(1U, dropped);
+    EXPECT_EQ(second, received);
+}
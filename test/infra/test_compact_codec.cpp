@@ -0,0 +1,211 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_compact_codec.h"
+
+#include "gtest.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Codec over its own storage, written first and then read back.
+ */
+class CodecFixture
+{
+public:
+    CodecFixture(void)
+    : m_buffer(m_storage, sizeof(m_storage))
+    {
+        m_codec.setBuffer(m_buffer);
+    }
+
+    //! Start reading what was written so far.
+    void rewind(void)
+    {
+        m_codec.reset();
+    }
+
+    //! Replace the buffer content with raw bytes.
+    void setBytes(const std::vector<uint8_t> &bytes)
+    {
+        m_codec.getBuffer()->setUsed(0);
+        m_codec.reset();
+        (void)m_codec.getBuffer()->write(0, bytes.data(), static_cast<uint32_t>(bytes.size()));
+        m_codec.getBuffer()->setUsed(static_cast<uint16_t>(bytes.size()));
+    }
+
+    uint16_t used(void) { return m_codec.getBuffer()->getUsed(); }
+
+    uint8_t m_storage[256];
+    MessageBuffer m_buffer;
+    CompactCodec m_codec;
+};
+
+/*!
+ * @brief Write a value, check its encoded size and read it back.
+ */
+template <typename T>
+void expectRoundTrip(T value, uint16_t encodedSize)
+{
+    CodecFixture fixture;
+    T read = 0;
+
+    fixture.m_codec.write(value);
+    ASSERT_TRUE(fixture.m_codec.isStatusOk());
+    EXPECT_EQ(encodedSize, fixture.used()) << "value " << +value;
+
+    fixture.rewind();
+    fixture.m_codec.read(&read);
+    EXPECT_TRUE(fixture.m_codec.isStatusOk());
+    EXPECT_EQ(value, read);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(CompactCodec, UnsignedVarintEdges)
+{
+    expectRoundTrip<uint16_t>(0U, 1U);
+    expectRoundTrip<uint16_t>(127U, 1U);
+    expectRoundTrip<uint16_t>(128U, 2U);
+    expectRoundTrip<uint16_t>(16383U, 2U);
+    expectRoundTrip<uint16_t>(16384U, 3U);
+    expectRoundTrip<uint16_t>(UINT16_MAX, 3U);
+
+    expectRoundTrip<uint32_t>(0U, 1U);
+    expectRoundTrip<uint32_t>(127U, 1U);
+    expectRoundTrip<uint32_t>(128U, 2U);
+    expectRoundTrip<uint32_t>(0x1FFFFFU, 3U);
+    expectRoundTrip<uint32_t>(0x200000U, 4U);
+    expectRoundTrip<uint32_t>(0xFFFFFFFU, 4U);
+    expectRoundTrip<uint32_t>(0x10000000U, 5U);
+    expectRoundTrip<uint32_t>(UINT32_MAX, 5U);
+
+    expectRoundTrip<uint64_t>(0U, 1U);
+    expectRoundTrip<uint64_t>(0x7FFFFFFFFFFFFFFFULL, 9U);
+    expectRoundTrip<uint64_t>(0x8000000000000000ULL, 10U);
+    expectRoundTrip<uint64_t>(UINT64_MAX, 10U);
+}
+
+TEST(CompactCodec, ZigzagEdges)
+{
+    expectRoundTrip<int16_t>(0, 1U);
+    expectRoundTrip<int16_t>(-1, 1U);
+    expectRoundTrip<int16_t>(1, 1U);
+    expectRoundTrip<int16_t>(-64, 1U);
+    expectRoundTrip<int16_t>(63, 1U);
+    expectRoundTrip<int16_t>(-65, 2U);
+    expectRoundTrip<int16_t>(64, 2U);
+    expectRoundTrip<int16_t>(INT16_MIN, 3U);
+    expectRoundTrip<int16_t>(INT16_MAX, 3U);
+
+    expectRoundTrip<int32_t>(-64, 1U);
+    expectRoundTrip<int32_t>(63, 1U);
+    expectRoundTrip<int32_t>(-8192, 2U);
+    expectRoundTrip<int32_t>(8191, 2U);
+    expectRoundTrip<int32_t>(8192, 3U);
+    expectRoundTrip<int32_t>(INT32_MIN, 5U);
+    expectRoundTrip<int32_t>(INT32_MAX, 5U);
+
+    expectRoundTrip<int64_t>(-1, 1U);
+    expectRoundTrip<int64_t>(INT64_MIN, 10U);
+    expectRoundTrip<int64_t>(INT64_MAX, 10U);
+}
+
+TEST(CompactCodec, ZigzagMapsSmallMagnitudesToSmallCodes)
+{
+    CodecFixture fixture;
+    const int32_t values[] = { 0, -1, 1, -2, 2 };
+
+    for (int32_t value : values)
+    {
+        fixture.m_codec.write(value);
+    }
+    ASSERT_EQ(5U, fixture.used());
+    for (uint8_t i = 0; i < 5U; ++i)
+    {
+        EXPECT_EQ(i, fixture.m_storage[i]);
+    }
+}
+
+TEST(CompactCodec, ValueOutOfRangeOfTypeIsRejected)
+{
+    CodecFixture fixture;
+    uint16_t unsignedValue = 0;
+    int16_t signedValue = 0;
+
+    fixture.m_codec.write(static_cast<uint32_t>(UINT16_MAX) + 1U);
+    fixture.rewind();
+    fixture.m_codec.read(&unsignedValue);
+    EXPECT_EQ(kErpcStatus_InvalidArgument, fixture.m_codec.getStatus());
+
+    fixture.setBytes({});
+    fixture.m_codec.write(static_cast<int32_t>(INT16_MIN) - 1);
+    fixture.rewind();
+    fixture.m_codec.read(&signedValue);
+    EXPECT_EQ(kErpcStatus_InvalidArgument, fixture.m_codec.getStatus());
+}
+
+TEST(CompactCodec, TruncatedVarintIsRejected)
+{
+    uint8_t data[2] = { 0x80U, 0x80U };
+    MessageBuffer buffer(data, sizeof(data));
+    CompactCodec codec;
+    uint32_t value = 0;
+
+    buffer.setUsed(sizeof(data));
+    codec.setBuffer(buffer);
+    codec.read(&value);
+    EXPECT_EQ(kErpcStatus_BufferOverrun, codec.getStatus());
+}
+
+TEST(CompactCodec, OverlongVarintIsRejected)
+{
+    CodecFixture fixture;
+    uint64_t value = 0;
+
+    // Eleven bytes, longer than any 64-bit value.
+    fixture.setBytes({ 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x01U });
+    fixture.m_codec.read(&value);
+    EXPECT_EQ(kErpcStatus_InvalidArgument, fixture.m_codec.getStatus());
+
+    // Ten bytes whose last one carries bits above 64.
+    fixture.setBytes({ 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x02U });
+    fixture.m_codec.read(&value);
+    EXPECT_EQ(kErpcStatus_InvalidArgument, fixture.m_codec.getStatus());
+}
+
+TEST(CompactCodec, LengthsAreVarints)
+{
+    CodecFixture fixture;
+    static const char text[] = "compact";
+    uint32_t length = 0;
+    char *read = NULL;
+
+    fixture.m_codec.writeString(sizeof(text) - 1U, text);
+    EXPECT_EQ(1U + sizeof(text) - 1U, fixture.used());
+
+    fixture.rewind();
+    fixture.m_codec.readString(&length, &read);
+    ASSERT_TRUE(fixture.m_codec.isStatusOk());
+    EXPECT_EQ(sizeof(text) - 1U, length);
+    EXPECT_EQ(0, memcmp(text, read, length));
+}
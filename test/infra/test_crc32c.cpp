@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc32c.h"
+
+#include "gtest.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+const Crc32c::implementation_t s_implementations[] = { Crc32c::kImplementationTable, Crc32c::kImplementationSse42,
+                                                       Crc32c::kImplementationArm };
+
+const char *const s_names[] = { "table", "sse4.2", "arm" };
+
+/*!
+ * @brief CRC-32C of data with one implementation, start value and final inversion included.
+ */
+uint32_t crcWith(Crc32c::implementation_t implementation, const std::vector<uint8_t> &data)
+{
+    Crc32c crc;
+
+    return crc.finish(Crc32c::updateWith(implementation, crc.getStart(), data.data(), data.size()));
+}
+
+/*!
+ * @brief Run a check for every implementation this build and CPU have.
+ */
+template <typename Check>
+void forEachImplementation(Check check)
+{
+    for (size_t i = 0; i < (sizeof(s_implementations) / sizeof(s_implementations[0])); ++i)
+    {
+        if (!Crc32c::isAvailable(s_implementations[i]))
+        {
+            printf("[ SKIPPED  ] %s not available\n", s_names[i]);
+            continue;
+        }
+        SCOPED_TRACE(s_names[i]);
+        check(s_implementations[i]);
+    }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(Crc32c, KnownAnswers)
+{
+    // Check value of the CRC catalogue and the vectors of RFC 3720 B.4.
+    const char *text = "123456789";
+    std::vector<uint8_t> check(text, text + 9);
+    std::vector<uint8_t> zeros(32U, 0U);
+    std::vector<uint8_t> ones(32U, 0xFFU);
+    std::vector<uint8_t> ascending(32U);
+    std::vector<uint8_t> descending(32U);
+
+    for (uint8_t i = 0; i < 32U; ++i)
+    {
+        ascending[i] = i;
+        descending[i] = static_cast<uint8_t>(31U - i);
+    }
+
+    forEachImplementation([&](Crc32c::implementation_t implementation) {
+        EXPECT_EQ(0x00000000U, crcWith(implementation, std::vector<uint8_t>()));
+        EXPECT_EQ(0xE3069283U, crcWith(implementation, check));
+        EXPECT_EQ(0x8A9136AAU, crcWith(implementation, zeros));
+        EXPECT_EQ(0x62A8AB43U, crcWith(implementation, ones));
+        EXPECT_EQ(0x46DD794EU, crcWith(implementation, ascending));
+        EXPECT_EQ(0x113FDB5CU, crcWith(implementation, descending));
+    });
+}
+
+TEST(Crc32c, AllLengthsAndAlignmentsMatchTable)
+{
+    std::vector<uint8_t> data(300U);
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 131U + 7U);
+    }
+
+    forEachImplementation([&](Crc32c::implementation_t implementation) {
+        for (uint32_t offset = 0; offset < 8U; ++offset)
+        {
+            for (uint32_t length = 0; length <= 64U; ++length)
+            {
+                uint32_t expected =
+                    Crc32c::updateWith(Crc32c::kImplementationTable, 0xFFFFFFFFU, &data[offset], length);
+                ASSERT_EQ(expected, Crc32c::updateWith(implementation, 0xFFFFFFFFU, &data[offset], length))
+                    << "offset " << offset << " length " << length;
+            }
+        }
+    });
+}
+
+TEST(Crc32c, SplitUpdatesMatchOnePass)
+{
+    std::vector<uint8_t> data(257U);
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i ^ 0x5AU);
+    }
+
+    forEachImplementation([&](Crc32c::implementation_t implementation) {
+        uint32_t whole = Crc32c::updateWith(implementation, 0xFFFFFFFFU, data.data(), data.size());
+
+        for (uint32_t split = 0; split <= data.size(); split += 13U)
+        {
+            uint32_t value = Crc32c::updateWith(implementation, 0xFFFFFFFFU, data.data(), split);
+            value = Crc32c::updateWith(implementation, value, &data[split], data.size() - split);
+            ASSERT_EQ(whole, value) << "split " << split;
+        }
+    });
+}
+
+TEST(Crc32c, DefaultUpdateMatchesTable)
+{
+    Crc32c crc;
+    const char *text = "123456789";
+
+    EXPECT_EQ(0xE3069283U, crc.finish(crc.update(crc.getStart(), reinterpret_cast<const uint8_t *>(text), 9U)));
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc16.h"
+#include "erpc_framed_transport.h"
+
+#include "gtest.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Framed transport whose link takes a limited count of bytes per send, and receives
+ * whatever a test puts into m_received.
+ */
+class ThrottledTransport : public FramedTransport
+{
+public:
+    explicit ThrottledTransport(IntegrityCheck *check) { setIntegrityCheck(check); }
+
+    virtual void flush(void) override {}
+
+    std::vector<uint8_t> m_sent;
+    std::deque<uint8_t> m_received;
+    uint32_t m_budget = UINT32_MAX;
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &channel, const uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        uint32_t count = std::min(size, m_budget);
+
+        m_sent.insert(m_sent.end(), data, data + count);
+        m_budget -= count;
+        return count;
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &channel, uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        if (m_received.size() < size)
+        {
+            return kErpcStatus_Pending;
+        }
+        std::copy(m_received.begin(), m_received.begin() + size, data);
+        m_received.erase(m_received.begin(), m_received.begin() + size);
+        return kErpcStatus_Success;
+    }
+};
+
+//! @brief Channel hash of the given priority.
+Hash channelOf(uint32_t priority, uint32_t id)
+{
+    return (priority << kHashPriorityShift) | id;
+}
+
+/*!
+ * @brief Send a skip-CRC message and hand the frame to the receiver with its last byte flipped.
+ */
+void sendCorruptedSkipCrcFrame(ThrottledTransport &sender, ThrottledTransport &receiver)
+{
+    uint8_t data[16];
+    MessageBuffer message(data, sizeof(data));
+
+    for (uint8_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = i;
+    }
+    message.setUsed(sizeof(data));
+    message.setSkipCrc(true);
+
+    ASSERT_EQ(kErpcStatus_Success, sender.send(1U, &message));
+    receiver.m_received.assign(sender.m_sent.begin(), sender.m_sent.end());
+    receiver.m_received.back() ^= 0xFFU;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(FramedTransport, PriorityIsHeldUntilItsLastWaiterSends)
+{
+    Crc16 crc;
+    ThrottledTransport transport(&crc);
+    uint8_t data[32] = { 0 };
+    MessageBuffer message(data, sizeof(data));
+    Hash low = channelOf(1U, 1U);
+    Hash first = channelOf(5U, 2U);
+    Hash second = channelOf(5U, 3U);
+
+    message.setUsed(sizeof(data));
+
+    // Low priority frame is in flight, both high priority channels wait for its end.
+    transport.m_budget = 20U;
+    ASSERT_EQ(kErpcStatus_Pending, transport.send(low, &message));
+    EXPECT_EQ(kErpcStatus_Pending, transport.send(first, &message));
+    EXPECT_EQ(kErpcStatus_Pending, transport.send(second, &message));
+    transport.m_budget = UINT32_MAX;
+    ASSERT_EQ(kErpcStatus_Success, transport.send(low, &message));
+
+    // One channel of the level sent, the other one still holds the low priority back.
+    ASSERT_EQ(kErpcStatus_Success, transport.send(first, &message));
+    EXPECT_EQ(kErpcStatus_Pending, transport.send(low, &message));
+
+    // The level is released when its last waiter gives up.
+    transport.abandonSend(second);
+    EXPECT_EQ(kErpcStatus_Success, transport.send(low, &message));
+}
+
+TEST(FramedTransport, RepeatedPendingCountsOneWaiter)
+{
+    Crc16 crc;
+    ThrottledTransport transport(&crc);
+    uint8_t data[32] = { 0 };
+    MessageBuffer message(data, sizeof(data));
+    Hash low = channelOf(1U, 1U);
+    Hash high = channelOf(5U, 2U);
+
+    message.setUsed(sizeof(data));
+
+    transport.m_budget = 20U;
+    ASSERT_EQ(kErpcStatus_Pending, transport.send(low, &message));
+    EXPECT_EQ(kErpcStatus_Pending, transport.send(high, &message));
+    EXPECT_EQ(kErpcStatus_Pending, transport.send(high, &message));
+    transport.m_budget = UINT32_MAX;
+    ASSERT_EQ(kErpcStatus_Success, transport.send(low, &message));
+
+    // Polling while waiting does not leave the level held after the channel sent once.
+    ASSERT_EQ(kErpcStatus_Success, transport.send(high, &message));
+    EXPECT_EQ(kErpcStatus_Success, transport.send(low, &message));
+}
+
+#if ERPC_HEADER_VERSION != 1U
+TEST(FramedTransport, SkipCrcFrameIsNotChecked)
+{
+    Crc16 crc;
+    ThrottledTransport sender(&crc);
+    ThrottledTransport receiver(&crc);
+    uint8_t data[32];
+    MessageBuffer message(data, sizeof(data));
+
+    sendCorruptedSkipCrcFrame(sender, receiver);
+
+    // The packed header carries the flag, the receiver takes the frame unchecked and marks it.
+    ASSERT_EQ(kErpcStatus_Success, receiver.receive(1U, &message));
+    EXPECT_EQ(16U, message.getUsed());
+    EXPECT_TRUE(message.getSkipCrc());
+    EXPECT_EQ(static_cast<uint8_t>(15U ^ 0xFFU), data[15]);
+}
+#else
+TEST(FramedTransport, LegacyHeaderChecksSkipCrcFrame)
+{
+    Crc16 crc;
+    ThrottledTransport sender(&crc);
+    ThrottledTransport receiver(&crc);
+    uint8_t data[32];
+    MessageBuffer message(data, sizeof(data));
+
+    sendCorruptedSkipCrcFrame(sender, receiver);
+
+    // The legacy header has no room for the flag, the CRC is sent and checked anyway.
+    EXPECT_EQ(kErpcStatus_CrcCheckFailed, receiver.receive(1U, &message));
+}
+#endif
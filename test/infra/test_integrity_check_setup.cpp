@@ -0,0 +1,146 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_crc16.h"
+#include "erpc_framed_transport.h"
+#include "erpc_transport.h"
+#include "erpc_transport_setup.h"
+
+#include "gtest.h"
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Transport remembering the integrity check it was given.
+ */
+class CheckRecordingTransport : public Transport
+{
+public:
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override
+    {
+        (void)channel;
+        (void)message;
+        return kErpcStatus_Success;
+    }
+
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override
+    {
+        (void)channel;
+        (void)message;
+        return kErpcStatus_Success;
+    }
+
+    virtual erpc_status_t setIntegrityCheck(IntegrityCheck *check) override
+    {
+        m_check = check;
+        return kErpcStatus_Success;
+    }
+
+    virtual void flush(void) override {}
+
+    IntegrityCheck *m_check = NULL;
+};
+
+/*!
+ * @brief Framed transport which never sends or receives, for checking what it accepts.
+ */
+class IdleFramedTransport : public FramedTransport
+{
+public:
+    virtual void flush(void) override {}
+
+    IntegrityCheck *getCheck(void) const { return m_crcImpl; }
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &channel, const uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        (void)data;
+        return size;
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &channel, uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        (void)data;
+        (void)size;
+        return kErpcStatus_Pending;
+    }
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(IntegrityCheckSetup, Crc16KeepsTransportCrcStart)
+{
+    CheckRecordingTransport transport;
+    Crc16 custom(0x1234U);
+    erpc_transport_t handle = reinterpret_cast<erpc_transport_t>(&transport);
+
+    transport.setCrc16(&custom);
+
+    erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckCrc32c);
+    ASSERT_NE(nullptr, transport.m_check);
+    EXPECT_EQ(IntegrityCheck::kIntegrityCrc32c, transport.m_check->getId());
+
+    erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckCrc16);
+    EXPECT_EQ(&custom, transport.m_check);
+    EXPECT_EQ(0x1234U, transport.m_check->getStart());
+}
+
+TEST(IntegrityCheckSetup, Crc16WithoutTransportCrcUsesDefault)
+{
+    CheckRecordingTransport transport;
+    erpc_transport_t handle = reinterpret_cast<erpc_transport_t>(&transport);
+
+    erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckCrc16);
+    ASSERT_NE(nullptr, transport.m_check);
+    EXPECT_EQ(IntegrityCheck::kIntegrityCrc16, transport.m_check->getId());
+}
+
+TEST(IntegrityCheckSetup, FrameHeaderDecidesOnCrc32c)
+{
+    IdleFramedTransport transport;
+    Crc16 crc16;
+    erpc_transport_t handle = reinterpret_cast<erpc_transport_t>(&transport);
+
+    transport.setCrc16(&crc16);
+
+#if ERPC_HEADER_VERSION == 1U
+    // The legacy header would truncate the value and cannot tell the peer about the check.
+    EXPECT_EQ(kErpcStatus_InvalidArgument, erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckCrc32c));
+    EXPECT_EQ(&crc16, transport.getCheck());
+#else
+    EXPECT_EQ(kErpcStatus_Success, erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckCrc32c));
+    EXPECT_EQ(IntegrityCheck::kIntegrityCrc32c, transport.getCheck()->getId());
+#endif
+
+    EXPECT_EQ(kErpcStatus_Success, erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckNone));
+    EXPECT_EQ(IntegrityCheck::kIntegrityNone, transport.getCheck()->getId());
+}
+
+#if (ERPC_HEADER_VERSION == 1U) && ERPC_COBS_FRAMING
+TEST(IntegrityCheckSetup, CobsFramingTakesCrc32cWithLegacyHeader)
+{
+    IdleFramedTransport transport;
+    erpc_transport_t handle = reinterpret_cast<erpc_transport_t>(&transport);
+
+    transport.setFraming(FramedTransport::kFramingCobs);
+    EXPECT_EQ(kErpcStatus_Success, erpc_transport_set_integrity_check(handle, kErpcIntegrityCheckCrc32c));
+    EXPECT_EQ(IntegrityCheck::kIntegrityCrc32c, transport.getCheck()->getId());
+}
+#endif
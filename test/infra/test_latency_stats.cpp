@@ -0,0 +1,198 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_latency_stats.h"
+
+#include "gtest.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#if !ERPC_LATENCY_STATS
+#error "Latency stats tests need ERPC_LATENCY_STATS enabled."
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+//! @brief Methods of these tests, apart from the ones other tests record.
+const Hash kFirstMethod = 0x4C000000U;
+
+/*!
+ * @brief Return a histogram with every bucket empty.
+ */
+std::unique_ptr<LatencyHistogram> emptyHistogram(void)
+{
+    // No constructor, value-initialization zeroes the counters.
+    return std::unique_ptr<LatencyHistogram>(new LatencyHistogram());
+}
+
+/*!
+ * @brief Take a snapshot of every method and phase.
+ */
+std::vector<erpc_latency_entry_t> snapshot(bool reset)
+{
+    std::vector<erpc_latency_entry_t> entries(ERPC_LATENCY_STATS_METHODS * kErpcLatencyPhaseCount);
+
+    entries.resize(erpc_latency_stats_snapshot(entries.data(), static_cast<uint32_t>(entries.size()), reset));
+    return entries;
+}
+
+/*!
+ * @brief Find the entry of a method and phase, NULL when it has no calls.
+ */
+const erpc_latency_entry_t *findEntry(const std::vector<erpc_latency_entry_t> &entries, Hash method, uint32_t phase)
+{
+    for (const erpc_latency_entry_t &entry : entries)
+    {
+        if ((entry.method == method) && (entry.phase == phase))
+        {
+            return &entry;
+        }
+    }
+    return NULL;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(LatencyStats, BucketBoundaries)
+{
+    // Below 8 every latency has its own bucket.
+    EXPECT_EQ(0U, LatencyHistogram::bucketOf(0U));
+    EXPECT_EQ(7U, LatencyHistogram::bucketOf(7U));
+    EXPECT_EQ(0U, LatencyHistogram::lowerBoundOf(0U));
+    EXPECT_EQ(7U, LatencyHistogram::lowerBoundOf(7U));
+
+    // From 8 on, each power of two is split into 8 buckets.
+    EXPECT_EQ(8U, LatencyHistogram::bucketOf(8U));
+    EXPECT_EQ(15U, LatencyHistogram::bucketOf(15U));
+    EXPECT_EQ(16U, LatencyHistogram::bucketOf(16U));
+    EXPECT_EQ(16U, LatencyHistogram::bucketOf(17U));
+    EXPECT_EQ(8U, LatencyHistogram::lowerBoundOf(8U));
+    EXPECT_EQ(15U, LatencyHistogram::lowerBoundOf(15U));
+    EXPECT_EQ(16U, LatencyHistogram::lowerBoundOf(16U));
+    EXPECT_EQ(18U, LatencyHistogram::lowerBoundOf(17U));
+
+    // The largest latency takes the last bucket.
+    EXPECT_EQ(LatencyHistogram::kBucketCount - 1U, LatencyHistogram::bucketOf(UINT32_MAX));
+    EXPECT_EQ(0xF0000000U, LatencyHistogram::lowerBoundOf(LatencyHistogram::kBucketCount - 1U));
+}
+
+TEST(LatencyStats, EveryLatencyFallsBetweenItsBucketBounds)
+{
+    const uint32_t samples[] = { 0U, 1U, 7U, 8U, 9U, 15U, 16U, 31U, 32U, 1000U, 123456789U, 0x80000000U, UINT32_MAX };
+
+    for (uint32_t ns : samples)
+    {
+        uint32_t bucket = LatencyHistogram::bucketOf(ns);
+
+        EXPECT_LE(LatencyHistogram::lowerBoundOf(bucket), ns) << ns;
+        if (bucket + 1U < LatencyHistogram::kBucketCount)
+        {
+            EXPECT_LT(ns, LatencyHistogram::lowerBoundOf(bucket + 1U)) << ns;
+        }
+    }
+}
+
+TEST(LatencyStats, PercentilesOfKnownSamples)
+{
+    std::unique_ptr<LatencyHistogram> histogram = emptyHistogram();
+    erpc_latency_entry_t entry = {};
+
+    for (uint32_t ns = 1U; ns <= 100U; ++ns)
+    {
+        histogram->record(ns);
+    }
+
+    ASSERT_EQ(100U, histogram->read(&entry, false));
+    EXPECT_EQ(100U, entry.count);
+    EXPECT_EQ(1U, entry.minNs);
+    EXPECT_EQ(100U, entry.maxNs);
+    // Upper bounds of the buckets 48..51, 88..95 and 96..103, the last one capped at the maximum.
+    EXPECT_EQ(51U, entry.p50Ns);
+    EXPECT_EQ(95U, entry.p90Ns);
+    EXPECT_EQ(100U, entry.p99Ns);
+    EXPECT_EQ(100U, entry.p999Ns);
+}
+
+TEST(LatencyStats, ReadWithResetClearsHistogram)
+{
+    std::unique_ptr<LatencyHistogram> histogram = emptyHistogram();
+    erpc_latency_entry_t entry = {};
+
+    histogram->record(500U);
+    ASSERT_EQ(1U, histogram->read(&entry, true));
+    EXPECT_EQ(500U, entry.maxNs);
+
+    EXPECT_EQ(0U, histogram->read(&entry, false));
+    EXPECT_EQ(0U, entry.maxNs);
+}
+
+TEST(LatencyStats, ResetDropsRecordedCalls)
+{
+    LatencyStats::record(kFirstMethod, kErpcLatencyClientWait, 1000U);
+    ASSERT_TRUE(findEntry(snapshot(false), kFirstMethod, kErpcLatencyClientWait) != NULL);
+
+    erpc_latency_stats_reset();
+    EXPECT_TRUE(findEntry(snapshot(false), kFirstMethod, kErpcLatencyClientWait) == NULL);
+
+    // The method keeps its slot and records again.
+    LatencyStats::record(kFirstMethod, kErpcLatencyClientWait, 2000U);
+    const erpc_latency_entry_t *entry = findEntry(snapshot(true), kFirstMethod, kErpcLatencyClientWait);
+    ASSERT_TRUE(entry != NULL);
+    EXPECT_EQ(1U, entry->count);
+    EXPECT_EQ(2000U, entry->maxNs);
+}
+
+TEST(LatencyStats, FullMethodTableDropsFurtherMethods)
+{
+    std::set<Hash> recorded;
+
+    erpc_latency_stats_reset();
+
+    // More methods than slots, other tests may hold some of the slots already.
+    for (uint32_t i = 0; i < ERPC_LATENCY_STATS_METHODS + 2U; ++i)
+    {
+        LatencyStats::record(kFirstMethod + 1U + i, kErpcLatencyServerHandler, 100U + i);
+    }
+
+    for (const erpc_latency_entry_t &entry : snapshot(false))
+    {
+        EXPECT_EQ(static_cast<uint32_t>(kErpcLatencyServerHandler), entry.phase);
+        EXPECT_EQ(1U, entry.count);
+        recorded.insert(entry.method);
+    }
+    EXPECT_GE(recorded.size(), 1U);
+    EXPECT_LE(recorded.size(), ERPC_LATENCY_STATS_METHODS);
+
+    // The method recorded last found no slot anymore.
+    EXPECT_EQ(0U, recorded.count(kFirstMethod + ERPC_LATENCY_STATS_METHODS + 2U));
+
+    // A snapshot stops at the capacity it was given.
+    erpc_latency_entry_t entry;
+    EXPECT_EQ(1U, erpc_latency_stats_snapshot(&entry, 1U, false));
+
+    erpc_latency_stats_reset();
+}
+
+TEST(LatencyStats, PhaseNames)
+{
+    EXPECT_STREQ("client_create", erpc_latency_phase_name(kErpcLatencyClientCreate));
+    EXPECT_STREQ("server_reply", erpc_latency_phase_name(kErpcLatencyServerReply));
+    EXPECT_STREQ("unknown", erpc_latency_phase_name(kErpcLatencyPhaseCount));
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_compact_codec.h"
+#include "erpc_oneway_batching_transport.h"
+
+#include "gtest.h"
+
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Transport recording frames it was given.
+ */
+class RecordingTransport : public Transport
+{
+public:
+    struct Frame
+    {
+        Hash channel;
+        std::vector<uint8_t> data;
+    };
+
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override
+    {
+        (void)channel;
+        message->setUsed(0);
+        return kErpcStatus_Success;
+    }
+
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override
+    {
+        Frame frame;
+        frame.channel = channel;
+        frame.data.assign(message->get(), message->get() + message->getUsed());
+        m_frames.push_back(frame);
+        return kErpcStatus_Success;
+    }
+
+    virtual void flush(void) override {}
+
+    std::vector<Frame> m_frames;
+};
+
+/*!
+ * @brief Encode a message of the given type with a single byte payload and send it.
+ */
+erpc_status_t sendMessage(Transport &transport, Codec &codec, Hash channel, message_type_t type, uint8_t payload)
+{
+    uint8_t data[32];
+    MessageBuffer message(data, sizeof(data));
+
+    codec.setBuffer(message);
+    codec.startWriteMessage(type, 1U, 2U, 3U);
+    codec.write(payload);
+    return transport.send(channel, codec.getBuffer());
+}
+
+/*!
+ * @brief Decode the message type and payload byte of a message.
+ */
+void decodeMessage(const std::vector<uint8_t> &data, message_type_t *type, uint8_t *payload)
+{
+    BasicCodec codec;
+    MessageBuffer message(const_cast<uint8_t *>(data.data()), static_cast<uint16_t>(data.size()));
+    uint32_t service;
+    Hash request;
+    uint32_t sequence;
+
+    message.setUsed(static_cast<uint16_t>(data.size()));
+    codec.setBuffer(message);
+    codec.startReadMessage(type, &service, &request, &sequence);
+    codec.read(payload);
+    ASSERT_TRUE(codec.isStatusOk());
+}
+
+/*!
+ * @brief Decode a batch frame into the payload bytes of its sub-messages.
+ */
+std::vector<uint8_t> decodeBatch(const std::vector<uint8_t> &data)
+{
+    BasicCodec codec;
+    MessageBuffer message(const_cast<uint8_t *>(data.data()), static_cast<uint16_t>(data.size()));
+    message_type_t type;
+    uint32_t service;
+    Hash request;
+    uint32_t sequence;
+    uint16_t count = 0;
+    std::vector<uint8_t> payloads;
+
+    message.setUsed(static_cast<uint16_t>(data.size()));
+    codec.setBuffer(message);
+    codec.startReadMessage(&type, &service, &request, &sequence);
+    codec.read(&count);
+    EXPECT_EQ(kOnewayBatchMessage, type);
+
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        uint32_t length = 0;
+        uint8_t *subData = NULL;
+        message_type_t subType;
+        uint8_t payload = 0;
+
+        codec.readBinary(&length, &subData);
+        if (!codec.isStatusOk())
+        {
+            break;
+        }
+        decodeMessage(std::vector<uint8_t>(subData, subData + length), &subType, &payload);
+        EXPECT_EQ(kOnewayMessage, subType);
+        payloads.push_back(payload);
+    }
+    EXPECT_TRUE(codec.isStatusOk());
+
+    return payloads;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(OnewayBatchingTransport, OnewaysAreBatched)
+{
+    RecordingTransport wrapped;
+    OnewayBatchingTransport batching(&wrapped);
+    BasicCodec codec;
+
+    for (uint8_t i = 0; i < 3U; ++i)
+    {
+        EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kOnewayMessage, i));
+    }
+    EXPECT_TRUE(wrapped.m_frames.empty());
+
+    batching.flush();
+    ASSERT_EQ(1U, wrapped.m_frames.size());
+    EXPECT_EQ(1U, wrapped.m_frames[0].channel);
+    EXPECT_EQ(std::vector<uint8_t>({ 0, 1, 2 }), decodeBatch(wrapped.m_frames[0].data));
+}
+
+TEST(OnewayBatchingTransport, SingleOnewayIsSentPlain)
+{
+    RecordingTransport wrapped;
+    OnewayBatchingTransport batching(&wrapped);
+    BasicCodec codec;
+    message_type_t type;
+    uint8_t payload = 0;
+
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kOnewayMessage, 5U));
+    batching.flush();
+
+    ASSERT_EQ(1U, wrapped.m_frames.size());
+    decodeMessage(wrapped.m_frames[0].data, &type, &payload);
+    EXPECT_EQ(kOnewayMessage, type);
+    EXPECT_EQ(5U, payload);
+}
+
+TEST(OnewayBatchingTransport, BatchHoldsOneChannel)
+{
+    RecordingTransport wrapped;
+    OnewayBatchingTransport batching(&wrapped);
+    BasicCodec codec;
+
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kOnewayMessage, 0));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kOnewayMessage, 1U));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 2U, kOnewayMessage, 2U));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 2U, kOnewayMessage, 3U));
+    batching.flush();
+
+    ASSERT_EQ(2U, wrapped.m_frames.size());
+    EXPECT_EQ(1U, wrapped.m_frames[0].channel);
+    EXPECT_EQ(std::vector<uint8_t>({ 0, 1 }), decodeBatch(wrapped.m_frames[0].data));
+    EXPECT_EQ(2U, wrapped.m_frames[1].channel);
+    EXPECT_EQ(std::vector<uint8_t>({ 2, 3 }), decodeBatch(wrapped.m_frames[1].data));
+}
+
+TEST(OnewayBatchingTransport, InvocationFlushesBatchFirst)
+{
+    RecordingTransport wrapped;
+    OnewayBatchingTransport batching(&wrapped);
+    BasicCodec codec;
+    message_type_t type;
+    uint8_t payload = 0;
+
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kOnewayMessage, 0));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kOnewayMessage, 1U));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, codec, 1U, kInvocationMessage, 2U));
+
+    ASSERT_EQ(2U, wrapped.m_frames.size());
+    EXPECT_EQ(std::vector<uint8_t>({ 0, 1 }), decodeBatch(wrapped.m_frames[0].data));
+    decodeMessage(wrapped.m_frames[1].data, &type, &payload);
+    EXPECT_EQ(kInvocationMessage, type);
+    EXPECT_EQ(2U, payload);
+}
+
+TEST(OnewayBatchingTransport, CompactMessagesAreSentUnbatched)
+{
+    RecordingTransport wrapped;
+    OnewayBatchingTransport batching(&wrapped);
+    BasicCodec basic;
+    CompactCodec compact;
+
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, basic, 1U, kOnewayMessage, 0));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, compact, 1U, kOnewayMessage, 1U));
+    EXPECT_EQ(kErpcStatus_Success, sendMessage(batching, compact, 1U, kOnewayMessage, 2U));
+
+    // The queued BasicCodec message goes out first, the compact ones as they are.
+    ASSERT_EQ(3U, wrapped.m_frames.size());
+    EXPECT_NE(CompactCodec::kCompactCodecVersion, wrapped.m_frames[0].data[0]);
+    EXPECT_EQ(CompactCodec::kCompactCodecVersion, wrapped.m_frames[1].data[0]);
+    EXPECT_EQ(CompactCodec::kCompactCodecVersion, wrapped.m_frames[2].data[0]);
+}
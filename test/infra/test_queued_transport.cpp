@@ -0,0 +1,239 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_queued_transport.h"
+
+#include "gtest.h"
+
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+ * @brief Transport recording frames it was given, it can fail or defer them on request.
+ */
+class RecordingTransport : public Transport
+{
+public:
+    struct Frame
+    {
+        Hash channel;
+        std::vector<uint8_t> data;
+    };
+
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override
+    {
+        (void)channel;
+        message->setUsed(0);
+        ++m_receives;
+        return kErpcStatus_Success;
+    }
+
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        if (m_pendingCount > 0U)
+        {
+            --m_pendingCount;
+            return kErpcStatus_Pending;
+        }
+        if (channel == m_failChannel)
+        {
+            return kErpcStatus_SendFailed;
+        }
+
+        Frame frame;
+        frame.channel = channel;
+        frame.data.assign(message->get(), message->get() + message->getUsed());
+        m_frames.push_back(frame);
+        return kErpcStatus_Success;
+    }
+
+    virtual void flush(void) override {}
+
+    std::mutex m_lock;
+    std::vector<Frame> m_frames;
+    uint32_t m_pendingCount = 0;
+    Hash m_failChannel = 0xFFFFFFFFU;
+    uint32_t m_receives = 0;
+};
+
+/*!
+ * @brief Send a small frame with the given payload bytes.
+ */
+erpc_status_t sendBytes(Transport &transport, Hash channel, uint8_t first, uint8_t second)
+{
+    uint8_t data[2] = { first, second };
+    MessageBuffer message(data, sizeof(data));
+    message.setUsed(sizeof(data));
+    return transport.send(channel, &message);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(QueuedTransport, FramesAreWrittenInOrder)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+
+    for (uint8_t i = 0; i < 20U; ++i)
+    {
+        EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 1U, i, 0));
+    }
+
+    ASSERT_EQ(20U, wrapped.m_frames.size());
+    for (uint8_t i = 0; i < 20U; ++i)
+    {
+        EXPECT_EQ(i, wrapped.m_frames[i].data[0]);
+    }
+}
+
+TEST(QueuedTransport, PendingFrameIsResumedByNextCall)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+
+    wrapped.m_pendingCount = 1U;
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 1U, 1U, 0));
+    EXPECT_TRUE(wrapped.m_frames.empty());
+
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 2U, 2U, 0));
+    ASSERT_EQ(2U, wrapped.m_frames.size());
+    EXPECT_EQ(1U, wrapped.m_frames[0].data[0]);
+    EXPECT_EQ(2U, wrapped.m_frames[1].data[0]);
+}
+
+TEST(QueuedTransport, ErrorOfOwnFrameIsReportedToSender)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+
+    wrapped.m_failChannel = 7U;
+    EXPECT_EQ(kErpcStatus_SendFailed, sendBytes(queued, 7U, 1U, 0));
+    EXPECT_EQ(1U, queued.getFailedFrames());
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 3U, 2U, 0));
+}
+
+TEST(QueuedTransport, ErrorIsReportedToChannelOfLostFrame)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+    uint8_t data[8];
+    MessageBuffer reply(data, sizeof(data));
+
+    // The frame stays queued and its sender returns.
+    wrapped.m_pendingCount = 1U;
+    wrapped.m_failChannel = 7U;
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 7U, 1U, 0));
+
+    // The next sender writes it out, the error is not reported to this unrelated call.
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 3U, 2U, 0));
+    EXPECT_EQ(1U, queued.getFailedFrames());
+    EXPECT_EQ(kErpcStatus_Success, queued.receive(3U, &reply));
+
+    // The client waiting for the reply of the lost request gets it, once.
+    EXPECT_EQ(kErpcStatus_SendFailed, queued.receive(7U, &reply));
+    EXPECT_EQ(1U, wrapped.m_receives);
+    EXPECT_EQ(kErpcStatus_Success, queued.receive(7U, &reply));
+}
+
+TEST(QueuedTransport, ErrorIsReportedToNextSendOfChannel)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+
+    wrapped.m_pendingCount = 1U;
+    wrapped.m_failChannel = 7U;
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 7U, 1U, 0));
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 3U, 2U, 0));
+
+    wrapped.m_failChannel = 0xFFFFFFFFU;
+    EXPECT_EQ(kErpcStatus_SendFailed, sendBytes(queued, 7U, 3U, 0));
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 7U, 4U, 0));
+    EXPECT_EQ(3U, wrapped.m_frames.size());
+}
+
+TEST(QueuedTransport, AbandonDropsKeptError)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+    uint8_t data[8];
+    MessageBuffer reply(data, sizeof(data));
+
+    wrapped.m_pendingCount = 1U;
+    wrapped.m_failChannel = 7U;
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 7U, 1U, 0));
+    EXPECT_EQ(kErpcStatus_Success, sendBytes(queued, 3U, 2U, 0));
+
+    queued.abandonSend(7U);
+    EXPECT_EQ(kErpcStatus_Success, queued.receive(7U, &reply));
+}
+
+TEST(QueuedTransport, FrameLargerThanSlotIsRejected)
+{
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+    std::vector<uint8_t> data(ERPC_DEFAULT_BUFFER_SIZE + 1U);
+    MessageBuffer message(data.data(), static_cast<uint16_t>(data.size()));
+
+    message.setUsed(static_cast<uint16_t>(data.size()));
+    EXPECT_EQ(kErpcStatus_BufferOverrun, queued.send(1U, &message));
+    EXPECT_TRUE(wrapped.m_frames.empty());
+}
+
+TEST(QueuedTransport, ConcurrentProducersLoseNoFrame)
+{
+    static const uint8_t kThreads = 4U;
+    static const uint32_t kFramesPerThread = 5000U;
+    RecordingTransport wrapped;
+    QueuedTransport queued(&wrapped);
+    std::vector<std::thread> threads;
+
+    for (uint8_t t = 0; t < kThreads; ++t)
+    {
+        threads.push_back(std::thread([&queued, t]() {
+            for (uint32_t i = 0; i < kFramesPerThread; ++i)
+            {
+                while (sendBytes(queued, t + 1U, t, static_cast<uint8_t>(i)) == kErpcStatus_Pending)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    queued.flush();
+
+    // Every frame arrives once, and the frames of one producer keep their order.
+    ASSERT_EQ(kThreads * kFramesPerThread, wrapped.m_frames.size());
+    uint32_t next[kThreads] = {};
+    for (const RecordingTransport::Frame &frame : wrapped.m_frames)
+    {
+        uint8_t t = frame.data[0];
+        ASSERT_LT(t, kThreads);
+        EXPECT_EQ(static_cast<uint8_t>(next[t]), frame.data[1]);
+        ++next[t];
+    }
+}
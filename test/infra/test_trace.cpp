@@ -0,0 +1,119 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_trace.h"
+
+#include "gtest.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#if !ERPC_TRACE
+#error "Trace tests need ERPC_TRACE enabled."
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+void appendToString(const char *data, uint32_t length, void *context)
+{
+    static_cast<std::string *>(context)->append(data, length);
+}
+
+/*!
+ * @brief Check that every dumped event has the channel equal to its sequence, in recorded order.
+ *
+ * @return Count of checked events.
+ */
+uint32_t expectWholeEvents(const std::string &json)
+{
+    static const char kArgs[] = "\"args\":{\"channel\":";
+    uint32_t count = 0;
+    unsigned previous = 0;
+
+    for (size_t pos = json.find(kArgs); pos != std::string::npos; pos = json.find(kArgs, pos + 1U))
+    {
+        unsigned channel = 0;
+        unsigned sequence = 0;
+
+        EXPECT_EQ(2, sscanf(&json[pos + sizeof(kArgs) - 1U], "%u,\"sequence\":%u", &channel, &sequence));
+        EXPECT_EQ(channel, sequence) << "torn event";
+        if (count != 0U)
+        {
+            EXPECT_GT(sequence, previous);
+        }
+        previous = sequence;
+        ++count;
+    }
+
+    return count;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(Trace, DumpWhileRecordingHasNoTornEvents)
+{
+    std::atomic<bool> started(false);
+    std::atomic<bool> stop(false);
+
+    erpc_trace_clear();
+    std::thread recorder([&started, &stop]() {
+        // Both fields of each event carry the same counter, a torn copy mixes two events.
+        for (uint32_t i = 1U; !stop.load(std::memory_order_relaxed); ++i)
+        {
+            erpc_trace_record(kErpcTraceTransportSend, i, i);
+            started.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    while (!started.load(std::memory_order_relaxed))
+    {
+        std::this_thread::yield();
+    }
+
+    uint32_t events = 0;
+    for (uint32_t i = 0; i < 200U; ++i)
+    {
+        std::string json;
+        uint32_t written = erpc_trace_dump(appendToString, &json);
+
+        ASSERT_EQ(written, expectWholeEvents(json));
+        events += written;
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    recorder.join();
+    printf("[ INFO     ] %u events dumped, lapped ones were left out\n", events);
+}
+
+TEST(Trace, DumpOfIdleThreadKeepsAllEvents)
+{
+    std::string json;
+
+    erpc_trace_clear();
+    std::thread recorder([]() {
+        for (uint32_t i = 1U; i <= 10U; ++i)
+        {
+            erpc_trace_record(kErpcTraceTransportReceive, i, i);
+        }
+    });
+    recorder.join();
+
+    EXPECT_EQ(10U, erpc_trace_dump(appendToString, &json));
+    EXPECT_EQ(10U, expectWholeEvents(json));
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "test_transport_stats.h"
+
+#include "erpc_crc16.h"
+#include "erpc_framed_transport.h"
+#include "erpc_transport_setup.h"
+
+#include "gtest.h"
+
+#include <algorithm>
+#include <deque>
+
+#if !ERPC_TRANSPORT_STATS || !defined(ERPC_TRANSPORT_STATS_CLOCK)
+#error "Transport stats tests need ERPC_TRANSPORT_STATS enabled with the test clock."
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+//! @brief Time returned by erpc_test_transport_clock().
+uint32_t s_clockUs = 0U;
+
+/*!
+ * @brief Framed transport receiving what it sent, its link takes a limited count of bytes per send.
+ */
+class LoopbackTransport : public FramedTransport
+{
+public:
+    explicit LoopbackTransport(IntegrityCheck *check) { setIntegrityCheck(check); }
+
+    virtual void flush(void) override {}
+
+    std::deque<uint8_t> m_link;
+    uint32_t m_budget = UINT32_MAX;
+
+protected:
+    virtual uint32_t underlyingSend(const Hash &channel, const uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        uint32_t count = std::min(size, m_budget);
+
+        m_link.insert(m_link.end(), data, data + count);
+        m_budget -= count;
+        return count;
+    }
+
+    virtual erpc_status_t underlyingReceive(const Hash &channel, uint8_t *data, uint32_t size) override
+    {
+        (void)channel;
+        if (m_link.size() < size)
+        {
+            return kErpcStatus_Pending;
+        }
+        std::copy(m_link.begin(), m_link.begin() + size, data);
+        m_link.erase(m_link.begin(), m_link.begin() + size);
+        return kErpcStatus_Success;
+    }
+};
+
+/*!
+ * @brief Send a message of the given size, filled with its offsets.
+ */
+erpc_status_t sendMessage(LoopbackTransport &transport, Hash channel, uint32_t size)
+{
+    uint8_t data[64];
+    MessageBuffer message(data, sizeof(data));
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    message.setUsed(size);
+    return transport.send(channel, &message);
+}
+
+/*!
+ * @brief Receive a message into a buffer of the given length.
+ */
+erpc_status_t receiveMessage(LoopbackTransport &transport, Hash channel, uint32_t length)
+{
+    uint8_t data[64];
+    MessageBuffer message(data, length);
+
+    return transport.receive(channel, &message);
+}
+
+//! @brief Read counters by the C API.
+erpc_transport_stats_t readStats(LoopbackTransport &transport, uint32_t channel)
+{
+    erpc_transport_stats_t stats = {};
+
+    EXPECT_TRUE(erpc_transport_get_stats(reinterpret_cast<erpc_transport_t>(&transport), channel, &stats));
+    return stats;
+}
+
+} // namespace
+
+extern "C" uint32_t erpc_test_transport_clock(void)
+{
+    return s_clockUs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(TransportStats, LoopbackCountsEveryOutcome)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    erpc_transport_t handle = reinterpret_cast<erpc_transport_t>(&transport);
+    const Hash a = 1U;
+    const Hash b = 2U;
+
+    // Success both ways.
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, a, 16U));
+    ASSERT_EQ(kErpcStatus_Success, receiveMessage(transport, a, 64U));
+
+    // Nothing on the link yet, then a send the link takes the header and only part of the message of.
+    EXPECT_EQ(kErpcStatus_Pending, receiveMessage(transport, b, 64U));
+    transport.m_budget = 12U;
+    EXPECT_EQ(kErpcStatus_Pending, sendMessage(transport, b, 24U));
+    transport.m_budget = UINT32_MAX;
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, b, 24U));
+    ASSERT_EQ(kErpcStatus_Success, receiveMessage(transport, b, 64U));
+
+    // Frame damaged on the link.
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, a, 8U));
+    transport.m_link.back() ^= 0xFFU;
+    EXPECT_EQ(kErpcStatus_CrcCheckFailed, receiveMessage(transport, a, 64U));
+
+    // Frame larger than the receive buffer.
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, a, 32U));
+    EXPECT_EQ(kErpcStatus_ReceiveFailed, receiveMessage(transport, a, 16U));
+    transport.m_link.clear();
+
+    erpc_transport_stats_t totals = readStats(transport, 0U);
+    EXPECT_EQ(0U, totals.channel);
+    EXPECT_EQ(16U + 24U + 8U + 32U, totals.bytesSent);
+    EXPECT_EQ(4U, totals.framesSent);
+    EXPECT_EQ(16U + 24U, totals.bytesReceived);
+    EXPECT_EQ(2U, totals.framesReceived);
+    EXPECT_EQ(1U, totals.sendPending);
+    EXPECT_EQ(1U, totals.receivePending);
+    EXPECT_EQ(0U, totals.sendErrors);
+    EXPECT_EQ(1U, totals.receiveErrors);
+    EXPECT_EQ(1U, totals.crcErrors);
+
+    erpc_transport_stats_t first = readStats(transport, a);
+    EXPECT_EQ(a, first.channel);
+    EXPECT_EQ(16U + 8U + 32U, first.bytesSent);
+    EXPECT_EQ(3U, first.framesSent);
+    EXPECT_EQ(16U, first.bytesReceived);
+    EXPECT_EQ(1U, first.framesReceived);
+    EXPECT_EQ(0U, first.sendPending);
+    EXPECT_EQ(0U, first.receivePending);
+    EXPECT_EQ(1U, first.receiveErrors);
+    EXPECT_EQ(1U, first.crcErrors);
+
+    erpc_transport_stats_t second = readStats(transport, b);
+    EXPECT_EQ(b, second.channel);
+    EXPECT_EQ(24U, second.bytesSent);
+    EXPECT_EQ(1U, second.framesSent);
+    EXPECT_EQ(24U, second.bytesReceived);
+    EXPECT_EQ(1U, second.framesReceived);
+    EXPECT_EQ(1U, second.sendPending);
+    EXPECT_EQ(1U, second.receivePending);
+    EXPECT_EQ(0U, second.receiveErrors);
+    EXPECT_EQ(0U, second.crcErrors);
+
+    // Channels never used have no counters, the used ones are listed.
+    erpc_transport_stats_t unused;
+    EXPECT_FALSE(erpc_transport_get_stats(handle, 3U, &unused));
+    erpc_transport_stats_t channels[4];
+    EXPECT_EQ(2U, erpc_transport_get_channel_stats(handle, channels, 4U));
+    EXPECT_EQ(1U, erpc_transport_get_channel_stats(handle, channels, 1U));
+
+    // Reset clears the counters, channels keep their slots.
+    erpc_transport_reset_stats(handle);
+    totals = readStats(transport, 0U);
+    EXPECT_EQ(0U, totals.bytesSent);
+    EXPECT_EQ(0U, totals.framesReceived);
+    EXPECT_EQ(0U, totals.crcErrors);
+    second = readStats(transport, b);
+    EXPECT_EQ(0U, second.sendPending);
+}
+
+TEST(TransportStats, BlockedTimeRunsFromFirstPendingSend)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    const Hash channel = 1U;
+
+    // Sends which are never pending are not blocked.
+    s_clockUs = 100U;
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, channel, 16U));
+    EXPECT_EQ(0U, readStats(transport, channel).sendBlockedUs);
+
+    // Repeated pending sends do not restart the time.
+    transport.m_budget = 0U;
+    EXPECT_EQ(kErpcStatus_Pending, sendMessage(transport, channel, 16U));
+    s_clockUs = 200U;
+    EXPECT_EQ(kErpcStatus_Pending, sendMessage(transport, channel, 16U));
+    s_clockUs = 350U;
+    transport.m_budget = UINT32_MAX;
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, channel, 16U));
+    EXPECT_EQ(250U, readStats(transport, channel).sendBlockedUs);
+    EXPECT_EQ(250U, readStats(transport, 0U).sendBlockedUs);
+
+    // The send ended the blocked time.
+    s_clockUs = 1000U;
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, channel, 16U));
+    EXPECT_EQ(250U, readStats(transport, channel).sendBlockedUs);
+}
+
+TEST(TransportStats, ClockReadingZeroStillBlocks)
+{
+    Crc16 crc;
+    LoopbackTransport transport(&crc);
+    const Hash channel = 1U;
+
+    // 0 marks a channel which is not blocked, a send pending at clock 0 must not look like one.
+    s_clockUs = 0U;
+    transport.m_budget = 0U;
+    EXPECT_EQ(kErpcStatus_Pending, sendMessage(transport, channel, 16U));
+    s_clockUs = 50U;
+    EXPECT_EQ(kErpcStatus_Pending, sendMessage(transport, channel, 16U));
+    s_clockUs = 80U;
+    transport.m_budget = UINT32_MAX;
+    ASSERT_EQ(kErpcStatus_Success, sendMessage(transport, channel, 16U));
+
+    // Measured from clock 1, the closest time which is not the marker.
+    EXPECT_EQ(79U, readStats(transport, channel).sendBlockedUs);
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EMBEDDED_RPC__TEST_TRANSPORT_STATS_H_
+#define _EMBEDDED_RPC__TEST_TRANSPORT_STATS_H_
+
+#include <stdint.h>
+
+/*!
+ * @brief Clock of the transport statistics, set by the tests instead of running.
+ *
+ * The infra tests build with ERPC_TRANSPORT_STATS_CLOCK() reading it, see the Makefile.
+ *
+ * @return Time in microseconds.
+ */
+extern "C" uint32_t erpc_test_transport_clock(void);
+
+#endif // _EMBEDDED_RPC__TEST_TRANSPORT_STATS_H_
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _ERPC_SOAK_CONFIG_H_
+#define _ERPC_SOAK_CONFIG_H_
+
+/*!
+ * @addtogroup config
+ * @{
+ * @file
+ */
+
+// The soak takes the library configuration and only grows the pool of the static message
+// buffer factory, every client holds one buffer during its call.
+#include "../../../erpc_c/config/erpc_config.h"
+
+//! @def ERPC_DEFAULT_BUFFER_SIZE
+//!
+//! Size of buffers of the setup factories, large enough for big echo payloads.
+#define ERPC_DEFAULT_BUFFER_SIZE (4096U)
+
+//! @def ERPC_DEFAULT_BUFFERS_COUNT
+//!
+//! Buffers of the static factory, the clients take one each, the server and the router one more.
+#undef ERPC_DEFAULT_BUFFERS_COUNT
+#define ERPC_DEFAULT_BUFFERS_COUNT (128U)
+
+/*! @} */
+#endif // _ERPC_SOAK_CONFIG_H_
@@ -0,0 +1,1062 @@
+/*
+ * Copyright 2021 ACRIOS Systems s.r.o.
+ * All rights reserved.
+ *
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "erpc_basic_codec.h"
+#include "erpc_client_manager.h"
+#include "erpc_crc16.h"
+#include "erpc_inter_thread_buffer_transport.h"
+#include "erpc_mbf_setup.h"
+#include "erpc_simple_server.h"
+#include "erpc_tcp_transport.h"
+#include "erpc_threading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace erpc;
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Size of message buffers of the setup factories, set in the Makefile.
+static const uint32_t kBufferSize = ERPC_DEFAULT_BUFFER_SIZE;
+
+//! @brief Service and methods of the soak clients.
+static const uint32_t kSoakServiceId = 1U;
+static const Hash kStopMethodId = 1U;
+
+//! @brief Echo method of the first client, client i calls kEchoMethodId + i so that its reply finds it.
+static const Hash kEchoMethodId = 16U;
+
+//! @brief Wait of a server which found the buffer pool empty before it tries again.
+static const uint32_t kPoolRetryUs = 100U;
+
+//! @brief Factory calls and sends taking longer than this waited for another thread.
+static const uint64_t kContendedNs = 5000U;
+
+/*!
+ * @brief Measurements of one ramp step or one soak interval, printed as one JSON object.
+ */
+struct SoakSample
+{
+    std::string transport;  //!< Transport of the shared connection.
+    std::string mbf;        //!< Setup message buffer factory.
+    uint32_t clients;       //!< Count of client threads sending.
+    double seconds;         //!< Duration of the sample.
+    uint64_t calls;         //!< Calls completed.
+    uint64_t errors;        //!< Calls failed.
+    double callsPerSec;     //!< Throughput of all clients.
+    double p50Us;           //!< Median round trip.
+    double p99Us;           //!< 99th percentile round trip.
+    double maxUs;           //!< Longest round trip.
+    uint64_t poolExhausted; //!< Buffer requests the factory could not serve.
+    uint32_t poolHighWater; //!< Most buffers in use at once.
+    uint64_t mbfCalls;      //!< Calls of create() and dispose() of the factory.
+    uint64_t mbfContended;  //!< Factory calls which took longer than kContendedNs.
+    double mbfWaitUs;       //!< Time spent in the factory.
+    double mbfMaxUs;        //!< Longest factory call.
+    uint64_t sendCalls;     //!< Sends on the shared client transport.
+    uint64_t sendContended; //!< Sends which took longer than kContendedNs, one client gives the baseline.
+    double sendWaitUs;      //!< Time spent sending on the shared client transport.
+    double sendMaxUs;       //!< Longest send.
+    uint64_t rssKb;         //!< Resident set size at the end of the sample.
+};
+
+/*!
+ * @brief Return time of the steady clock in nanoseconds.
+ */
+static uint64_t nowNs(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/*!
+ * @brief Durations of calls into an object shared by the threads, counted without a lock.
+ */
+class CallTimer
+{
+public:
+    CallTimer(void)
+    : m_calls(0)
+    , m_contended(0)
+    , m_ns(0)
+    , m_maxNs(0)
+    {
+    }
+
+    //! @brief Count a call which started at @a start.
+    void record(uint64_t start)
+    {
+        uint64_t ns = nowNs() - start;
+        uint64_t max = m_maxNs.load(std::memory_order_relaxed);
+
+        m_calls.fetch_add(1U, std::memory_order_relaxed);
+        m_ns.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > kContendedNs)
+        {
+            m_contended.fetch_add(1U, std::memory_order_relaxed);
+        }
+        while ((ns > max) && !m_maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    //! @brief Move the counters to the caller and restart them.
+    void take(uint64_t &calls, uint64_t &contended, double &waitUs, double &maxUs)
+    {
+        calls = m_calls.exchange(0U, std::memory_order_relaxed);
+        contended = m_contended.exchange(0U, std::memory_order_relaxed);
+        waitUs = m_ns.exchange(0U, std::memory_order_relaxed) / 1e3;
+        maxUs = m_maxNs.exchange(0U, std::memory_order_relaxed) / 1e3;
+    }
+
+private:
+    std::atomic<uint64_t> m_calls;
+    std::atomic<uint64_t> m_contended;
+    std::atomic<uint64_t> m_ns;
+    std::atomic<uint64_t> m_maxNs;
+};
+
+/*!
+ * @brief Forwards to a factory of erpc_setup_mbf_*.cpp, timing each call and counting the buffers.
+ *
+ * The clients and the server share it, like the threads of one application share the factory
+ * of the setup functions. The static factory serializes create() and dispose() with a
+ * semaphore, a call taking longer than kContendedNs waited for another thread.
+ */
+class TimedBufferFactory : public MessageBufferFactory
+{
+public:
+    TimedBufferFactory(erpc_mbf_t factory)
+    : m_factory(reinterpret_cast<MessageBufferFactory *>(factory))
+    , m_inUse(0)
+    , m_highWater(0)
+    , m_exhausted(0)
+    {
+    }
+
+    virtual MessageBuffer create(void) override
+    {
+        uint64_t start = nowNs();
+        MessageBuffer buf = m_factory->create();
+
+        m_timer.record(start);
+        if (buf.get() == NULL)
+        {
+            m_exhausted.fetch_add(1U, std::memory_order_relaxed);
+        }
+        else
+        {
+            uint32_t inUse = m_inUse.fetch_add(1U, std::memory_order_relaxed) + 1U;
+            uint32_t highWater = m_highWater.load(std::memory_order_relaxed);
+            while ((inUse > highWater) &&
+                   !m_highWater.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        return buf;
+    }
+
+    virtual void dispose(MessageBuffer *buf) override
+    {
+        if (buf->get() != NULL)
+        {
+            uint64_t start = nowNs();
+            m_factory->dispose(buf);
+            m_timer.record(start);
+            m_inUse.fetch_sub(1U, std::memory_order_relaxed);
+        }
+    }
+
+    virtual bool createServerBuffer(void) override { return m_factory->createServerBuffer(); }
+
+    virtual erpc_status_t prepareServerBufferForSend(MessageBuffer *message) override
+    {
+        return m_factory->prepareServerBufferForSend(message);
+    }
+
+    /*!
+     * @brief Move the counters into @a sample and restart them, the high water mark restarts at the current use.
+     */
+    void takeCounters(SoakSample &sample)
+    {
+        sample.poolExhausted = m_exhausted.exchange(0U, std::memory_order_relaxed);
+        sample.poolHighWater = m_highWater.exchange(m_inUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        m_timer.take(sample.mbfCalls, sample.mbfContended, sample.mbfWaitUs, sample.mbfMaxUs);
+    }
+
+private:
+    MessageBufferFactory *m_factory;
+    CallTimer m_timer;
+    std::atomic<uint32_t> m_inUse;
+    std::atomic<uint32_t> m_highWater;
+    std::atomic<uint64_t> m_exhausted;
+};
+
+class SharedLink;
+
+/*!
+ * @brief Transport of one client over the shared link.
+ *
+ * Sends go straight to the shared client transport, replies are handed over by the router
+ * of the link.
+ */
+class ClientPort : public Transport
+{
+public:
+    ClientPort(SharedLink *link)
+    : m_link(link)
+    , m_replied(0)
+    , m_reply(kBufferSize)
+    , m_replyLength(0)
+    , m_replyStatus(kErpcStatus_Success)
+    {
+    }
+
+    virtual erpc_status_t send(const Hash &channel, MessageBuffer *message) override;
+
+    virtual erpc_status_t receive(const Hash &channel, MessageBuffer *message) override
+    {
+        (void)channel;
+        m_replied.get();
+
+        if (m_replyStatus != kErpcStatus_Success)
+        {
+            // The link is down, every later receive fails too.
+            m_replied.put();
+            return m_replyStatus;
+        }
+        if (m_replyLength > message->getLength())
+        {
+            return kErpcStatus_ReceiveFailed;
+        }
+        memcpy(message->get(), m_reply.data(), m_replyLength);
+        message->setUsed(static_cast<uint16_t>(m_replyLength));
+        return kErpcStatus_Success;
+    }
+
+    virtual void codecCreationCallback(Codec *codec) override;
+
+    virtual void flush(void) override {}
+
+    //! @brief Hand a reply to the waiting client, called by the router.
+    void deliver(const uint8_t *data, uint32_t length)
+    {
+        memcpy(m_reply.data(), data, length);
+        m_replyLength = length;
+        m_replied.put();
+    }
+
+    //! @brief Fail the waiting and all later receives, called by the router.
+    void fail(erpc_status_t err)
+    {
+        m_replyStatus = err;
+        m_replied.put();
+    }
+
+private:
+    SharedLink *m_link;
+    Semaphore m_replied;
+    std::vector<uint8_t> m_reply;
+    uint32_t m_replyLength;
+    erpc_status_t m_replyStatus;
+};
+
+/*!
+ * @brief One client and one server transport shared by all clients.
+ *
+ * Clients send on the shared client transport at the same time, so they contend for its send
+ * lock. A send also blocks on the transport itself, the inter-thread one waits for the peer to
+ * copy the message, so the wait of one client is the baseline of the others.
+ *
+ * The router thread receives the replies and hands each one to the port of its client, found
+ * by the method id.
+ */
+class SharedLink
+{
+public:
+    SharedLink(Transport *clientTransport, Transport *serverTransport, uint32_t clients)
+    : m_clientTransport(clientTransport)
+    , m_serverTransport(serverTransport)
+    , m_routerThread(routerThreadStub, 0, 0, "soak_router")
+    , m_routerDone(0)
+    {
+        for (uint32_t i = 0; i < clients; ++i)
+        {
+            m_ports.push_back(new ClientPort(this));
+        }
+    }
+
+    ~SharedLink(void)
+    {
+        for (ClientPort *port : m_ports)
+        {
+            delete port;
+        }
+        delete m_clientTransport;
+        delete m_serverTransport;
+    }
+
+    Transport *getClientTransport(void) { return m_clientTransport; }
+
+    Transport *getServerTransport(void) { return m_serverTransport; }
+
+    ClientPort *getPort(uint32_t index) { return m_ports[index]; }
+
+    void start(void) { m_routerThread.start(this); }
+
+    //! @brief Wait until the router received the reply of the stop call.
+    void join(void) { m_routerDone.get(); }
+
+    erpc_status_t send(const Hash &channel, MessageBuffer *message)
+    {
+        uint64_t start = nowNs();
+        erpc_status_t err;
+
+        do
+        {
+            err = m_clientTransport->send(channel, message);
+        } while (err == kErpcStatus_Pending);
+        m_sendTimer.record(start);
+
+        return err;
+    }
+
+    void takeCounters(SoakSample &sample)
+    {
+        m_sendTimer.take(sample.sendCalls, sample.sendContended, sample.sendWaitUs, sample.sendMaxUs);
+    }
+
+private:
+    static void routerThreadStub(void *arg)
+    {
+        SharedLink *This = reinterpret_cast<SharedLink *>(arg);
+        std::vector<uint8_t> data(kBufferSize);
+        BasicCodec codec;
+
+        for (;;)
+        {
+            MessageBuffer reply(data.data(), kBufferSize);
+            erpc_status_t err = This->m_clientTransport->receive(0, &reply);
+            message_type_t type;
+            uint32_t service;
+            Hash methodId = 0;
+            uint32_t sequence;
+
+            if (err == kErpcStatus_Pending)
+            {
+                continue;
+            }
+            if (err == kErpcStatus_Success)
+            {
+                codec.setBuffer(reply);
+                codec.startReadMessage(&type, &service, &methodId, &sequence);
+                err = codec.getStatus();
+            }
+            if (err != kErpcStatus_Success)
+            {
+                // The stream lost its framing, no reply can be matched any more.
+                fprintf(stderr, "router stopped with error %d\n", err);
+                for (ClientPort *port : This->m_ports)
+                {
+                    port->fail(err);
+                }
+                break;
+            }
+
+            if (methodId == kStopMethodId)
+            {
+                This->m_ports[0]->deliver(reply.get(), reply.getUsed());
+                break;
+            }
+            if ((methodId >= kEchoMethodId) && ((methodId - kEchoMethodId) < This->m_ports.size()))
+            {
+                This->m_ports[methodId - kEchoMethodId]->deliver(reply.get(), reply.getUsed());
+            }
+        }
+        This->m_routerDone.put();
+    }
+
+    Transport *m_clientTransport;
+    Transport *m_serverTransport;
+    std::vector<ClientPort *> m_ports;
+    CallTimer m_sendTimer;
+    Thread m_routerThread;
+    Semaphore m_routerDone;
+};
+
+erpc_status_t ClientPort::send(const Hash &channel, MessageBuffer *message)
+{
+    return m_link->send(channel, message);
+}
+
+void ClientPort::codecCreationCallback(Codec *codec)
+{
+    // Codecs precompute the check of the shared transport, as they would on it directly.
+    m_link->getClientTransport()->codecCreationCallback(codec);
+}
+
+/*!
+ * @brief Service of the soak clients.
+ *
+ * Echo methods return the received binary, stop stops the server after its reply was sent.
+ */
+class SoakService : public Service
+{
+public:
+    SoakService(Server *server)
+    : Service(kSoakServiceId)
+    , m_server(server)
+    {
+    }
+
+    virtual erpc_status_t handleInvocation(Hash methodId, uint32_t sequence, Codec *codec,
+                                           MessageBufferFactory *messageFactory) override
+    {
+        uint8_t payload[kBufferSize];
+        uint32_t length = 0;
+        uint8_t *data = NULL;
+        erpc_status_t err;
+
+        if (methodId >= kEchoMethodId)
+        {
+            codec->readBinary(&length, &data);
+            if (codec->isStatusOk())
+            {
+                // The reply is written over the request, keep the payload.
+                memcpy(payload, data, length);
+            }
+        }
+        else if (methodId == kStopMethodId)
+        {
+            m_server->stop();
+        }
+        else
+        {
+            return kErpcStatus_InvalidArgument;
+        }
+
+        err = codec->getStatus();
+        if (err == kErpcStatus_Success)
+        {
+            err = messageFactory->prepareServerBufferForSend(codec->getBuffer());
+        }
+        if (err == kErpcStatus_Success)
+        {
+            codec->reset();
+            codec->startWriteMessage(kReplyMessage, kSoakServiceId, methodId, sequence);
+            if (methodId >= kEchoMethodId)
+            {
+                codec->writeBinary(length, payload);
+            }
+            err = codec->getStatus();
+        }
+
+        return err;
+    }
+
+private:
+    Server *m_server;
+};
+
+/*!
+ * @brief The server serving all clients of a shared link, on a thread of its own.
+ */
+class SoakServer
+{
+public:
+    SoakServer(Transport *transport, MessageBufferFactory *factory)
+    : m_service(&m_server)
+    , m_thread(threadStub, 0, 0, "soak_server")
+    , m_done(0)
+    {
+        m_server.setMessageBufferFactory(factory);
+        m_server.setCodecFactory(&m_codecFactory);
+        m_server.setTransport(transport);
+        m_server.addService(&m_service);
+    }
+
+    void start(void) { m_thread.start(this); }
+
+    //! @brief Wait until the server stopped after the stop call.
+    void join(void) { m_done.get(); }
+
+private:
+    static void threadStub(void *arg)
+    {
+        SoakServer *This = reinterpret_cast<SoakServer *>(arg);
+        erpc_status_t err;
+
+        // An empty pool fails the receive, the request is still waiting in the transport.
+        while ((err = This->m_server.run()) == kErpcStatus_MemoryError)
+        {
+            Thread::sleep(kPoolRetryUs);
+        }
+        if (err != kErpcStatus_Success)
+        {
+            fprintf(stderr, "server stopped with error %d\n", err);
+        }
+        This->m_done.put();
+    }
+
+    BasicCodecFactory m_codecFactory;
+    SimpleServer m_server;
+    SoakService m_service;
+    Thread m_thread;
+    Semaphore m_done;
+};
+
+/*!
+ * @brief One client thread, calling echo over its port until it is stopped.
+ *
+ * Each client has a client manager of its own, all of them take their buffers from the shared
+ * factory and send on the shared link.
+ */
+class SoakClient
+{
+public:
+    SoakClient(ClientPort *port, MessageBufferFactory *factory, uint32_t index, uint32_t payloadSize)
+    : m_echoMethodId(kEchoMethodId + index)
+    , m_thread(threadStub, 0, 0, "soak_client")
+    , m_done(0)
+    , m_payload(payloadSize, 0x3C)
+    , m_running(true)
+    , m_errors(0)
+    {
+        m_client.setMessageBufferFactory(factory);
+        m_client.setCodecFactory(&m_codecFactory);
+        m_client.setTransport(port);
+    }
+
+    void start(void) { m_thread.start(this); }
+
+    //! @brief Stop calling and wait until the thread returned.
+    void stop(void)
+    {
+        m_running = false;
+        m_done.get();
+    }
+
+    /*!
+     * @brief Perform one call, echo replies are checked against the payload.
+     *
+     * @return True when the call succeeded.
+     */
+    bool call(Hash methodId)
+    {
+        RequestContext request = m_client.createRequest(methodId, false, methodId);
+        Codec *codec = request.getCodec();
+        bool ok = (codec != NULL);
+
+        if (ok)
+        {
+            codec->startWriteMessage(kInvocationMessage, kSoakServiceId, methodId, request.getSequence());
+            if (methodId != kStopMethodId)
+            {
+                codec->writeBinary(m_payload.size(), m_payload.data());
+            }
+            request.setState(RequestContextState::SENDING);
+
+            // Stubs are called again while the request is pending, so is the client manager.
+            for (;;)
+            {
+                bool success = m_client.performRequest(request);
+                erpc_status_t err = codec->getStatus();
+                if ((success && (request.getState() == RequestContextState::DONE)) ||
+                    ((err != kErpcStatus_Success) && (err != kErpcStatus_Pending)))
+                {
+                    break;
+                }
+            }
+
+            if (methodId != kStopMethodId)
+            {
+                uint32_t replyLength = 0;
+                uint8_t *reply = NULL;
+                codec->readBinary(&replyLength, &reply);
+                ok = codec->isStatusOk() && (replyLength == m_payload.size()) &&
+                     (memcmp(reply, m_payload.data(), replyLength) == 0);
+            }
+            else
+            {
+                ok = codec->isStatusOk();
+            }
+            m_client.releaseRequest(request);
+        }
+
+        return ok;
+    }
+
+    /*!
+     * @brief Move the round trips and errors recorded since the last call to the caller.
+     */
+    void takeSamples(std::vector<uint32_t> &latencies, uint64_t &errors)
+    {
+        Mutex::Guard lock(m_samplesLock);
+        latencies.insert(latencies.end(), m_latencies.begin(), m_latencies.end());
+        m_latencies.clear();
+        errors += m_errors;
+        m_errors = 0;
+    }
+
+private:
+    static void threadStub(void *arg)
+    {
+        SoakClient *This = reinterpret_cast<SoakClient *>(arg);
+
+        while (This->m_running)
+        {
+            uint64_t start = nowNs();
+            bool ok = This->call(This->m_echoMethodId);
+            uint64_t ns = nowNs() - start;
+
+            Mutex::Guard lock(This->m_samplesLock);
+            if (ok)
+            {
+                This->m_latencies.push_back(static_cast<uint32_t>(std::min<uint64_t>(ns, UINT32_MAX)));
+            }
+            else
+            {
+                ++This->m_errors;
+            }
+        }
+        This->m_done.put();
+    }
+
+    Hash m_echoMethodId;
+    BasicCodecFactory m_codecFactory;
+    ClientManager m_client;
+    Thread m_thread;
+    Semaphore m_done;
+    std::vector<uint8_t> m_payload;
+    std::atomic<bool> m_running;
+    Mutex m_samplesLock;
+    std::vector<uint32_t> m_latencies;
+    uint64_t m_errors;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<SoakSample> s_ramp;
+static std::vector<SoakSample> s_soak;
+static uint32_t s_maxClients = 8;
+static double s_stepMs = 2000;
+static double s_soakSec = 0;
+static double s_intervalMs = 1000;
+static uint32_t s_payloadSize = 64;
+static const char *s_transport = "all";
+static const char *s_mbf = "all";
+static uint16_t s_tcpPort = 12400;
+static Crc16 s_crc16;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @brief Return resident set size of the process in KB, 0 where it is not known.
+ */
+static uint64_t residentKb(void)
+{
+    uint64_t rss = 0;
+#if defined(__linux__)
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm != NULL)
+    {
+        unsigned long size;
+        unsigned long resident;
+        if (fscanf(statm, "%lu %lu", &size, &resident) == 2)
+        {
+            rss = static_cast<uint64_t>(resident) * sysconf(_SC_PAGESIZE) / 1024U;
+        }
+        fclose(statm);
+    }
+#endif
+    return rss;
+}
+
+/*!
+ * @brief Return the setup factory of the given name, constructed on first use.
+ */
+static erpc_mbf_t setupFactory(const std::string &mbf)
+{
+    static erpc_mbf_t s_static = NULL;
+    static erpc_mbf_t s_dynamic = NULL;
+
+    if (mbf == "static")
+    {
+        if (s_static == NULL)
+        {
+            s_static = erpc_mbf_static_init();
+        }
+        return s_static;
+    }
+
+    if (s_dynamic == NULL)
+    {
+        s_dynamic = erpc_mbf_dynamic_init();
+    }
+    return s_dynamic;
+}
+
+/*!
+ * @brief Create a connected client and server transport pair.
+ *
+ * @return True when the pair is connected.
+ */
+static bool createTransports(const std::string &transport, Transport *&client, Transport *&server)
+{
+    if (transport == "inter_thread")
+    {
+        InterThreadBufferTransport *clientTransport = new InterThreadBufferTransport();
+        InterThreadBufferTransport *serverTransport = new InterThreadBufferTransport();
+        clientTransport->linkWithPeer(serverTransport);
+        client = clientTransport;
+        server = serverTransport;
+        return true;
+    }
+
+    // A TCP server keeps listening after close(), so every run gets a port of its own.
+    uint16_t port = s_tcpPort++;
+    TCPTransport *serverTransport = new TCPTransport("localhost", port, true);
+    TCPTransport *clientTransport = new TCPTransport("localhost", port, false);
+    erpc_status_t err;
+
+    clientTransport->setIntegrityCheck(&s_crc16);
+    serverTransport->setIntegrityCheck(&s_crc16);
+    (void)serverTransport->open();
+    // The server thread starts listening asynchronously.
+    for (uint32_t retry = 0;; ++retry)
+    {
+        err = clientTransport->open();
+        if ((err == kErpcStatus_Success) || (retry == 100U))
+        {
+            break;
+        }
+        Thread::sleep(10000);
+    }
+    if (err != kErpcStatus_Success)
+    {
+        fprintf(stderr, "tcp: cannot connect to port %u\n", port);
+        delete clientTransport;
+        delete serverTransport;
+        return false;
+    }
+
+    client = clientTransport;
+    server = serverTransport;
+    return true;
+}
+
+/*!
+ * @brief Collect the samples of all clients since the last call.
+ */
+static SoakSample takeSample(const std::string &transport, const std::string &mbf, std::vector<SoakClient *> &clients,
+                             TimedBufferFactory &factory, SharedLink &link, double seconds)
+{
+    SoakSample sample;
+    std::vector<uint32_t> latencies;
+
+    sample.transport = transport;
+    sample.mbf = mbf;
+    sample.clients = clients.size();
+    sample.seconds = seconds;
+    sample.errors = 0;
+    for (SoakClient *client : clients)
+    {
+        client->takeSamples(latencies, sample.errors);
+    }
+    factory.takeCounters(sample);
+    link.takeCounters(sample);
+    sample.rssKb = residentKb();
+
+    std::sort(latencies.begin(), latencies.end());
+    sample.calls = latencies.size();
+    sample.callsPerSec = (seconds > 0) ? (sample.calls / seconds) : 0;
+    sample.p50Us = latencies.empty() ? 0 : latencies[(latencies.size() - 1U) / 2U] / 1e3;
+    sample.p99Us = latencies.empty() ? 0 : latencies[(latencies.size() - 1U) * 99U / 100U] / 1e3;
+    sample.maxUs = latencies.empty() ? 0 : latencies.back() / 1e3;
+
+    fprintf(stderr,
+            "%-12s %-7s %3u clients %10.0f calls/s p50 %8.1f us p99 %8.1f us errors %llu pool exhausted %llu "
+            "high water %u mbf contended %llu/%llu send contended %llu/%llu rss %llu KB\n",
+            transport.c_str(), mbf.c_str(), sample.clients, sample.callsPerSec, sample.p50Us, sample.p99Us,
+            static_cast<unsigned long long>(sample.errors), static_cast<unsigned long long>(sample.poolExhausted),
+            sample.poolHighWater, static_cast<unsigned long long>(sample.mbfContended),
+            static_cast<unsigned long long>(sample.mbfCalls), static_cast<unsigned long long>(sample.sendContended),
+            static_cast<unsigned long long>(sample.sendCalls), static_cast<unsigned long long>(sample.rssKb));
+
+    return sample;
+}
+
+/*!
+ * @brief Start a server and @a count clients on one link, sample them every @a intervalMs for @a durationMs and
+ * stop them.
+ *
+ * @return False when the link could not be created.
+ */
+static bool runLoad(const std::string &transport, const std::string &mbf, uint32_t count, double durationMs,
+                    double intervalMs, std::vector<SoakSample> &samples)
+{
+    Transport *clientTransport;
+    Transport *serverTransport;
+
+    if (!createTransports(transport, clientTransport, serverTransport))
+    {
+        return false;
+    }
+
+    TimedBufferFactory factory(setupFactory(mbf));
+    SharedLink link(clientTransport, serverTransport, count);
+    SoakServer server(serverTransport, &factory);
+    std::vector<SoakClient *> clients;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        clients.push_back(new SoakClient(link.getPort(i), &factory, i, s_payloadSize));
+    }
+
+    server.start();
+    link.start();
+    for (SoakClient *client : clients)
+    {
+        client->start();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    for (double elapsedMs = 0; elapsedMs < durationMs;)
+    {
+        Thread::sleep(static_cast<uint32_t>(std::min(intervalMs, durationMs - elapsedMs) * 1e3));
+        auto now = std::chrono::steady_clock::now();
+        samples.push_back(takeSample(transport, mbf, clients, factory, link,
+                                     std::chrono::duration<double>(now - last).count()));
+        last = now;
+        elapsedMs = std::chrono::duration<double, std::milli>(now - start).count();
+    }
+
+    for (SoakClient *client : clients)
+    {
+        client->stop();
+    }
+    // The first client stops the server, the router ends with the reply.
+    (void)clients[0]->call(kStopMethodId);
+    server.join();
+    link.join();
+
+    for (SoakClient *client : clients)
+    {
+        delete client;
+    }
+
+    return true;
+}
+
+static void printSamples(FILE *out, const char *name, const std::vector<SoakSample> &samples, bool last)
+{
+    fprintf(out, "  \"%s\": [\n", name);
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        const SoakSample &s = samples[i];
+        fprintf(out,
+                "    {\"transport\": \"%s\", \"mbf\": \"%s\", \"clients\": %u, \"seconds\": %.3f, \"calls\": %llu, "
+                "\"errors\": %llu, \"calls_per_sec\": %.1f, \"p50_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f, "
+                "\"pool_exhausted\": %llu, \"pool_high_water\": %u, \"mbf_calls\": %llu, \"mbf_contended\": %llu, "
+                "\"mbf_wait_us\": %.1f, \"mbf_max_us\": %.1f, \"send_calls\": %llu, \"send_contended\": %llu, "
+                "\"send_wait_us\": %.1f, \"send_max_us\": %.1f, \"rss_kb\": %llu}%s\n",
+                s.transport.c_str(), s.mbf.c_str(), s.clients, s.seconds, static_cast<unsigned long long>(s.calls),
+                static_cast<unsigned long long>(s.errors), s.callsPerSec, s.p50Us, s.p99Us, s.maxUs,
+                static_cast<unsigned long long>(s.poolExhausted), s.poolHighWater,
+                static_cast<unsigned long long>(s.mbfCalls), static_cast<unsigned long long>(s.mbfContended),
+                s.mbfWaitUs, s.mbfMaxUs, static_cast<unsigned long long>(s.sendCalls),
+                static_cast<unsigned long long>(s.sendContended), s.sendWaitUs, s.sendMaxUs,
+                static_cast<unsigned long long>(s.rssKb), (i + 1U < samples.size()) ? "," : "");
+    }
+    fprintf(out, "  ]%s\n", last ? "" : ",");
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-o results.json] [-x transport] [-m mbf] [-c max_clients] [-d step_ms] [-s soak_s]\n"
+            "          [-i interval_ms] [-z payload] [-p tcp_port]\n"
+            "  -o  write JSON results to the file instead of stdout\n"
+            "  -x  inter_thread, tcp or all, default all\n"
+            "  -m  message buffer factory of the setup functions, static, dynamic or all, default all\n"
+            "  -c  ramp 1, 2, 4, ... up to this count of clients, default 8, at most %u\n"
+            "  -d  duration of each ramp step, default 2000 ms\n"
+            "  -s  then run the maximum count of clients for this time, default 0 s (no soak)\n"
+            "  -i  sampling interval of the soak run, default 1000 ms\n"
+            "  -z  echo payload size, default 64 bytes\n"
+            "  -p  first port of the TCP connections, default 12400\n",
+            name, static_cast<unsigned>(ERPC_DEFAULT_BUFFERS_COUNT - 2U));
+}
+
+int main(int argc, char *argv[])
+{
+    const char *outputPath = NULL;
+    FILE *out = stdout;
+    std::vector<std::string> transports;
+    std::vector<std::string> factories;
+    uint64_t errors = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            outputPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-x") == 0) && (i + 1 < argc))
+        {
+            s_transport = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+        {
+            s_mbf = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc))
+        {
+            s_maxClients = static_cast<uint32_t>(atoi(argv[++i]));
+        }
+        else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc))
+        {
+            s_stepMs = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc))
+        {
+            s_soakSec = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-i") == 0) && (i + 1 < argc))
+        {
+            s_intervalMs = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-z") == 0) && (i + 1 < argc))
+        {
+            s_payloadSize = static_cast<uint32_t>(atoi(argv[++i]));
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            s_tcpPort = static_cast<uint16_t>(atoi(argv[++i]));
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((strcmp(s_transport, "all") == 0) || (strcmp(s_transport, "inter_thread") == 0))
+    {
+        transports.push_back("inter_thread");
+    }
+    if ((strcmp(s_transport, "all") == 0) || (strcmp(s_transport, "tcp") == 0))
+    {
+        transports.push_back("tcp");
+    }
+    if ((strcmp(s_mbf, "all") == 0) || (strcmp(s_mbf, "static") == 0))
+    {
+        factories.push_back("static");
+    }
+    if ((strcmp(s_mbf, "all") == 0) || (strcmp(s_mbf, "dynamic") == 0))
+    {
+        factories.push_back("dynamic");
+    }
+    // Each client holds one buffer of the static factory, the server and the router one more each.
+    // The payload and the binary length must fit into one buffer with the message header.
+    if (transports.empty() || factories.empty() || (s_maxClients == 0U) ||
+        (s_maxClients > ERPC_DEFAULT_BUFFERS_COUNT - 2U) || (s_stepMs <= 0) || (s_intervalMs <= 0) ||
+        (s_payloadSize > kBufferSize - 64U))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (const std::string &transport : transports)
+    {
+        for (const std::string &mbf : factories)
+        {
+            for (uint32_t clients = 1;; clients = std::min(clients * 2U, s_maxClients))
+            {
+                if (!runLoad(transport, mbf, clients, s_stepMs, s_stepMs, s_ramp))
+                {
+                    return 1;
+                }
+                if (clients == s_maxClients)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (s_soakSec > 0)
+    {
+        for (const std::string &transport : transports)
+        {
+            for (const std::string &mbf : factories)
+            {
+                size_t first = s_soak.size();
+                if (!runLoad(transport, mbf, s_maxClients, s_soakSec * 1e3, s_intervalMs, s_soak))
+                {
+                    return 1;
+                }
+                // The first interval includes start up allocations, growth after it points at a leak.
+                if (s_soak.size() - first >= 2U)
+                {
+                    fprintf(stderr, "%s %s soak: rss grew by %lld KB after the first interval\n", transport.c_str(),
+                            mbf.c_str(),
+                            static_cast<long long>(s_soak.back().rssKb) - static_cast<long long>(s_soak[first].rssKb));
+                }
+            }
+        }
+    }
+
+    if (outputPath != NULL)
+    {
+        out = fopen(outputPath, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", outputPath);
+            return 1;
+        }
+    }
+    fprintf(out, "{\n");
+    printSamples(out, "ramp", s_ramp, false);
+    printSamples(out, "soak", s_soak, true);
+    fprintf(out, "}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    for (const SoakSample &sample : s_ramp)
+    {
+        errors += sample.errors;
+    }
+    for (const SoakSample &sample : s_soak)
+    {
+        errors += sample.errors;
+    }
+
+    return (errors == 0U) ? 0 : 2;
+}